@@ -83,6 +83,8 @@ class KernelDef {
 
   bool HasExternalOutputs() const { return external_outputs_; }
 
+  bool IsNonDeterministic() const { return non_deterministic_; }
+
 #ifdef ENABLE_STRIDED_TENSORS
   const std::vector<int>& MayStridedInput() const { return may_strided_inputs_; }
   const std::vector<std::pair<int, int>>& MayStridedOutput() const { return may_strided_output_map_; }
@@ -141,6 +143,9 @@ class KernelDef {
   // Whether the outputs are from external.
   bool external_outputs_ = false;
 
+  // Whether the outputs depend on state kept across runs, e.g. a random number generator.
+  bool non_deterministic_ = false;
+
 #ifdef ENABLE_STRIDED_TENSORS
   // An element i means i-th input can be strided tensor.
   std::vector<int> may_strided_inputs_;
@@ -269,6 +274,16 @@ class KernelDefBuilder {
     return *this;
   }
 
+  /**
+     Specify that the outputs of this kernel depend on state kept across runs, such as a random number
+     generator, so running it concurrently changes which values each run produces.
+     Control flow kernels run subgraph iterations containing such a kernel in order.
+  */
+  KernelDefBuilder& NonDeterministic() {
+    kernel_def_->non_deterministic_ = true;
+    return *this;
+  }
+
 #ifdef ENABLE_STRIDED_TENSORS
   /**
      Specify that the input_index-th input can be strided tensor.
@@ -397,7 +397,13 @@ class Node {
   bool ClearAttribute(const std::string& attr_name);
 
   /** Gets the Node's mutable attributes. */
-  NodeAttributes& GetMutableAttributes() noexcept { return attributes_; }
+  NodeAttributes& GetMutableAttributes() noexcept {
+#if !defined(ORT_MINIMAL_BUILD)
+    // the caller may change the attributes, so type and shape inference must run again
+    inference_signature_.clear();
+#endif
+    return attributes_;
+  }
 
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -642,6 +648,14 @@ class Node {
   // Node::ToProto when running onnx::check_node in the first Graph::Resolve. At that point we know all the nodes are
   // unchanged from the original model.
   const ONNX_NAMESPACE::NodeProto* original_node_proto_ = nullptr;
+
+  // The schema, inputs and outputs seen by the last type and shape inference of this node, see
+  // Graph::ComputeInferenceSignature. Empty if unknown, e.g. for a new node or after an attribute change.
+  // Used by incremental Graph::Resolve.
+  std::string inference_signature_;
+
+  // Indices of the inputs whose constant initializer data was read by the last type and shape inference.
+  InlinedVector<int> inference_data_inputs_;
 #endif
 
   // Execution priority, lower value for higher priority
@@ -1371,6 +1385,26 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
     return Resolve(default_options);
   }
 
+  /**
+  Sets whether Resolve re-runs type and shape inference only where the Graph has changed.
+  When enabled, Resolve skips a Node whose attributes, operator schema, inputs and outputs are unchanged since it was
+  last inferred, including the types and shapes of those values and the constant initializers it reads. A change to
+  a Node's outputs changes the inputs of its consumers, so inference still flows downstream of every modified Node,
+  edge and initializer. Nodes containing subgraphs are always inferred.
+  @param enable Enable incremental resolve.
+  @param verify Follow each incremental pass with a full type and shape inference, and fail Resolve if any output
+                type or shape differs. Intended for debugging.
+  @remarks Only the setting of the main graph is used.
+  */
+  void SetIncrementalResolve(bool enable, bool verify = false) noexcept {
+    incremental_resolve_ = enable;
+    verify_incremental_resolve_ = verify;
+  }
+
+  /** Gets the number of Nodes of this Graph whose type and shape inference was skipped by the last Resolve.
+  The other Nodes were inferred. Always 0 if incremental resolve is not enabled. */
+  size_t GetNumNodesSkippedByLastResolve() const noexcept { return num_nodes_skipped_by_last_resolve_; }
+
   const std::unordered_set<std::string>& GetOuterScopeNodeArgNames() const noexcept {
     return outer_scope_node_arg_names_;
   }
@@ -1638,6 +1672,16 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
 
   common::Status VerifyNodeAndOpMatch(const ResolveOptions& options);
 
+  // Write the state type and shape inference of <node> depends on, other than its attributes, to <signature>.
+  // Two signatures are equal only if that state is the same.
+  void ComputeInferenceSignature(const Node& node, std::string& signature) const;
+
+  // Hash of the data of the constant initializer <name>. Computed once per initializer.
+  size_t GetInitializerDataHash(const std::string& name, const ONNX_NAMESPACE::TensorProto& initializer) const;
+
+  // Re-run type and shape inference on all nodes after an incremental pass and fail if any output changes.
+  common::Status VerifyIncrementalInference(const ResolveOptions& options);
+
   // Set graph inputs/outputs when resolving a graph..
   common::Status SetGraphInputsOutputs();
 
@@ -1853,6 +1897,17 @@ class Graph {  // NOLINT(clang-analyzer-optin.performance.Padding): preserve exi
   // number of times Resolve has run.
   int num_resolves_ = 0;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // see SetIncrementalResolve
+  bool incremental_resolve_ = false;
+  bool verify_incremental_resolve_ = false;
+  size_t num_nodes_skipped_by_last_resolve_ = 0;
+
+  // hash of the data of each initializer, computed when the initializer is added or first read by incremental
+  // resolve and dropped when it is removed or replaced.
+  mutable InlinedHashMap<std::string, size_t> initializer_data_hashes_;
+#endif
+
   const logging::Logger& logger_;
 
   // If true, all inconsistencies encountered during shape and type inference
@@ -192,8 +192,10 @@ class ThreadPool {
   // Parallel sections are only implemented with the Eigen threadpool.
   // They have no effect when using OpenMP.
   //
-  // Parallel sections may not be nested, and may not be used inside
-  // parallel loops.
+  // Parallel sections may be nested, and may be used inside parallel
+  // loops.  Such a section has no effect: its loops use the enclosing
+  // section, or run in the calling thread when inside a parallel loop
+  // of the same pool.
 
   class ParallelSection {
    public:
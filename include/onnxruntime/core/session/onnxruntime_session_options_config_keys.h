@@ -47,6 +47,16 @@ static const char* const kOrtSessionOptionsConfigSetDenormalAsZero = "session.se
 // Its default value is "0" unless the DirectML execution provider is registered, in which case it defaults to "1".
 static const char* const kOrtSessionOptionsDisableQuantQDQ = "session.disable_quant_qdq";
 
+// Controls how graph outputs produced by an ai.onnx.ml ZipMap node are returned.
+// ZipMap builds one map from class label to probability per row, which is often slower to create and convert on the
+// client than the classifier itself.
+// "0": the outputs are a sequence of maps as defined by the model. [DEFAULT]
+// "1": the ZipMap node is removed when the session is initialized. The output keeps its name and holds the float
+//      tensor [N, C] given to ZipMap. A graph output named "<output name>_labels" is added after it and holds the C
+//      class labels (int64 or string), so column j of the probabilities belongs to label j. Session initialization
+//      fails if the model already uses that name.
+static const char* const kOrtSessionOptionsZipMapOutputAsTensor = "session.zipmap_output_as_tensor";
+
 // It controls whether to enable Double QDQ remover and Identical Children Consolidation
 // "0": not to disable. ORT does remove the middle 2 Nodes from a Q->(QD->Q)->QD pairs
 // "1": disable. ORT doesn't remove the middle 2 Nodes from a Q->(QD->Q)->QD pairs
@@ -67,6 +77,11 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable the fusion of connected float element-wise nodes into com.microsoft.FusedElementwise in the
+// Level 3 graph optimizations for the CPU execution provider. "0": disable; "1": enable. The default is "0".
+// The fused node hides the original nodes from other Level 3 optimizers and tools that look for them.
+static const char* const kOrtSessionOptionsEnableElementwiseFusion = "optimization.enable_elementwise_fusion";
+
 // This setting controls whether to enable AheadOfTime function inlining.
 // AOT function inlining examines the graph and attempts to inline as many locally defined functions in the model
 // as possible with the help of enabled execution providers.
@@ -107,6 +122,15 @@ static const char* const kOrtSessionOptionsMemoryOptimizerProbeConfig = "optimiz
 // Default is an empty string which means no optimizers are disabled.
 static const char* const kOrtSessionOptionsDisableSpecifiedOptimizers = "optimization.disable_specified_optimizers";
 
+// Controls how Graph::Resolve re-runs type and shape inference while the graph is being optimized.
+// "0": infer every node on each Resolve. The default.
+// "1": only infer nodes that were added or changed since the previous Resolve, and nodes downstream of them whose
+//      input types or shapes changed as a result. Reduces the graph optimization time of large models.
+// "2": as "1", but follow each incremental inference with a full one and fail session initialization if they differ.
+//      Intended for debugging.
+// This option is not enabled in ORT_MINIMAL_BUILD build.
+static const char* const kOrtSessionOptionsIncrementalGraphResolve = "optimization.incremental_graph_resolve";
+
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
 // Using device allocators means the memory allocation is made using malloc/new.
 static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "session.use_device_allocator_for_initializers";
@@ -117,6 +141,63 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure whether session initialization uses the intra-op thread pool.
+// "0": default, initialization runs on the calling thread.
+// "1": initializers stored in the model are unpacked in parallel and the kernels of a graph run PrePack in parallel.
+//      Graph transformation, partitioning and planning still run on the calling thread. The time taken by each
+//      initialization stage is logged at INFO level and recorded as a session event when profiling is enabled.
+static const char* const kOrtSessionOptionsConfigParallelInitialization = "session.parallel_initialization";
+
+// Configure how initializers are materialized when the session is initialized.
+// "0": default. Initializers are planned like any other tensor and may share the arena with it.
+// "1": lazy mode, which keeps the peak memory during loading close to the final footprint.
+//      Initializers with external data that are used on CPU are not planned or copied. Their file is memory mapped,
+//      so the data is only read on first use by PrePack or Compute. The mapping is released as soon as every
+//      consumer has pre-packed the tensor.
+//      The other initializers are allocated outside the arena, as with "session.use_device_allocator_for_initializers".
+//      Then the memory of an original released after pre-packing returns to the system instead of staying reserved
+//      by the arena.
+static const char* const kOrtSessionOptionsLazyInitializers = "session.lazy_initializers";
+
+// Configure how the external data of initializers used on CPU is loaded.
+// Requires "session.parallel_initialization" to be "1" and is ignored in lazy initializer mode.
+// "0": default. The file is memory mapped for each initializer and pages are read on first access.
+// "1": the initializers are planned like the other initializers, and their data is read into the planned buffers
+//      before PrePack. The reads are grouped by file and sorted by offset, and large runs of consecutive ranges are
+//      read in parallel on the intra-op thread pool, which keeps fast storage busy.
+//      Initializers with data in memory or with pre-packed blobs in the external data file are still mapped.
+static const char* const kOrtSessionOptionsParallelExternalDataRead = "session.parallel_external_data_read";
+
+// Configure how the memory pattern is computed for input shapes seen for the first time.
+// Requires the memory pattern to be enabled (the default in sequential execution mode).
+// "0": default. The first Run with new input shapes allocates each tensor dynamically and records the memory pattern
+//      used by later Runs with the same shapes.
+// "1": the tensor sizes are planned as expressions in the symbolic dimensions of the graph inputs (e.g. batch,
+//      sequence length) when the session is initialized. The first Run with new input shapes evaluates them and uses
+//      the resulting memory pattern directly. Tensors whose shape is not made of fixed values and symbolic dimensions
+//      of the graph inputs are left out of the pattern and allocated dynamically.
+static const char* const kOrtSessionOptionsSymbolicMemoryPattern = "session.symbolic_memory_pattern";
+
+// Control whether the memory pattern buffers of control flow subgraphs (If, Loop, Scan) are kept for re-use.
+// "0": default. A memory pattern buffer is returned to a small per-subgraph pool when a subgraph execution finishes,
+//      and later executions with the same or smaller memory pattern take it from the pool instead of allocating.
+//      The pooled buffers are released when the memory arenas are shrunk with the
+//      kOrtRunOptionsConfigEnableMemoryArenaShrinkage run option.
+// "1": each subgraph execution allocates and frees its own memory pattern buffers.
+static const char* const kOrtSessionOptionsDisableSubgraphMemoryPatternBufferPool =
+    "session.disable_subgraph_memory_pattern_buffer_pool";
+
+// Budget in bytes for the estimated peak activation memory of the main graph on CPU.
+// "0": default, no budget.
+// When set, cheap element-wise nodes (e.g. Add, Relu, Gelu, Cast) whose output stays alive across the peak are
+// duplicated next to their late consumers, so the output is released early and recomputed when it is needed again.
+// This trades some compute for memory and lets larger batches fit in a fixed memory limit.
+// The estimate uses the static shapes of the activations. Use free dimension overrides to fix the symbolic
+// dimensions such as the batch size. Requires the graph optimization level ORT_ENABLE_ALL and the priority based
+// execution order, which runs the recomputed nodes as late as possible.
+static const char* const kOrtSessionOptionsActivationMemoryBudgetInBytes =
+    "session.activation_memory_budget_in_bytes";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -189,6 +270,22 @@ static const char* const kOrtSessionOptionsConfigForceSpinningStop = "session.fo
 // May be useful to expose bugs in models.
 static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "session.strict_shape_type_inference";
 
+// TunableOp for the CPU execution provider. Kernels that support it, such as float MatMul, can choose between
+// several implementations, e.g. how the work is spread over the intra-op thread pool.
+// "1": use the fastest implementation recorded in the tuning results for each shape. Tuning results stored in the
+//      model metadata are loaded, and enable this, automatically.
+// "0": always use the default implementation. The default.
+static const char* const kOrtSessionOptionsCpuTunableOpEnable = "session.cpu_tunable_op_enable";
+
+// "1": when CPU TunableOp is enabled, benchmark the implementations the first time a kernel sees a shape without a
+//      recorded result, and record the fastest. The results can be retrieved from the session and persisted.
+// "0": do not tune. The default.
+static const char* const kOrtSessionOptionsCpuTunableOpTuningEnable = "session.cpu_tunable_op_tuning_enable";
+
+// Maximum time in milliseconds to spend benchmarking each implementation when tuning. "0" means no limit. The default.
+static const char* const kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs =
+    "session.cpu_tunable_op_max_tuning_duration_ms";
+
 // "1": every model using a more recent opset than the latest released one will fail
 // "0": the model may or may not work if onnxruntime cannot find an implementation, this option
 // is used for development purpose.
@@ -337,6 +434,35 @@ static const char* const kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16 = "mlas
 // If not provided, default is 4.
 static const char* const kOrtSessionOptionsQDQMatMulNBitsAccuracyLevel = "session.qdq_matmulnbits_accuracy_level";
 
+// Quantizes the constant float weights of MatMul and Gemm nodes assigned to the CPU EP when the session is loaded.
+// Option values:
+// - "0": Weights are not quantized. [DEFAULT]
+// - "4": Weights are quantized block-wise to 4 bits and the nodes are replaced by MatMulNBits.
+// - "8": Weights are quantized per column to int8 and the nodes are replaced by DynamicQuantizeMatMul.
+static const char* const kOrtSessionOptionsMatMulWeightQuantizationBits = "session.matmul_weight_quantization_bits";
+
+// Block size of the 4 bits weight quantization. It must be a power of 2 between 16 and 256.
+// If not provided, default is 32.
+static const char* const kOrtSessionOptionsMatMulWeightQuantizationBlockSize =
+    "session.matmul_weight_quantization_block_size";
+
+// accuracy_level of the MatMulNBits nodes created by the 4 bits weight quantization.
+// Refer to MatMulNBits op schema for more details.
+// If not provided, default is 4.
+static const char* const kOrtSessionOptionsMatMulWeightQuantizationAccuracyLevel =
+    "session.matmul_weight_quantization_accuracy_level";
+
+// Semicolon separated list of MatMul/Gemm node names whose weights are not quantized, e.g. "lm_head;proj_0".
+// Default is an empty string.
+static const char* const kOrtSessionOptionsMatMulWeightQuantizationExcludedNodes =
+    "session.matmul_weight_quantization_excluded_nodes";
+
+// Semicolon separated list of per-node accuracy levels for the 4 bits weight quantization, overriding
+// session.matmul_weight_quantization_accuracy_level for those nodes, e.g. "attn_qkv:0;mlp_up:1".
+// Default is an empty string.
+static const char* const kOrtSessionOptionsMatMulWeightQuantizationNodeAccuracyLevels =
+    "session.matmul_weight_quantization_node_accuracy_levels";
+
 // THIS OPTION IS NOT A REGULAR SESSION OPTION SINCE IT CAN BE MODIFIED AT ANY TIME
 // Meant to be used with SetEpDynamicOptions
 // Specify the type of workload for this session.
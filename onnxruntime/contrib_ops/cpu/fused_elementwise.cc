@@ -0,0 +1,312 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/util/math_cpuonly.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs the element-wise program built by the ElementwiseFusion transformer. The data is processed in tiles that fit
+// in L1 cache, and each tile goes through every instruction before the next one is loaded.
+class FusedElementwise final : public OpKernel {
+ public:
+  explicit FusedElementwise(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  enum class OpCode {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Neg,
+    Abs,
+    Exp,
+    Sqrt,
+  };
+
+  static bool IsBinary(OpCode op) {
+    return op == OpCode::Add || op == OpCode::Sub || op == OpCode::Mul || op == OpCode::Div;
+  }
+
+  struct Instruction {
+    OpCode op;
+    int64_t lhs;
+    int64_t rhs;  // -1 for unary operators
+    // The result goes to this output, or to this scratch slot if output is -1.
+    int64_t output;
+    int64_t slot;
+  };
+
+  struct Register {
+    const float* data;
+    bool scalar;
+  };
+
+  // Number of floats per register in a tile.
+  static constexpr size_t kTileSize = 2048;
+
+  void EvaluateTile(gsl::span<const Register> inputs, gsl::span<float* const> outputs, float* scratch,
+                    size_t offset, size_t count, gsl::span<Register> registers) const;
+
+  int64_t num_inputs_;
+  std::vector<Instruction> instructions_;
+  std::vector<int64_t> output_registers_;
+  // Outputs that repeat an earlier output register are copied from that output.
+  std::vector<int64_t> output_copied_from_;
+  int64_t num_slots_ = 0;
+};
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  num_inputs_ = static_cast<int64_t>(info.GetInputCount());
+  const auto ops = info.GetAttrsOrDefault<std::string>("ops");
+  const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+  output_registers_ = info.GetAttrsOrDefault<int64_t>("outputs");
+
+  ORT_ENFORCE(!ops.empty(), "FusedElementwise needs at least one instruction.");
+  ORT_ENFORCE(operands.size() == 2 * ops.size(), "FusedElementwise needs two operands per instruction, got ",
+              operands.size(), " for ", ops.size(), " instructions.");
+  ORT_ENFORCE(output_registers_.size() == info.GetOutputCount(),
+              "FusedElementwise needs one output register per output.");
+
+  static const InlinedHashMap<std::string, OpCode> op_codes{
+      {"Add", OpCode::Add}, {"Sub", OpCode::Sub}, {"Mul", OpCode::Mul}, {"Div", OpCode::Div},
+      {"Relu", OpCode::Relu}, {"Sigmoid", OpCode::Sigmoid}, {"Tanh", OpCode::Tanh}, {"Neg", OpCode::Neg},
+      {"Abs", OpCode::Abs}, {"Exp", OpCode::Exp}, {"Sqrt", OpCode::Sqrt}};
+
+  const int64_t num_registers = num_inputs_ + static_cast<int64_t>(ops.size());
+  InlinedVector<int64_t> output_of_register(narrow<size_t>(num_registers), -1);
+  output_copied_from_.assign(output_registers_.size(), -1);
+  for (size_t i = 0; i < output_registers_.size(); ++i) {
+    const int64_t reg = output_registers_[i];
+    ORT_ENFORCE(reg >= num_inputs_ && reg < num_registers,
+                "FusedElementwise output ", i, " must be the result of an instruction, got register ", reg);
+    if (output_of_register[reg] == -1) {
+      output_of_register[reg] = static_cast<int64_t>(i);
+    } else {
+      output_copied_from_[i] = output_of_register[reg];
+    }
+  }
+
+  instructions_.reserve(ops.size());
+  InlinedVector<int64_t> last_use(narrow<size_t>(num_registers), -1);
+  for (size_t i = 0; i < ops.size(); ++i) {
+    const auto op_code = op_codes.find(ops[i]);
+    ORT_ENFORCE(op_code != op_codes.end(), "FusedElementwise does not support operator ", ops[i]);
+
+    // instructions may only read the inputs and the results of earlier instructions
+    const int64_t reg = num_inputs_ + static_cast<int64_t>(i);
+    const int64_t lhs = operands[2 * i];
+    const int64_t rhs = operands[2 * i + 1];
+    ORT_ENFORCE(lhs >= 0 && lhs < reg, "FusedElementwise instruction ", i, " has invalid operand ", lhs);
+    if (IsBinary(op_code->second)) {
+      ORT_ENFORCE(rhs >= 0 && rhs < reg, "FusedElementwise instruction ", i, " has invalid operand ", rhs);
+      last_use[rhs] = static_cast<int64_t>(i);
+    } else {
+      ORT_ENFORCE(rhs == -1, "FusedElementwise unary instruction ", i, " must have -1 as second operand.");
+    }
+    last_use[lhs] = static_cast<int64_t>(i);
+
+    instructions_.push_back(Instruction{op_code->second, lhs, rhs, output_of_register[reg], -1});
+  }
+
+  // Give the intermediate results scratch slots, reusing a slot once its value is dead. A result can overwrite one of
+  // its own operands because every element only depends on the elements at the same position.
+  InlinedVector<int64_t> slot_of_register(narrow<size_t>(num_registers), -1);
+  InlinedVector<int64_t> free_slots;
+  for (size_t i = 0; i < instructions_.size(); ++i) {
+    Instruction& instruction = instructions_[i];
+    for (const int64_t operand : {instruction.lhs, instruction.rhs}) {
+      if (operand >= 0 && slot_of_register[operand] >= 0 && last_use[operand] == static_cast<int64_t>(i) &&
+          std::find(free_slots.begin(), free_slots.end(), slot_of_register[operand]) == free_slots.end()) {
+        free_slots.push_back(slot_of_register[operand]);
+      }
+    }
+
+    if (instruction.output >= 0) {
+      continue;
+    }
+
+    if (free_slots.empty()) {
+      instruction.slot = num_slots_++;
+    } else {
+      instruction.slot = free_slots.back();
+      free_slots.pop_back();
+    }
+
+    const int64_t reg = num_inputs_ + static_cast<int64_t>(i);
+    slot_of_register[reg] = instruction.slot;
+    if (last_use[reg] == -1) {
+      free_slots.push_back(instruction.slot);
+    }
+  }
+}
+
+void FusedElementwise::EvaluateTile(gsl::span<const Register> inputs, gsl::span<float* const> outputs,
+                                    float* scratch, size_t offset, size_t count,
+                                    gsl::span<Register> registers) const {
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    registers[i] = Register{inputs[i].scalar ? inputs[i].data : inputs[i].data + offset, inputs[i].scalar};
+  }
+
+  for (size_t i = 0; i < instructions_.size(); ++i) {
+    const Instruction& instruction = instructions_[i];
+    float* result = instruction.output >= 0 ? outputs[instruction.output] + offset
+                                            : scratch + instruction.slot * kTileSize;
+    const Register lhs = registers[instruction.lhs];
+
+    if (IsBinary(instruction.op)) {
+      const Register rhs = registers[instruction.rhs];
+      // with two scalar operands the value is computed once and then broadcast
+      const size_t n = lhs.scalar && rhs.scalar ? 1 : count;
+      EigenVectorArrayMap<float> out(result, n);
+      auto apply = [&](auto a, auto b) {
+        switch (instruction.op) {
+          case OpCode::Add:
+            out = a + b;
+            break;
+          case OpCode::Sub:
+            out = a - b;
+            break;
+          case OpCode::Mul:
+            out = a * b;
+            break;
+          default:
+            out = a / b;
+            break;
+        }
+      };
+
+      if (lhs.scalar && !rhs.scalar) {
+        apply(*lhs.data, ConstEigenVectorArrayMap<float>(rhs.data, n));
+      } else if (!lhs.scalar && rhs.scalar) {
+        apply(ConstEigenVectorArrayMap<float>(lhs.data, n), *rhs.data);
+      } else {
+        apply(ConstEigenVectorArrayMap<float>(lhs.data, n), ConstEigenVectorArrayMap<float>(rhs.data, n));
+      }
+    } else {
+      const size_t n = lhs.scalar ? 1 : count;
+      ConstEigenVectorArrayMap<float> in(lhs.data, n);
+      EigenVectorArrayMap<float> out(result, n);
+      switch (instruction.op) {
+        case OpCode::Relu:
+          out = in.cwiseMax(0.0f);
+          break;
+        case OpCode::Sigmoid:
+          MlasComputeLogistic(lhs.data, result, n);
+          break;
+        case OpCode::Tanh:
+          MlasComputeTanh(lhs.data, result, n);
+          break;
+        case OpCode::Neg:
+          out = -in;
+          break;
+        case OpCode::Abs:
+          out = in.abs();
+          break;
+        case OpCode::Exp:
+          MlasComputeExp(lhs.data, result, n);
+          break;
+        default:
+          out = in.sqrt();
+          break;
+      }
+    }
+
+    const bool scalar = lhs.scalar && (instruction.rhs < 0 || registers[instruction.rhs].scalar);
+    if (scalar) {
+      std::fill(result + 1, result + count, result[0]);
+    }
+    registers[num_inputs_ + i] = Register{result, false};
+  }
+
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (output_copied_from_[i] >= 0) {
+      const float* source = outputs[output_copied_from_[i]] + offset;
+      std::copy(source, source + count, outputs[i] + offset);
+    }
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  // the output shape is the one of the largest input, every other input has that shape or a single element
+  const Tensor* largest = context->Input<Tensor>(0);
+  for (int64_t i = 1; i < num_inputs_; ++i) {
+    const Tensor* input = context->Input<Tensor>(static_cast<int>(i));
+    const auto size = input->Shape().Size();
+    const auto largest_size = largest->Shape().Size();
+    if (size > largest_size ||
+        (size == largest_size && input->Shape().NumDimensions() > largest->Shape().NumDimensions())) {
+      largest = input;
+    }
+  }
+
+  const TensorShape& shape = largest->Shape();
+  InlinedVector<Register> inputs;
+  inputs.reserve(narrow<size_t>(num_inputs_));
+  for (int64_t i = 0; i < num_inputs_; ++i) {
+    const Tensor* input = context->Input<Tensor>(static_cast<int>(i));
+    const bool scalar = input->Shape().Size() == 1 && input->Shape() != shape;
+    if (!scalar && input->Shape() != shape) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "FusedElementwise input ", i, " has shape ",
+                             input->Shape(), " which is neither ", shape, " nor a single element.");
+    }
+    inputs.push_back(Register{input->Data<float>(), scalar});
+  }
+
+  InlinedVector<float*> outputs;
+  outputs.reserve(output_registers_.size());
+  for (size_t i = 0; i < output_registers_.size(); ++i) {
+    outputs.push_back(context->Output(static_cast<int>(i), shape)->MutableData<float>());
+  }
+
+  const size_t total = narrow<size_t>(shape.Size());
+  if (total == 0) {
+    return Status::OK();
+  }
+
+  const size_t num_tiles = (total + kTileSize - 1) / kTileSize;
+  const double tile_bytes = static_cast<double>(kTileSize * sizeof(float));
+  const TensorOpCost cost{static_cast<double>(inputs.size()) * tile_bytes,
+                          static_cast<double>(outputs.size()) * tile_bytes,
+                          static_cast<double>(instructions_.size() * kTileSize) * 4.0};
+  const size_t scratch_size = narrow<size_t>(num_slots_) * kTileSize;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_tiles), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> scratch(scratch_size);
+        InlinedVector<Register> registers(narrow<size_t>(num_inputs_) + instructions_.size());
+        for (auto tile = begin; tile < end; ++tile) {
+          const size_t offset = static_cast<size_t>(tile) * kTileSize;
+          EvaluateTile(inputs, outputs, scratch.data(), offset, std::min(kTileSize, total - offset), registers);
+        }
+      });
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -3,8 +3,10 @@
 
 #include "contrib_ops/cpu/quantization/matmul_nbits_impl.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <type_traits>
+#include <vector>
 
 #include "core/common/common.h"
 #include "core/common/narrow.h"
@@ -73,6 +75,73 @@ GetComputeType<MLFloat16>(size_t nbits, size_t block_size, int64_t accuracy_leve
 }
 #endif  // !MLAS_F16VEC_INTRINSICS_SUPPORTED || !MLAS_TARGET_ARM64
 
+// Number of columns of B that ComputeBDequantizedTiles dequantizes at once. The float tile stays around 256KB for
+// typical K and is a multiple of 16 columns so that SGEMM works on full column blocks.
+size_t GetDequantizeTileColumns(size_t K) {
+  constexpr size_t kTileFloats = 64 * 1024;
+  return std::max<size_t>(16, kTileFloats / std::max<size_t>(K, 1) / 16 * 16);
+}
+
+// Y = A * B^T + bias for B quantized with a bit width that has no QNBitGemm kernel. B stays quantized. Each task
+// dequantizes a tile of columns of B into its own buffer and runs SGEMM for those columns, so at most one tile per
+// thread is held in float.
+template <typename zeroT>
+void ComputeBDequantizedTiles(const float* a_data, const uint8_t* b_data, const float* scales_data,
+                              const zeroT* zero_points_data, const int32_t* reorder_idx_data, const float* bias_data,
+                              float* y_data, size_t nbits, size_t block_size, const MatMulComputeHelper& helper,
+                              concurrency::ThreadPool* thread_pool) {
+  const size_t batch_count = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+  const size_t lda = helper.Lda(false);
+  const size_t tile_columns = std::min(N, GetDequantizeTileColumns(K));
+  const size_t tile_count = (N + tile_columns - 1) / tile_columns;
+
+  const double tile_size = static_cast<double>(tile_columns) * static_cast<double>(K);
+  const double gemm_size = static_cast<double>(batch_count) * static_cast<double>(M);
+  const TensorOpCost cost{tile_size * static_cast<double>(nbits) / 8 + gemm_size * static_cast<double>(K) * 4,
+                          gemm_size * static_cast<double>(tile_columns) * 4,
+                          tile_size * 4 + gemm_size * tile_size * 2};
+
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(tile_count), cost,
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        std::vector<float> tile(tile_columns * K);
+        for (std::ptrdiff_t tile_idx = begin; tile_idx < end; ++tile_idx) {
+          const size_t n_begin = static_cast<size_t>(tile_idx) * tile_columns;
+          const size_t n_end = std::min(N, n_begin + tile_columns);
+          DequantizeBlockwiseColumns<float, zeroT>(
+              tile.data(), b_data, scales_data, zero_points_data, reorder_idx_data,
+              static_cast<int32_t>(nbits), static_cast<int32_t>(block_size), static_cast<int32_t>(K),
+              static_cast<int32_t>(n_begin), static_cast<int32_t>(n_end));
+
+          for (size_t i = 0; i < batch_count; ++i) {
+            MLAS_SGEMM_DATA_PARAMS data;
+            data.A = a_data + helper.LeftOffsets()[i];
+            data.lda = lda;
+            data.B = tile.data();
+            data.ldb = K;
+            data.C = y_data + helper.OutputOffsets()[i] + n_begin;
+            data.ldc = N;
+
+            // if there is a bias input, copy bias values into C and set beta to 1.0f
+            if (bias_data) {
+              float* C_row = data.C;
+              for (size_t m = 0; m < M; ++m) {
+                std::copy(bias_data + n_begin, bias_data + n_end, C_row);
+                C_row += N;
+              }
+              data.beta = 1.0f;
+            }
+
+            // the tiles already run in parallel
+            MlasGemm(CblasNoTrans, CblasTrans, M, n_end - n_begin, K, data, nullptr);
+          }
+        }
+      });
+}
+
 }  // namespace
 
 bool GetType(const NodeArg& node_arg, int32_t& type) {
@@ -111,8 +180,10 @@ class MatMulNBits final : public OpKernel {
       has_unquantized_zero_point_ = type != ONNX_NAMESPACE::TensorProto_DataType_UINT8;
     }
 
-    ORT_ENFORCE(nbits_ == 4,
-                "Only 4b quantization is supported for MatMulNBits op, additional bits support is planned.");
+    // 4 bits uses the MLAS QNBitGemm kernels where available. other bit widths dequantize B tile by tile in Compute
+    // and use SGEMM, so B is never held in float as a whole.
+    ORT_ENFORCE(nbits_ >= 2 && nbits_ <= 8,
+                "Only 2 to 8 bit quantization is supported for MatMulNBits op. bits=", nbits_);
     const Tensor* tensor_zero_point = nullptr;
     has_zp_input_ = info.TryGetConstantInput(InputIndex::zero_points, &tensor_zero_point);
   }
@@ -432,11 +503,25 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
   const size_t lda = helper.Lda(false);
   const size_t ldb = helper.Ldb(true);
 
+  if (nbits_ != 4) {
+    ORT_ENFORCE(column_wise_quant_, "Row-wise quantization is not supported for now");
+    const float* bias_data = bias == nullptr ? nullptr : bias->Data<float>();
+    if (zero_points && zero_points->IsDataType<float>()) {
+      ComputeBDequantizedTiles(a_data, b_data, scales_data, static_cast<const float*>(zero_points_data),
+                               reorder_idx_data, bias_data, y_data, nbits_, block_size_, helper, thread_pool);
+    } else {
+      ComputeBDequantizedTiles(a_data, b_data, scales_data, static_cast<const uint8_t*>(zero_points_data),
+                               reorder_idx_data, bias_data, y_data, nbits_, block_size_, helper, thread_pool);
+    }
+
+    return Status::OK();
+  }
+
   // TODO(fajin): move B dequant to prepack
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_, true);
 
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
-    // dequantize b, only 4b quantization is supported for now
+  if (nbits_ == 4 && (reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<float>())) {
+    // dequantize b, only 4b quantization is supported by MLAS
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
         b_data,                                         // quantized input
@@ -457,6 +542,7 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
           scales_data,                                  // quantization scales
           static_cast<const float*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
@@ -469,6 +555,7 @@ Status MatMulNBits<float>::ComputeBUnpacked(const Tensor* a,
           scales_data,                                    // quantization scales
           static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
@@ -551,11 +638,44 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
     scales_ptr = scales_fp32_.get();
   }
 
+  if (nbits_ != 4) {
+    ORT_ENFORCE(column_wise_quant_, "Row-wise quantization is not supported for now");
+    auto a_size = static_cast<size_t>(a->Shape().Size());
+    auto tmp_a_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, a_size, true);
+    MlasConvertHalfToFloatBuffer(a_data, tmp_a_data_ptr.get(), a_size);
+
+    const float* bias_ptr = nullptr;
+    IAllocatorUniquePtr<float> bias_temp;
+    if (bias && !bias_fp32_) {
+      const size_t bias_size = static_cast<size_t>(bias->Shape().Size());
+      bias_temp = IAllocator::MakeUniquePtr<float>(allocator, bias_size, true);
+      MlasConvertHalfToFloatBuffer(bias->Data<MLFloat16>(), bias_temp.get(), bias_size);
+      bias_ptr = bias_temp.get();
+    } else if (bias) {
+      bias_ptr = bias_fp32_.get();
+    }
+
+    auto c_size = static_cast<size_t>(y->Shape().Size());
+    auto tmp_c_ptr = IAllocator::MakeUniquePtr<float>(allocator, c_size, true);
+    if (zero_points && zero_points->IsDataType<MLFloat16>()) {
+      ComputeBDequantizedTiles(tmp_a_data_ptr.get(), b_data, scales_ptr,
+                               static_cast<const MLFloat16*>(zero_points_data), reorder_idx_data, bias_ptr,
+                               tmp_c_ptr.get(), nbits_, block_size_, helper, thread_pool);
+    } else {
+      ComputeBDequantizedTiles(tmp_a_data_ptr.get(), b_data, scales_ptr,
+                               static_cast<const uint8_t*>(zero_points_data), reorder_idx_data, bias_ptr,
+                               tmp_c_ptr.get(), nbits_, block_size_, helper, thread_pool);
+    }
+
+    MlasConvertFloatToHalfBuffer(tmp_c_ptr.get(), y_data, c_size);
+    return Status::OK();
+  }
+
   // TODO(fajin): move B dequant to prepack
   auto tmp_b_data_ptr = IAllocator::MakeUniquePtr<float>(allocator, SafeInt<size_t>(K_) * N_, true);
 
-  if ((reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<MLFloat16>())) {
-    // dequantize b, only 4b quantization is supported for now
+  if (nbits_ == 4 && (reorder_idx_data == nullptr) && (!zero_points || !zero_points->IsDataType<MLFloat16>())) {
+    // dequantize b, only 4b quantization is supported by MLAS
     MlasDequantizeBlockwise<float, 4>(
         tmp_b_data_ptr.get(),                           // dequantized output
         b_data,                                         // quantized input
@@ -576,6 +696,7 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
           scales_ptr,                                       // quantization scales
           static_cast<const MLFloat16*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
@@ -588,6 +709,7 @@ Status MatMulNBits<MLFloat16>::ComputeBUnpacked(const Tensor* a,
           scales_ptr,                                     // quantization scales
           static_cast<const uint8_t*>(zero_points_data),  // quantization zero points
           reorder_idx_data,
+          static_cast<int32_t>(nbits_),       // number of bits per quantized value
           static_cast<int32_t>(block_size_),  // quantization block size
           column_wise_quant_,                 // columnwise quantization or row-wise
           static_cast<int32_t>(K_),           // number of rows in quantized input
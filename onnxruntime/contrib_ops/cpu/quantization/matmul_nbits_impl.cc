@@ -73,6 +73,53 @@ void Dequantize4BitsKernelReOrder(
   }
 }
 
+// Get the value at index idx from data where each value is 'bits' wide and the values are packed from the
+// least significant bit with no padding. A value may straddle two bytes if bits is not a power of 2.
+inline uint32_t GetPackedValue(const uint8_t* data, size_t idx, int bits) {
+  const size_t bit_offset = idx * static_cast<size_t>(bits);
+  const uint8_t* p = data + bit_offset / 8;
+  const int shift = static_cast<int>(bit_offset % 8);
+  uint32_t value = p[0];
+  if (shift + bits > 8) {
+    value |= static_cast<uint32_t>(p[1]) << 8;
+  }
+
+  return (value >> shift) & ((1u << bits) - 1);
+}
+
+// Dequantize row n of B (column n of the original K x N matrix) into the K values at row_output, for any bit width
+// from 2 to 8.
+template <class T, class zeroT>
+void DequantizeNBitsRow(T* row_output, const uint8_t* quant_data, const T* scale_data, const zeroT* zero_points,
+                        const int32_t* reorder_idx, int bits, int block_size, int K, int n) {
+  const int blocks_per_K = (K + block_size - 1) / block_size;
+  const int blob_size = (block_size * bits + 7) / 8;
+  const int zero_point_bytes_per_row = (blocks_per_K * bits + 7) / 8;
+  const float default_zero_point = static_cast<float>(1 << (bits - 1));
+
+  const uint8_t* row_data = quant_data + static_cast<size_t>(n) * blocks_per_K * blob_size;
+  const T* row_scales = scale_data + static_cast<size_t>(n) * blocks_per_K;
+
+  for (int k = 0; k < K; ++k) {
+    const int block = k / block_size;
+    const int32_t rid = reorder_idx ? reorder_idx[k] : block;
+
+    float zero_point = default_zero_point;
+    if (zero_points) {
+      if constexpr (std::is_same_v<zeroT, uint8_t>) {
+        zero_point = static_cast<float>(
+            GetPackedValue(zero_points + static_cast<size_t>(n) * zero_point_bytes_per_row, rid, bits));
+      } else {
+        zero_point = static_cast<float>(zero_points[static_cast<size_t>(n) * blocks_per_K + rid]);
+      }
+    }
+
+    const auto value = GetPackedValue(row_data + static_cast<size_t>(block) * blob_size, k % block_size, bits);
+    const float scale = static_cast<float>(row_scales[rid]);
+    row_output[k] = static_cast<T>((static_cast<float>(value) - zero_point) * scale);
+  }
+}
+
 template <typename inputT, typename zeroT>
 void DequantizeBlockwise(
     inputT* output,              // dequantized output
@@ -80,11 +127,26 @@ void DequantizeBlockwise(
     const inputT* scales_data,   // quantization scales
     const zeroT* zero_points,    // quantization zero points
     const int32_t* reorder_idx,  // reorder_idx for groupwise quantization
+    int32_t bits,                // number of bits per quantized value, 2 to 8
     int32_t block_size,          // quantization block size
     bool,                        // columnwise quantization or row-wise
     int32_t K,                   // number of rows in quantized input
     int32_t N,                   // number of columns in quantized input
     onnxruntime::concurrency::ThreadPool* pool) {
+  if (bits != 4) {
+    const double cost_per_row = static_cast<double>(K);
+    concurrency::ThreadPool::TryParallelFor(
+        pool, static_cast<std::ptrdiff_t>(N),
+        TensorOpCost{cost_per_row * bits / 8, cost_per_row * sizeof(inputT), cost_per_row * 4},
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t n = begin; n < end; ++n) {
+            DequantizeNBitsRow(output + n * K, quant_data, scales_data, zero_points, reorder_idx,
+                               bits, block_size, K, static_cast<int>(n));
+          }
+        });
+    return;
+  }
+
   auto ceildiv = [](int a, int b) { return (a + b - 1) / b; };
   constexpr int element_per_thread = 8;
   int groups_per_threadblock = 256 * element_per_thread / block_size;
@@ -102,20 +164,50 @@ void DequantizeBlockwise(
       });
 }
 
+template <typename inputT, typename zeroT>
+void DequantizeBlockwiseColumns(
+    inputT* output,
+    const uint8_t* quant_data,
+    const inputT* scales_data,
+    const zeroT* zero_points,
+    const int32_t* reorder_idx,
+    int32_t bits,
+    int32_t block_size,
+    int32_t K,
+    int32_t n_begin,
+    int32_t n_end) {
+  for (int32_t n = n_begin; n < n_end; ++n) {
+    DequantizeNBitsRow(output + static_cast<size_t>(n - n_begin) * K, quant_data, scales_data, zero_points,
+                       reorder_idx, bits, block_size, K, n);
+  }
+}
+
 template void DequantizeBlockwise<float, uint8_t>(
     float* output, const uint8_t* quant_data, const float* scales_data,
-    const uint8_t* zero_points, const int32_t* reorder_idx, int32_t block_size,
+    const uint8_t* zero_points, const int32_t* reorder_idx, int32_t bits, int32_t block_size,
     bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
 template void DequantizeBlockwise<float, float>(
     float* output, const uint8_t* quant_data, const float* scales_data,
-    const float* zero_points, const int32_t* reorder_idx, int32_t block_size,
+    const float* zero_points, const int32_t* reorder_idx, int32_t bits, int32_t block_size,
     bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
 template void DequantizeBlockwise<float, MLFloat16>(
     float* output, const uint8_t* quant_data, const float* scales_data,
-    const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t block_size,
+    const MLFloat16* zero_points, const int32_t* reorder_idx, int32_t bits, int32_t block_size,
     bool columnwise, int32_t K, int32_t N, onnxruntime::concurrency::ThreadPool* thread_pool);
 
+template void DequantizeBlockwiseColumns<float, uint8_t>(
+    float* output, const uint8_t* quant_data, const float* scales_data, const uint8_t* zero_points,
+    const int32_t* reorder_idx, int32_t bits, int32_t block_size, int32_t K, int32_t n_begin, int32_t n_end);
+
+template void DequantizeBlockwiseColumns<float, float>(
+    float* output, const uint8_t* quant_data, const float* scales_data, const float* zero_points,
+    const int32_t* reorder_idx, int32_t bits, int32_t block_size, int32_t K, int32_t n_begin, int32_t n_end);
+
+template void DequantizeBlockwiseColumns<float, MLFloat16>(
+    float* output, const uint8_t* quant_data, const float* scales_data, const MLFloat16* zero_points,
+    const int32_t* reorder_idx, int32_t bits, int32_t block_size, int32_t K, int32_t n_begin, int32_t n_end);
+
 }  // namespace contrib
 }  // namespace onnxruntime
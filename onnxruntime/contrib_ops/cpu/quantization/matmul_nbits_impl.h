@@ -13,11 +13,27 @@ void DequantizeBlockwise(
     const inputT* scales_data,   // quantization scales
     const zeroT* zero_points,    // quantization zero points
     const int32_t* reorder_idx,  // quantization zero points
+    int32_t bits,                // number of bits per quantized value, 2 to 8
     int32_t block_size,          // quantization block size
     bool,                        // columnwise quantization or row-wise
     int32_t K,                   // number of rows in quantized input
     int32_t N,                   // number of columns in quantized input
     onnxruntime::concurrency::ThreadPool* thread_pool);
 
+// Dequantize columns [n_begin, n_end) of the K x N matrix quantized column-wise with 2 to 8 bits. The output holds
+// n_end - n_begin rows of K values, in the same transposed layout as DequantizeBlockwise.
+template <typename inputT, typename zeroT>
+void DequantizeBlockwiseColumns(
+    inputT* output,              // dequantized output
+    const uint8_t* quant_data,   // quantized input
+    const inputT* scales_data,   // quantization scales
+    const zeroT* zero_points,    // quantization zero points
+    const int32_t* reorder_idx,  // reorder_idx for groupwise quantization
+    int32_t bits,                // number of bits per quantized value, 2 to 8
+    int32_t block_size,          // quantization block size
+    int32_t K,                   // number of rows in quantized input
+    int32_t n_begin,             // first column to dequantize
+    int32_t n_end);              // end of the columns to dequantize
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -49,5 +49,18 @@ class QLinearSigmoid final : public QLinearLookupBase<T> {
   Status Compute(OpKernelContext* context) const override;
 };
 
+template <typename T>
+class QLinearGelu final : public QLinearLookupBase<T> {
+ public:
+  QLinearGelu(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  float Gelu(float v) const;
+
+  bool approximate_tanh_;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/quantization/qlinear_layer_norm.h"
+
+#include <cmath>
+#include <vector>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+#include "core/providers/cpu/nn/layer_norm_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+namespace {
+
+template <typename T>
+Status GetQuantizationParameter(const Tensor* scale, const Tensor* zero_point, const char* name,
+                                float& scale_value, T& zero_point_value) {
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(scale), name, "_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(zero_point == nullptr || IsScalarOr1ElementVector(zero_point),
+                    name, "_zero_point must be a scalar or 1D tensor of size 1 if given");
+  scale_value = *scale->Data<float>();
+  zero_point_value = zero_point ? *zero_point->Data<T>() : T(0);
+  return Status::OK();
+}
+
+}  // namespace
+
+template <typename T>
+QLinearLayerNormalization<T>::QLinearLayerNormalization(const OpKernelInfo& info)
+    : OpKernel(info),
+      axis_(info.GetAttrOrDefault<int64_t>("axis", -1)),
+      epsilon_(info.GetAttrOrDefault<float>("epsilon", 1e-5f)) {
+}
+
+template <typename T>
+Status QLinearLayerNormalization<T>::Compute(OpKernelContext* context) const {
+  const Tensor& X = *context->Input<Tensor>(0);
+  const Tensor& scale = *context->Input<Tensor>(5);
+  const Tensor* bias = context->Input<Tensor>(6);
+
+  float x_scale;
+  T x_zero_point;
+  ORT_RETURN_IF_ERROR(GetQuantizationParameter(context->Input<Tensor>(1), context->Input<Tensor>(2), "X",
+                                               x_scale, x_zero_point));
+  float y_scale;
+  T y_zero_point;
+  ORT_RETURN_IF_ERROR(GetQuantizationParameter(context->Input<Tensor>(3), context->Input<Tensor>(4), "Y",
+                                               y_scale, y_zero_point));
+
+  const TensorShape& x_shape = X.Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, x_shape.NumDimensions());
+  LayerNormParams params;
+  ORT_RETURN_IF_ERROR(LayerNormHelper::CheckInputs(x_shape, scale.Shape(), bias ? bias->Shape() : TensorShape(),
+                                                   bias != nullptr, axis, params));
+
+  Tensor& Y = *context->Output(0, x_shape);
+  if (x_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  // an 8 bit input has 256 possible values, dequantize them once instead of per element
+  float dequantized[256];
+  for (int i = 0; i < 256; ++i) {
+    const T value = static_cast<T>(i);
+    dequantized[static_cast<uint8_t>(value)] =
+        (static_cast<float>(value) - static_cast<float>(x_zero_point)) * x_scale;
+  }
+
+  const T* x_data = X.Data<T>();
+  const float* scale_data = scale.Data<float>();
+  const float* bias_data = bias ? bias->Data<float>() : nullptr;
+  T* y_data = Y.MutableData<T>();
+  const int64_t norm_size = params.norm_size;
+  const float epsilon = epsilon_;
+
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(params.num_rows),
+      TensorOpCost{static_cast<double>(norm_size), static_cast<double>(norm_size), static_cast<double>(norm_size) * 8},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<float> row_buffer(narrow<size_t>(norm_size));
+        float* row = row_buffer.data();
+        for (std::ptrdiff_t task_idx = first; task_idx < last; ++task_idx) {
+          const uint8_t* p_input = reinterpret_cast<const uint8_t*>(x_data) + task_idx * norm_size;
+
+          float mean = 0.0f;
+          float mean_square = 0.0f;
+          for (int64_t h = 0; h < norm_size; ++h) {
+            const float value = dequantized[p_input[h]];
+            row[h] = value;
+            mean += value;
+            mean_square += value * value;
+          }
+
+          mean = mean / norm_size;
+          const float inv_std_dev = 1.0f / std::sqrt(mean_square / norm_size - mean * mean + epsilon);
+
+          int64_t i = LAYER_NORM_SCALE_BIAS_OFFSET(params.broadcast_param, task_idx, norm_size);
+          for (int64_t h = 0; h < norm_size; ++h, ++i) {
+            row[h] = (row[h] - mean) * inv_std_dev * scale_data[i] + (bias_data ? bias_data[i] : 0.0f);
+          }
+
+          MlasQuantizeLinear(row, y_data + task_idx * norm_size, narrow<size_t>(norm_size),
+                             y_scale, y_zero_point);
+        }
+      });
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(data_type)               \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                      \
+      QLinearLayerNormalization, 1, data_type,                            \
+      KernelDefBuilder()                                                  \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      QLinearLayerNormalization<data_type>);
+
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -8,22 +8,19 @@
 #include "core/common/utf8_util.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensor.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/text/string_slices.h"
 #include "re2/re2.h"
+#include "re2/set.h"
 
-#ifdef _MSC_VER
-#include <memory_resource>
-#define ORT_PMR_ALLOCATOR_SUPPORTED
-#endif
-
-#include <optional>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
-#ifdef ORT_PMR_ALLOCATOR_SUPPORTED
-using SlicesVector = std::pmr::vector<re2::StringPiece>;
-#else
 using SlicesVector = std::vector<re2::StringPiece>;
-#endif
 
 namespace onnxruntime {
 namespace contrib {
@@ -52,7 +49,20 @@ class Tokenizer final : public OpKernel {
                          size_t N, size_t C,
                          gsl::span<const int64_t> input_dims) const;
 
-  void OutputData(gsl::span<const SlicesVector> rows,
+  Status SeparatorTokenizeRow(const std::string& s, SlicesVector& row, SlicesVector& tokens,
+                              std::vector<int>& matched_separators, StringSlices& out) const;
+
+  Status ExpressionTokenizeRow(const std::string& s, StringSlices& out) const;
+
+  // Tokenizes a contiguous range of input strings into one row of slices per string
+  using TokenizeShardFn = std::function<Status(gsl::span<const std::string> input, size_t max_tokens_per_row,
+                                               StringSlices& out)>;
+
+  // Runs tokenize_shard over shards of the input on the thread pool and writes the padded output
+  Status TokenizeRows(OpKernelContext* ctx, size_t N, size_t C, gsl::span<const int64_t> input_dims,
+                      const TokenizeShardFn& tokenize_shard) const;
+
+  void OutputData(const StringSlices& rows,
                   size_t max_tokens, size_t max_output_index, std::string* output_data) const;
 
   bool mark_{false};
@@ -60,6 +70,8 @@ class Tokenizer final : public OpKernel {
   size_t mincharnum_{0};
   bool char_tokenezation_{false};
   InlinedVector<std::unique_ptr<re2::RE2>> separators_;
+  // All the separators in one set, used to find the first separator that occurs in a string
+  std::unique_ptr<re2::RE2::Set> separator_set_;
   std::unique_ptr<re2::RE2> regex_;
 };
 
@@ -126,6 +138,13 @@ Tokenizer::Tokenizer(const OpKernelInfo& info) : OpKernel(info) {
         }
         separators_.push_back(std::move(regex));
       }
+      if (separators.size() > 1) {
+        separator_set_ = std::make_unique<re2::RE2::Set>(options, re2::RE2::UNANCHORED);
+        for (const auto& sep : separators) {
+          ORT_ENFORCE(separator_set_->Add(sep, nullptr) >= 0, "Can not digest separators: ", sep);
+        }
+        ORT_ENFORCE(separator_set_->Compile(), "Can not compile the separators");
+      }
     } else {
       // Use tokenexp
       assert(!tokenexp.empty());
@@ -214,7 +233,7 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
       [[maybe_unused]] bool result = utf8_bytes(static_cast<unsigned char>(s[token_idx]), tlen);
       assert(result);
       assert(token_idx + tlen <= str_len);
-      output_data[output_index] = s.substr(token_idx, tlen);
+      output_data[output_index].assign(s.data() + token_idx, tlen);
       ++output_index;
       token_idx += tlen;
       ++tokens;
@@ -235,91 +254,11 @@ Status Tokenizer::CharTokenize(OpKernelContext* ctx, size_t N, size_t C,
   return Status::OK();
 }
 
-namespace {
-
-// We use std::vector in this case, because InlinedVector::clear() is incompatible
-// with std::vector. It also deallocates memory, which is not what we want.
-
-// The compiler we are using GCC on Linux and Clang on MacOS does not
-// have the library that support C++17 PMR. So we are only using it on Windows
-// since the problem is acute on the platform.
-
-#ifdef ORT_PMR_ALLOCATOR_SUPPORTED
-/// <summary>
-/// This class provides a thin abstraction over the std::pmr::monotonic_buffer_resource
-/// If the allocated buffer is not enough, additional allocations are done using
-/// new/delete.
-/// </summary>
-class MonotonicAllocatorWithDefault : public std::pmr::monotonic_buffer_resource {
- public:
-  MonotonicAllocatorWithDefault(void* ptr, size_t size_in_bytes)
-      : monotonic_buffer_resource(ptr, size_in_bytes, std::pmr::get_default_resource()) {}
-  MonotonicAllocatorWithDefault(void* ptr, size_t size_in_bytes, std::pmr::memory_resource* upstream)
-      : monotonic_buffer_resource(ptr, size_in_bytes, upstream) {}
-};
-
-class MemoryAllocator {
- public:
-  explicit MemoryAllocator(size_t num_of_slices) {
-    size_t allocated_size = 0;
-    void* ptr = AlignedAllocate(num_of_slices, allocated_size);
-    resource_.emplace(ptr, allocated_size);
-  }
-
-  SlicesVector CreateVectorWithAllocator() {
-    return SlicesVector(&resource_.value());
-  }
-
-  SlicesVector& EmplaceBack(std::vector<SlicesVector>& rows) {
-    return rows.emplace_back(&resource_.value());
-  }
-
- private:
-  /// <summary>
-  /// Pre-allocate memory for the tokens to reduce a number of individual
-  /// allocations and thus memory contention.
-  /// Used in conjunction with PMR memory allocatior
-  /// </summary>
-  /// <param name="num">number of objects of T</param>
-  /// <param name="buf">buffer holder</param>
-  /// <param name="allocated_size">aligned allocated size</param>
-  /// <returns>pointer to the buffer</returns>
-  void* AlignedAllocate(size_t num, size_t& allocated_size) {
-    constexpr size_t alignment = alignof(re2::StringPiece);
-    const size_t size_bytes = SafeInt<size_t>(num) * sizeof(re2::StringPiece) + alignment;
-    buf_holder_ = std::make_unique<uint8_t[]>(size_bytes);
-    void* ptr = buf_holder_.get();
-    allocated_size = size_bytes;
-    return std::align(alignment, size_bytes, ptr, allocated_size);
-  }
-
-  std::unique_ptr<uint8_t[]> buf_holder_;
-  std::optional<MonotonicAllocatorWithDefault> resource_;
-};
-
-#else
-
-class MemoryAllocator {
- public:
-  explicit MemoryAllocator(size_t /* num_of_slices */) {
-  }
-
-  SlicesVector CreateVectorWithAllocator() const {
-    return SlicesVector{};
-  }
-
-  SlicesVector& EmplaceBack(std::vector<SlicesVector>& rows) const {
-    return rows.emplace_back();
-  }
-};
-
-#endif
-}  // namespace
-
-void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
+void Tokenizer::OutputData(const StringSlices& rows,
                            size_t max_tokens, [[maybe_unused]] size_t max_output_index, std::string* output_data) const {
   size_t output_index = 0;
-  for (const auto& row : rows) {
+  for (size_t r = 0, num_rows = rows.NumRows(); r < num_rows; ++r) {
+    const auto row = rows.Row(r);
     [[maybe_unused]] size_t c_idx = output_index;
     if (mark_) {
       output_data[output_index++].assign(&kStartMarker, 1);
@@ -340,223 +279,205 @@ void Tokenizer::OutputData(gsl::span<const SlicesVector> rows,
   }
 }
 
-Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
-                                               size_t N, size_t C,
-                                               gsl::span<const int64_t> input_dims) const {
+Status Tokenizer::SeparatorTokenizeRow(const std::string& s, SlicesVector& row, SlicesVector& tokens,
+                                       std::vector<int>& matched_separators, StringSlices& out) const {
   using namespace re2;
 
-  auto X = ctx->Input<Tensor>(0);
-  const auto input_span = X->DataAsSpan<std::string>();
-
-  // Let's estimate maximum number of tokens
-  // It is hard to estimate the number of separate characters that would not appear in the
-  // output.
-  size_t total_tokens_estimate = 0;
-  size_t max_tokens_per_row = 0;
-  ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
-  // Add a scratch token vector allocation
-  total_tokens_estimate += max_tokens_per_row;
-
-  // Pre-allocate memory for all tokens (StringPieces)
-  MemoryAllocator allocator(total_tokens_estimate);
-
-  // Make sure the vectors below are destroyed before the allocator
-  const size_t vector_num = SafeInt<size_t>(N) * C;
-
-  std::vector<SlicesVector> rows;
-  rows.reserve(vector_num);
-
-  // Re-use the same vector for each tokenization round
-  SlicesVector tokens = allocator.CreateVectorWithAllocator();
-  tokens.reserve(max_tokens_per_row);
-
   // We do not constraint the search to match
   // on the beginning or end of the string
   constexpr RE2::Anchor anchor = RE2::UNANCHORED;
 
-  // Scan all strings and attempt to find separators in them
-  // collect all the output tokens here
-  size_t max_tokens = 0;
-  for (const auto& s : input_span) {
-    size_t utf8_chars = 0;  // length in utf8 chars
-    if (!utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
-                  utf8_chars)) {
-      return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                    "Input string contains invalid utf8 chars: " + s);
-    }
-
-    const auto expected_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
-    auto& row = allocator.EmplaceBack(rows);
-    row.reserve(expected_tokens);
-    row.emplace_back(s);
-
-    for (const auto& sep : separators_) {
-      for (const auto& text : row) {
-        const auto end_pos = text.length();
-        size_t start_pos = 0;
-        StringPiece submatch;
-
-        bool match = true;
-        do {
-          match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
-          if (match) {
-            // Record  pos/len
-            assert(submatch.data() != nullptr);
-            size_t match_pos = submatch.data() - text.data();
-            assert(match_pos >= start_pos);
-            auto token_len = match_pos - start_pos;
-            utf8_chars = 0;
-            bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                                  token_len, utf8_chars);
-            if (!valid) {
-              return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
-                            "Match contains invalid utf8 chars: " + std::string{submatch});
-            }
-            if (utf8_chars >= mincharnum_) {
-              tokens.emplace_back(text.data() + start_pos, token_len);
-            }
-            // Update starting position
-            // Guard against empty string match
-            auto match_len = submatch.length();
-            if (match_len > 0) {
-              start_pos = match_pos + match_len;
-            } else {
-              size_t bytes = 0;
-              utf8_bytes(*submatch.data(), bytes);
-              start_pos = match_pos + bytes;
-            }
-          } else {
-            // record trailing token
-            auto trailing_len = end_pos - start_pos;
-            utf8_chars = 0;
-            utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
-                     trailing_len, utf8_chars);
-            if (utf8_chars >= mincharnum_) {
-              tokens.emplace_back(text.data() + start_pos, trailing_len);
-            }
-          }
-        } while (match);
-      }  // row
-
-      // We want to preserve the buffer for the next separator
-      // copying slices is cheaper than allocating new memory
-      if (!tokens.empty()) {
-        row = tokens;
-        tokens.clear();
-        continue;
-      }
-
-      // Nothing more to match for any remaining separators
-      row.clear();
-      tokens.clear();
-      break;
-    }  // separators_
-    max_tokens = std::max(max_tokens, row.size());
+  size_t utf8_chars = 0;  // length in utf8 chars
+  if (!utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(),
+                utf8_chars)) {
+    return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                  "Input string contains invalid utf8 chars: " + s);
   }
 
-  TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
-  // Check if we have no output due to either empty input
-  // or everything is a separator
-  if (max_tokens == 0) {
-    output_dims.push_back(0);
-    TensorShape output_shape(output_dims);
-    ctx->Output(0, output_shape);
-    return Status::OK();
+  const size_t string_chars = utf8_chars;
+  row.clear();
+  row.emplace_back(s);
+
+  // Until the first split every separator sees the whole string, and a separator that does not occur
+  // in it leaves it as a single token. One pass of the combined set finds the first separator
+  // that occurs in the string, so the ones before it are skipped.
+  size_t first_separator = 0;
+  if (separator_set_ != nullptr) {
+    matched_separators.clear();
+    RE2::Set::ErrorInfo error_info;
+    if (separator_set_->Match(s, &matched_separators, &error_info)) {
+      first_separator = static_cast<size_t>(*std::min_element(matched_separators.begin(), matched_separators.end()));
+    } else if (error_info.kind == RE2::Set::kNoError) {
+      first_separator = separators_.size();
+    }
+    // On any other error fall back to trying all the separators one by one.
   }
 
-  if (mark_) {
-    max_tokens += 2;  // Start/end markers as separate tokens
+  if (first_separator > 0 && string_chars < mincharnum_) {
+    // The whole string is the only token and it is too short
+    row.clear();
   }
 
-  output_dims.push_back(max_tokens);
-  TensorShape output_shape(output_dims);
-
-  auto output_tensor = ctx->Output(0, output_shape);
-  auto const output_data = output_tensor->MutableData<std::string>();
-
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
-
-  return Status::OK();
-}
-
-Status Tokenizer::TokenExpression(OpKernelContext* ctx,
-                                  size_t N, size_t C,
-                                  gsl::span<const int64_t> input_dims) const {
-  using namespace re2;
-
-  size_t max_tokens = 0;
-  auto X = ctx->Input<Tensor>(0);
-  const auto input_span = X->DataAsSpan<std::string>();
-
-  // Let's estimate maximum number of tokens
-  size_t total_tokens_estimate = 0;
-  size_t max_tokens_per_row = 0;
-  ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
-
-  // Pre-allocate memory for all tokens (StringPieces)
-  MemoryAllocator allocator(total_tokens_estimate);
-
-  // Make sure the vectors below are destroyed before the allocator
-  const size_t vector_num = SafeInt<size_t>(N) * C;
-
-  // We use std::vector in this case, because InlinedVector::clear() is incompatible
-  // with std::vector. It also deallocates memory, which is not what we want.
-  std::vector<SlicesVector> rows;
-  rows.reserve(vector_num);
-
-  // We do not constraint the search to match
-  // on the beginning or end of the string
-  constexpr RE2::Anchor anchor = RE2::UNANCHORED;
-
-  for (const auto& s : input_span) {
-    size_t utf8_chars = 0;
-    utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars);
-
-    auto& row = allocator.EmplaceBack(rows);
-
-    if (utf8_chars >= mincharnum_) {
-      auto estimated_tokens = std::max<size_t>(1, utf8_chars / mincharnum_);
-      row.reserve(estimated_tokens);
-
-      StringPiece text(s);
-      const auto end_pos = s.length();
+  for (size_t sep_idx = first_separator; !row.empty() && sep_idx < separators_.size(); ++sep_idx) {
+    const auto& sep = separators_[sep_idx];
+    for (const auto& text : row) {
+      const auto end_pos = text.length();
       size_t start_pos = 0;
       StringPiece submatch;
 
       bool match = true;
       do {
-        match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+        match = sep->Match(text, start_pos, end_pos, anchor, &submatch, 1);
         if (match) {
           // Record  pos/len
           assert(submatch.data() != nullptr);
-          size_t match_pos = submatch.data() - s.data();
+          size_t match_pos = submatch.data() - text.data();
           assert(match_pos >= start_pos);
-          // Guard against empty match and make
-          // sure we make progress either way
-          auto token_len = submatch.length();
+          auto token_len = match_pos - start_pos;
           utf8_chars = 0;
-          if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+          bool valid = utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                                token_len, utf8_chars);
+          if (!valid) {
             return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
                           "Match contains invalid utf8 chars: " + std::string{submatch});
           }
           if (utf8_chars >= mincharnum_) {
-            row.push_back(submatch);
-            start_pos = match_pos + token_len;
+            tokens.emplace_back(text.data() + start_pos, token_len);
+          }
+          // Update starting position
+          // Guard against empty string match
+          auto match_len = submatch.length();
+          if (match_len > 0) {
+            start_pos = match_pos + match_len;
           } else {
             size_t bytes = 0;
             utf8_bytes(*submatch.data(), bytes);
             start_pos = match_pos + bytes;
           }
+        } else {
+          // record trailing token
+          auto trailing_len = end_pos - start_pos;
+          utf8_chars = 0;
+          utf8_len(reinterpret_cast<const unsigned char*>(text.data() + start_pos),
+                   trailing_len, utf8_chars);
+          if (utf8_chars >= mincharnum_) {
+            tokens.emplace_back(text.data() + start_pos, trailing_len);
+          }
         }
       } while (match);
-    }
-    max_tokens = std::max(max_tokens, row.size());
+    }  // row
+
+    // We want to preserve both buffers for the next separator.
+    // If nothing is left there is nothing more to match for any remaining separators.
+    row.swap(tokens);
+    tokens.clear();
+  }  // separators_
+
+  for (const auto& token : row) {
+    out.Append(std::string_view(token.data(), token.size()));
+  }
+  out.EndRow();
+  return Status::OK();
+}
+
+Status Tokenizer::ExpressionTokenizeRow(const std::string& s, StringSlices& out) const {
+  using namespace re2;
+
+  // We do not constraint the search to match
+  // on the beginning or end of the string
+  constexpr RE2::Anchor anchor = RE2::UNANCHORED;
+
+  size_t utf8_chars = 0;
+  utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(), utf8_chars);
+
+  if (utf8_chars >= mincharnum_) {
+    StringPiece text(s);
+    const auto end_pos = s.length();
+    size_t start_pos = 0;
+    StringPiece submatch;
+
+    bool match = true;
+    do {
+      match = regex_->Match(text, start_pos, end_pos, anchor, &submatch, 1);
+      if (match) {
+        // Record  pos/len
+        assert(submatch.data() != nullptr);
+        size_t match_pos = submatch.data() - s.data();
+        assert(match_pos >= start_pos);
+        // Guard against empty match and make
+        // sure we make progress either way
+        auto token_len = submatch.length();
+        utf8_chars = 0;
+        if (!utf8_len(reinterpret_cast<const unsigned char*>(submatch.data()), token_len, utf8_chars)) {
+          return Status(common::ONNXRUNTIME, common::INVALID_ARGUMENT,
+                        "Match contains invalid utf8 chars: " + std::string{submatch});
+        }
+        if (utf8_chars >= mincharnum_) {
+          out.Append(std::string_view(submatch.data(), submatch.size()));
+          start_pos = match_pos + token_len;
+        } else {
+          size_t bytes = 0;
+          utf8_bytes(*submatch.data(), bytes);
+          start_pos = match_pos + bytes;
+        }
+      }
+    } while (match);
+  }
+  out.EndRow();
+  return Status::OK();
+}
+
+Status Tokenizer::TokenizeRows(OpKernelContext* ctx, size_t N, size_t C, gsl::span<const int64_t> input_dims,
+                               const TokenizeShardFn& tokenize_shard) const {
+  auto X = ctx->Input<Tensor>(0);
+  const auto input_span = X->DataAsSpan<std::string>();
+
+  // Let's estimate maximum number of tokens
+  // It is hard to estimate the number of separate characters that would not appear in the
+  // output.
+  size_t total_tokens_estimate = 0;
+  size_t max_tokens_per_row = 0;
+  ORT_RETURN_IF_ERROR(EstimateNumberOfTokens(input_span, max_tokens_per_row, total_tokens_estimate));
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  // The input strings are split into contiguous shards. Each shard collects its tokens in its own buffer,
+  // so the shards are tokenized in parallel and then written out in parallel once the padded
+  // row length is known.
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  const size_t num_strings = SafeInt<size_t>(N) * C;
+  constexpr size_t kMinStringsPerShard = 64;
+  const size_t num_shards = std::clamp<size_t>(num_strings / kMinStringsPerShard, 1,
+                                               concurrency::ThreadPool::DegreeOfParallelism(tp));
+
+  std::vector<std::unique_ptr<StringSlices>> shards(num_shards);
+  InlinedVector<Status> statuses(num_shards);
+  auto shard_work = [num_shards, num_strings](std::ptrdiff_t shard) {
+    return concurrency::ThreadPool::PartitionWork(shard, static_cast<std::ptrdiff_t>(num_shards),
+                                                  static_cast<std::ptrdiff_t>(num_strings));
+  };
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_shards),
+      [&](std::ptrdiff_t shard) {
+        const auto work = shard_work(shard);
+        const auto shard_input = input_span.subspan(static_cast<size_t>(work.start),
+                                                    static_cast<size_t>(work.end - work.start));
+        shards[shard] = std::make_unique<StringSlices>(alloc, shard_input.size(),
+                                                       total_tokens_estimate / num_shards + max_tokens_per_row);
+        statuses[shard] = tokenize_shard(shard_input, max_tokens_per_row, *shards[shard]);
+      });
+
+  size_t max_tokens = 0;
+  for (size_t shard = 0; shard < num_shards; ++shard) {
+    ORT_RETURN_IF_ERROR(statuses[shard]);
+    max_tokens = std::max(max_tokens, shards[shard]->MaxRowSize());
   }
 
-  // Check for empty output
   TensorShapeVector output_dims(input_dims.begin(), input_dims.end());
   // Check if we have no output due to either empty input
-  // everything is a separator
+  // or everything is a separator
   if (max_tokens == 0) {
     output_dims.push_back(0);
     TensorShape output_shape(output_dims);
@@ -574,11 +495,48 @@ Status Tokenizer::TokenExpression(OpKernelContext* ctx,
   auto output_tensor = ctx->Output(0, output_shape);
   auto const output_data = output_tensor->MutableData<std::string>();
 
-  OutputData(rows, max_tokens, narrow<size_t>(output_shape.Size()), output_data);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(num_shards),
+      [&](std::ptrdiff_t shard) {
+        const auto work = shard_work(shard);
+        const size_t output_offset = static_cast<size_t>(work.start) * max_tokens;
+        OutputData(*shards[shard], max_tokens, static_cast<size_t>(work.end - work.start) * max_tokens,
+                   output_data + output_offset);
+      });
 
   return Status::OK();
 }
 
+Status Tokenizer::SeparatorExpressionTokenizer(OpKernelContext* ctx,
+                                               size_t N, size_t C,
+                                               gsl::span<const int64_t> input_dims) const {
+  return TokenizeRows(ctx, N, C, input_dims,
+                      [this](gsl::span<const std::string> input, size_t max_tokens_per_row, StringSlices& out) {
+                        // Re-use the same vectors for each tokenization round
+                        SlicesVector row;
+                        row.reserve(max_tokens_per_row);
+                        SlicesVector tokens;
+                        tokens.reserve(max_tokens_per_row);
+                        std::vector<int> matched_separators;
+                        for (const auto& s : input) {
+                          ORT_RETURN_IF_ERROR(SeparatorTokenizeRow(s, row, tokens, matched_separators, out));
+                        }
+                        return Status::OK();
+                      });
+}
+
+Status Tokenizer::TokenExpression(OpKernelContext* ctx,
+                                  size_t N, size_t C,
+                                  gsl::span<const int64_t> input_dims) const {
+  return TokenizeRows(ctx, N, C, input_dims,
+                      [this](gsl::span<const std::string> input, size_t /* max_tokens_per_row */, StringSlices& out) {
+                        for (const auto& s : input) {
+                          ORT_RETURN_IF_ERROR(ExpressionTokenizeRow(s, out));
+                        }
+                        return Status::OK();
+                      });
+}
+
 Status Tokenizer::Compute(OpKernelContext* ctx) const {
   // Get input buffer ptr
   auto X = ctx->Input<Tensor>(0);
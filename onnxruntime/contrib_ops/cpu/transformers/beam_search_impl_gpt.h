@@ -238,9 +238,10 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
     }
   }
 
+  // The staging buffer is only needed to reorder the past state for the CUDA DecoderMaskedSelfAttention kernel.
   BeamSearchState<T> beam_state{*parameters,
                                 this->temp_space_allocator_,
-                                gpt_subgraph_.has_decoder_masked_attention_,
+                                gpt_subgraph_.has_decoder_masked_attention_ && this->IsCuda(),
                                 true /* use_position */,
                                 this->ort_stream_};
 
@@ -366,7 +367,7 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
                                       ReinterpretAsSpan<const int32_t>(beam_next_tokens),
-                                      gpt_subgraph_.has_decoder_masked_attention_
+                                      gpt_subgraph_.has_decoder_masked_attention_ && this->IsCuda()
                                           ? place_holder
                                           : ReinterpretAsSpan<const int32_t>(this->beam_scorer_->GetNextIndicesCPU()),
                                       gpt_subgraph_.has_decoder_masked_attention_
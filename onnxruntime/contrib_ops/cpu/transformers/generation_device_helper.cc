@@ -8,6 +8,7 @@
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "core/providers/cpu/generator/random.h"
 #include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
 #include <gsl/gsl>
 #include "contrib_ops/cpu/transformers/sequences.h"
 #include "contrib_ops/cpu/transformers/beam_search_scorer.h"
@@ -351,7 +352,7 @@ Status ProcessLogits(const OrtValue& logits,                                 //
 #endif
 
   // Apply all score processors that updates scores
-  logits_processors->Process(sequences, next_token_scores, step);
+  logits_processors->Process(sequences, next_token_scores, step, thread_pool);
 
 #ifdef DEBUG_GENERATION
   dumper->Print("next_token_scores after logits process", next_token_scores.data(), batch_size, num_beams, vocab_size);
@@ -359,16 +360,19 @@ Status ProcessLogits(const OrtValue& logits,                                 //
 
   // Add beam score to next token scores. Corresponding python code is like:
   //    next_token_scores = next_token_scores + beam_scores[:, None].expand_as(next_token_scores)
-  // TODO(tianleiwu): use thread pool to parallel
-  int offset = 0;
-  int batch_beam_index = 0;
-  for (int i = 0; i < batch_size; i++) {
-    for (int j = 0; j < num_beams; j++, batch_beam_index++) {
-      for (int k = 0; k < vocab_size; k++, offset++) {
-        next_token_scores[offset] += beam_state->beam_scores[batch_beam_index];
-      }
-    }
-  }
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, batch_beam_size,
+      TensorOpCost{static_cast<double>(vocab_size) * sizeof(T), static_cast<double>(vocab_size) * sizeof(T),
+                   static_cast<double>(vocab_size)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t batch_beam_index = begin; batch_beam_index < end; batch_beam_index++) {
+          T* row = next_token_scores.data() + SafeInt<size_t>(batch_beam_index) * vocab_size;
+          const T beam_score = beam_state->beam_scores[batch_beam_index];
+          for (int k = 0; k < vocab_size; k++) {
+            row[k] += beam_score;
+          }
+        }
+      });
 
 #ifdef DEBUG_GENERATION
   dumper->Print("next_token_scores adding beam_scores", next_token_scores.data(), batch_size, num_beams, vocab_size);
@@ -410,7 +414,7 @@ Status ProcessLogits(const OrtValue& logits,                                 //
   //   next_indices = (next_tokens / vocab_size).long()
   //   next_tokens = next_tokens % vocab_size
   gsl::span<const int64_t> next_token_indices = topk_indices.DataAsSpan<int64_t>();
-  offset = 0;
+  int offset = 0;
   for (int i = 0; i < batch_size; i++) {
     for (unsigned int j = 0; j < top_k; j++, offset++) {
       beam_state->next_indices[offset] = gsl::narrow_cast<int32_t>(next_token_indices[offset] / vocab_size);
@@ -451,6 +455,7 @@ Status GreedySearchProcessLogits(
     int step,                                               // iteration counter
     Stream* stream,                                         // cuda stream (for CUDA only)
     const IConsoleDumper* dumper) {                         // tensor dumper
+  ORT_UNUSED_PARAMETER(stream);
 
   int batch_size = parameters->batch_size;
   int vocab_size = parameters->vocab_size;
@@ -482,7 +487,7 @@ Status GreedySearchProcessLogits(
 #endif
 
   // Apply all score processors that updates scores
-  logits_processors->Process(sequences, next_token_scores, step);
+  logits_processors->Process(sequences, next_token_scores, step, thread_pool);
 
 #ifdef DEBUG_GENERATION
   dumper->Print("next_token_scores after logits processor", next_token_scores.data(), batch_size, 1, vocab_size);
@@ -500,50 +505,21 @@ Status GreedySearchProcessLogits(
     return Status::OK();
   }
 
-  // next_tokens = torch.argmax(scores, dim=-1)
-  int64_t next_token_scores_dims[] = {static_cast<int64_t>(batch_size), vocab_size};
-  TensorShape next_token_scores_shape(&next_token_scores_dims[0], 2);
-  auto element_type = DataTypeImpl::GetType<T>();
-  OrtValue next_token_scores_value;
-  Tensor::InitOrtValue(element_type,
-                       next_token_scores_shape,
-                       next_token_scores.data(),
-                       allocator->Info(),
-                       next_token_scores_value);
-  const Tensor& input = next_token_scores_value.Get<Tensor>();
-
-  constexpr unsigned top_k = 1;
-  constexpr int axis = 1;
-  constexpr bool largest = true;
-  constexpr bool sorted = false;
-
-  Tensor topk_scores;
-  Tensor topk_indices;
-  ORT_RETURN_IF_ERROR(TopK(&input,
-                           axis,
-                           top_k,
-                           largest,
-                           sorted,
-                           allocator,
-                           stream,
-                           thread_pool,
-                           topk_scores,
-                           topk_indices));
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("topk_scores", topk_scores);
-  dumper->Print("topk_indices", topk_indices);
-#endif
-
-  gsl::span<const int64_t> next_token_indices = topk_indices.DataAsSpan<int64_t>();
-  for (size_t i = 0; i < next_token_indices.size(); i++) {
-    greedy_state->next_tokens[i] = gsl::narrow_cast<int32_t>(next_token_indices[i]);
-  }
+  // next_tokens = torch.argmax(scores, dim=-1). Like TopK with k = 1, the first index of the maximum is selected.
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, batch_size,
+      TensorOpCost{static_cast<double>(vocab_size) * sizeof(T), sizeof(int32_t), static_cast<double>(vocab_size)},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; i++) {
+          const T* row = next_token_scores.data() + SafeInt<size_t>(i) * vocab_size;
+          greedy_state->next_tokens[i] = gsl::narrow_cast<int32_t>(std::max_element(row, row + vocab_size) - row);
+        }
+      });
 
 #ifdef DEBUG_GENERATION
   gsl::span<const int32_t> next_tokens(greedy_state->next_tokens.data(),
                                        greedy_state->next_tokens.size());
-  dumper->Print("next_tokens before scorer", next_tokens.data(), batch_size, top_k);
+  dumper->Print("next_tokens before scorer", next_tokens.data(), batch_size, 1);
 #endif
 
   return Status::OK();
@@ -619,8 +595,6 @@ Status UpdateGptFeeds(
   // next_inputs: input_ids, position_id, attention_mask, past_0, past_1
   ORT_UNUSED_PARAMETER(stream);
   ORT_UNUSED_PARAMETER(beam_indices_gpu);
-  ORT_UNUSED_PARAMETER(input_sequence_len);
-  ORT_UNUSED_PARAMETER(need_cache_indir);
 
   // The following updates inputs for subgraph
 
@@ -664,8 +638,45 @@ Status UpdateGptFeeds(
   next_inputs[2] = attention_mask;
 
   if (past_present_share_buffer) {
-    int32_t* past_seq_len_data = const_cast<int32_t*>(next_inputs.back().Get<Tensor>().Data<int32_t>());
-    *past_seq_len_data = past_sequence_len;
+    // Past sequence length feed comes right after the past state feeds.
+    const ptrdiff_t past_sequence_length_idx =
+        (static_cast<ptrdiff_t>(last_outputs.size()) - gpt_subgraph_first_present_output_idx) +
+        gpt_subgraph_first_past_input_idx;
+    *(next_inputs[past_sequence_length_idx].GetMutable<Tensor>()->MutableData<int32_t>()) = past_sequence_len;
+
+    // DecoderMaskedMultiHeadAttention reads the past state of each beam through the cache indirection
+    // (batch_size, num_beams, max_sequence_length), so beam reordering only updates this table instead of
+    // copying the past state of every layer.
+    if (need_cache_indir) {
+      ORT_ENFORCE(!beam_indices_cpu.empty(),
+                  "Beam indices must be present while using DecoderMaskedMultiHeadAttention with BeamSearch");
+
+      // The cache indirection feed comes 2 feeds after the `past_sequence_length` feed
+      const Tensor& old_cache_indirection = next_inputs[past_sequence_length_idx + 2].Get<Tensor>();
+      OrtValue cache_indirection;
+      Tensor::InitOrtValue(int32_type, old_cache_indirection.Shape(), allocator, cache_indirection);
+
+      const int max_sequence_length = static_cast<int>(old_cache_indirection.Shape()[2]);
+      const int32_t* source = old_cache_indirection.Data<int32_t>();
+      int32_t* target = cache_indirection.GetMutable<Tensor>()->MutableData<int32_t>();
+      for (int i = 0; i < batch_beam_size; i++) {
+        const int batch_id = i / num_beams;
+        const int beam_id = i % num_beams;
+        const int src_beam = beam_indices_cpu[i] % num_beams;
+        int32_t* target_row = target + static_cast<ptrdiff_t>(i) * max_sequence_length;
+        const int32_t* source_row = source + (static_cast<ptrdiff_t>(batch_id) * num_beams + src_beam) * max_sequence_length;
+
+        // Input tokens are shared by all beams, so they come from beam 0. The newly generated token
+        // is in the current beam, and the other tokens follow the beam that the current beam came from.
+        const int shared_length = std::min(input_sequence_len, current_length - 1);
+        std::fill_n(target_row, shared_length, 0);
+        std::copy(source_row + shared_length, source_row + current_length - 1, target_row + shared_length);
+        target_row[current_length - 1] = beam_id;
+      }
+
+      next_inputs[past_sequence_length_idx + 2] = cache_indirection;
+    }
+
     return Status::OK();
   }
 
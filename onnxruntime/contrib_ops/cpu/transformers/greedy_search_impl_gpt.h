@@ -23,6 +23,27 @@ std::pair<Status, std::unique_ptr<GptSubgraph>> CreateGptSubgraphAndUpdateParame
     /*out*/ BeamSearchParameters& parameters);
 }  // namespace gpt_details
 
+// Prompt lookup: propose up to max_tokens tokens that followed the most recent earlier occurrence of the
+// last n-gram of the sequence. Longer n-grams are tried first. draft_tokens is empty when nothing matches.
+inline void LookupDraftTokens(gsl::span<const int32_t> sequence,
+                              int max_tokens,
+                              std::vector<int32_t>& draft_tokens) {
+  constexpr int kMaxNgramSize = 3;
+  draft_tokens.clear();
+  const int length = static_cast<int>(sequence.size());
+  for (int n = std::min(kMaxNgramSize, length - 1); n >= 1; --n) {
+    auto suffix = sequence.subspan(static_cast<size_t>(length) - n);
+    for (int start = length - n - 1; start >= 0; --start) {
+      if (std::equal(suffix.begin(), suffix.end(), sequence.begin() + start)) {
+        const int end = start + n;
+        const int count = std::min(max_tokens, length - end);
+        draft_tokens.assign(sequence.begin() + end, sequence.begin() + end + count);
+        return;
+      }
+    }
+  }
+}
+
 // Greedy search implementation for GPT-2 model.
 template <typename T, typename ParametersT>
 class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
@@ -101,6 +122,16 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Update the input for next iteration of speculative decoding: feed the last generated token followed by
+  // draft_tokens, and drop the rejected draft tokens from the present state so that the past state covers
+  // exactly current_length - 1 tokens.
+  Status UpdateSpeculativeFeeds(const std::vector<OrtValue>& last_outputs,
+                                std::vector<OrtValue>& next_inputs,
+                                int current_length,
+                                int position,
+                                int32_t last_token,
+                                gsl::span<const int32_t> draft_tokens);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
@@ -187,6 +218,79 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             false);
 }
 
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::UpdateSpeculativeFeeds(
+    const std::vector<OrtValue>& last_outputs,
+    std::vector<OrtValue>& next_inputs,
+    int current_length,
+    int position,
+    int32_t last_token,
+    gsl::span<const int32_t> draft_tokens) {
+  // last_outputs: logits, present_0, present_1, ...
+  // next_inputs: input_ids, position_id, attention_mask, past_0, past_1
+  const int input_length = 1 + static_cast<int>(draft_tokens.size());
+  const int total_length = current_length - 1 + input_length;
+  auto int32_type = DataTypeImpl::GetType<int32_t>();
+
+  OrtValue input_ids;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, input_length}), this->temp_space_allocator_, input_ids);
+  int32_t* input_ids_data = input_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  input_ids_data[0] = last_token;
+  std::copy(draft_tokens.begin(), draft_tokens.end(), input_ids_data + 1);
+  next_inputs[0] = input_ids;
+
+  OrtValue position_ids;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, input_length}), this->temp_space_allocator_, position_ids);
+  int32_t* position_data = position_ids.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (int i = 0; i < input_length; i++) {
+    position_data[i] = position + i;
+  }
+  next_inputs[1] = position_ids;
+
+  // Keep the mask of accepted tokens. Rejected draft tokens and new tokens are all attended.
+  const Tensor& old_mask = next_inputs[2].Get<Tensor>();
+  const int64_t kept_mask_length = std::min<int64_t>(old_mask.Shape()[1], current_length - 1);
+  OrtValue attention_mask;
+  Tensor::InitOrtValue(int32_type, TensorShape({1, total_length}), this->temp_space_allocator_, attention_mask);
+  int32_t* mask_data = attention_mask.GetMutable<Tensor>()->MutableData<int32_t>();
+  std::copy_n(old_mask.Data<int32_t>(), kept_mask_length, mask_data);
+  std::fill(mask_data + kept_mask_length, mask_data + total_length, 1);
+  next_inputs[2] = attention_mask;
+
+  // Present state has shape (2, 1, num_heads, cache_length, head_size), where cache_length includes the draft
+  // tokens fed in the last run. Rejected tokens are at the end, so roll back by copying the leading part.
+  const int past_length = current_length - 1;
+  const int offset = gpt_subgraph_.GetFirstPastInputIndex() - gpt_subgraph_.GetFirstPresentOutputIndex();
+  for (size_t i = gpt_subgraph_.GetFirstPresentOutputIndex(); i < last_outputs.size(); ++i) {
+    const Tensor& present = last_outputs[i].Get<Tensor>();
+    const TensorShape& present_shape = present.Shape();
+    const int64_t cache_length = present_shape[3];
+    ORT_RETURN_IF(cache_length < past_length, "Present state has ", cache_length,
+                  " tokens, expected at least ", past_length);
+    if (cache_length == past_length) {
+      next_inputs[i + offset] = last_outputs[i];
+      continue;
+    }
+
+    const int64_t num_blocks = present_shape[0] * present_shape[1] * present_shape[2];
+    const size_t row_bytes = SafeInt<size_t>(present_shape[4]) * present.DataType()->Size();
+    const size_t past_block_bytes = SafeInt<size_t>(past_length) * row_bytes;
+    const size_t cache_block_bytes = SafeInt<size_t>(cache_length) * row_bytes;
+    OrtValue past;
+    Tensor::InitOrtValue(present.DataType(),
+                         TensorShape({present_shape[0], present_shape[1], present_shape[2], past_length, present_shape[4]}),
+                         this->temp_space_allocator_, past);
+    const auto* source = static_cast<const uint8_t*>(present.DataRaw());
+    auto* target = static_cast<uint8_t*>(past.GetMutable<Tensor>()->MutableDataRaw());
+    for (size_t block = 0; block < static_cast<size_t>(num_blocks); block++) {
+      memcpy(target + block * past_block_bytes, source + block * cache_block_bytes, past_block_bytes);
+    }
+    next_inputs[i + offset] = past;
+  }
+
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
@@ -268,6 +372,23 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
+  // Speculative decoding proposes tokens by prompt lookup and verifies them in a single decoder run. Rejected tokens
+  // are rolled back by slicing the present state, which needs a separate present per run, so shared past/present
+  // buffer is not supported. Verification reads the logits of every input position on host, and the rollback
+  // assumes a single sequence.
+  const bool use_speculation = parameters->num_speculative_tokens > 0 &&
+                               std::is_same<ParametersT, GreedySearchParameters>::value;
+  if (use_speculation &&
+      (this->IsCuda() || parameters->BatchBeamSize() != 1 || gpt_subgraph_.past_present_share_buffer_)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "num_speculative_tokens is only supported by the CPU GPT-2 implementation with batch_size 1 "
+                           "and without past_present_share_buffer");
+  }
+  std::vector<int32_t> draft_tokens;
+  // Logits of one verified position. The fetched logits are not modified in place.
+  std::vector<T> position_logits_buffer;
+  int next_position = greedy_state.next_positions[0];
+
   int current_length = parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
@@ -315,12 +436,45 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     const OrtValue& logits = fetches[0];
     gsl::span<int32_t> next_tokens;
 
-    ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
-                                                next_tokens,
-                                                greedy_state,
-                                                sampling_state,
-                                                iteration_counter,
-                                                parameters->eos_token_id));
+    if (draft_tokens.empty()) {
+      ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
+                                                  next_tokens,
+                                                  greedy_state,
+                                                  sampling_state,
+                                                  iteration_counter,
+                                                  parameters->eos_token_id));
+    } else {
+      // Logits of the last draft_tokens.size() + 1 positions predict the token after the last generated token and
+      // after each draft token. Accept draft tokens while they equal the generated token.
+      const Tensor& logits_tensor = logits.Get<Tensor>();
+      const int64_t input_length = logits_tensor.Shape()[1];
+      const int vocab_size = parameters->vocab_size;
+      const T* logits_data = logits_tensor.Data<T>();
+      position_logits_buffer.resize(static_cast<size_t>(vocab_size));
+      size_t num_accepted = 0;
+      while (true) {
+        const T* source = logits_data + (input_length - static_cast<int64_t>(draft_tokens.size()) - 1 +
+                                         static_cast<int64_t>(num_accepted)) *
+                                            vocab_size;
+        std::copy(source, source + vocab_size, position_logits_buffer.begin());
+        OrtValue position_logits;
+        Tensor::InitOrtValue(logits_tensor.DataType(), TensorShape({1, 1, vocab_size}),
+                             position_logits_buffer.data(), logits_tensor.Location(), position_logits);
+        ORT_RETURN_IF_ERROR(this->GenerateNextToken(position_logits,
+                                                    next_tokens,
+                                                    greedy_state,
+                                                    sampling_state,
+                                                    iteration_counter,
+                                                    parameters->eos_token_id));
+        if (greedy_state.eos_meet[0] || num_accepted == draft_tokens.size() ||
+            next_tokens[0] != draft_tokens[num_accepted]) {
+          break;
+        }
+        ++current_length;
+        ++num_accepted;
+      }
+      next_position += static_cast<int>(num_accepted);
+    }
 
     // When all batches are finished, stop earlier to avoid wasting computation.
     gsl::span<bool>& eos_meet = greedy_state.eos_meet;
@@ -361,10 +515,23 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
-      ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
-                                      position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
-                                      current_length - 1));
+      if (use_speculation) {
+        if (increase_position) {
+          ++next_position;
+        }
+
+        // Leave room for the token generated after the last accepted draft token.
+        LookupDraftTokens(greedy_state.sequences.GetSequence(0),
+                          std::min(parameters->num_speculative_tokens, parameters->max_length - current_length - 1),
+                          draft_tokens);
+        ORT_RETURN_IF_ERROR(UpdateSpeculativeFeeds(fetches, feeds, current_length, next_position,
+                                                   next_tokens[0], draft_tokens));
+      } else {
+        ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
+                                        position_ids, increase_position,
+                                        ReinterpretAsSpan<const int32_t>(next_tokens),
+                                        current_length - 1));
+      }
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
       // clear fetched values before presents[]
@@ -16,6 +16,9 @@ struct GreedySearchParameters : public BeamSearchParameters {
   void ParseFromAttributes(const OpKernelInfo& info) override;
 
   void ParseFromInputs(OpKernelContext* context);
+
+  // Maximum number of tokens drafted by prompt lookup and verified in one decoder run. 0 disables speculation.
+  int num_speculative_tokens = 0;
 };
 
 }  // namespace transformers
@@ -6,6 +6,7 @@
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/common/span_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/cpu/math/softmax_shared.h"
 #include "contrib_ops/cpu/transformers/logits_processor.h"
 #include "contrib_ops/cpu/utils/dump_tensor.h"
@@ -200,15 +201,87 @@ void LogitsProcessorList::Init(const SamplingParameters& parameters) {
   LogitsProcessorInitImpl<SamplingParameters>(parameters);
 }
 
+void LogitsProcessorList::ProcessRow(const ISequences* sequences,
+                                     gsl::span<float> scores,
+                                     int batch_beam_index,
+                                     bool apply_prefix_vocab_mask,
+                                     bool apply_min_length) const {
+  constexpr float lowest = std::numeric_limits<float>::lowest();
+  gsl::span<const int32_t> sequence = sequences->GetSequence(batch_beam_index);
+
+  // Repetition penalty only touches the tokens in the sequence.
+  if (repetition_penalty_ != 1.0f) {
+    InlinedVector<int32_t> word_ids(sequence.begin(), sequence.end());
+    std::sort(word_ids.begin(), word_ids.end());
+    word_ids.erase(std::unique(word_ids.begin(), word_ids.end()), word_ids.end());
+    for (const int32_t word_id : word_ids) {
+      const float score = scores[word_id];
+      scores[word_id] = (score < 0 ? score * repetition_penalty_ : score / repetition_penalty_);
+    }
+  }
+
+  // Block the last word of every ngram whose prefix matches the end of the sequence.
+  if (no_repeat_ngram_size_ > 0 && no_repeat_ngram_size_ <= static_cast<int>(sequence.size())) {
+    const gsl::index prefix_length = static_cast<gsl::index>(no_repeat_ngram_size_) - 1;
+    gsl::span<const int32_t> prefix = sequence.subspan(sequence.size() - prefix_length);
+    for (int j = 0; j <= static_cast<int>(sequence.size()) - no_repeat_ngram_size_; j++) {
+      if (no_repeat_ngram_size_ == 1 || SpanEq(prefix, sequence.subspan(j, prefix_length))) {
+        scores[sequence[static_cast<gsl::index>(j) + prefix_length]] = lowest;
+      }
+    }
+  }
+
+  if (apply_min_length) {
+    scores[eos_token_id_] = lowest;
+  }
+
+  // Vocabulary masks and temperature in one sweep over the row.
+  const int32_t* vocab_mask = vocab_mask_.empty() ? nullptr : vocab_mask_.data();
+  const int32_t* prefix_vocab_mask =
+      apply_prefix_vocab_mask
+          ? prefix_vocab_mask_.data() + SafeInt<size_t>(batch_beam_index / num_beams_) * vocab_size_
+          : nullptr;
+  if (vocab_mask == nullptr && prefix_vocab_mask == nullptr && temperature_ == 1.0f) {
+    return;
+  }
+
+  float* p = scores.data();
+  const float temperature = temperature_;
+  for (int j = 0; j < vocab_size_; j++) {
+    const bool masked = (vocab_mask != nullptr && vocab_mask[j] == 0) ||
+                        (prefix_vocab_mask != nullptr && prefix_vocab_mask[j] == 0);
+    p[j] = (masked ? lowest : p[j]) / temperature;
+  }
+}
+
 void LogitsProcessorList::Process(const ISequences* sequences,
                                   gsl::span<float>& next_token_scores,
-                                  int step) {
+                                  int step,
+                                  onnxruntime::concurrency::ThreadPool* thread_pool) {
+  // Prefix vocab mask is applied to first iteration only.
+  const bool apply_prefix_vocab_mask = !prefix_vocab_mask_.empty() && step <= 1;
+  const bool apply_min_length = min_length_ > 0 && sequences->GetSequenceLength() < min_length_;
+  const bool has_sequence_processors = repetition_penalty_ != 1.0f || no_repeat_ngram_size_ > 0;
+  if (has_sequence_processors || apply_min_length || apply_prefix_vocab_mask || !vocab_mask_.empty() ||
+      temperature_ != 1.0f) {
+    const double sequence_length = static_cast<double>(sequences->GetSequenceLength());
+    const double vocab_size = static_cast<double>(vocab_size_);
+    const TensorOpCost cost{vocab_size * sizeof(float) + sequence_length * sizeof(int32_t),
+                            vocab_size * sizeof(float),
+                            vocab_size + (has_sequence_processors ? sequence_length * no_repeat_ngram_size_ : 0.0)};
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, batch_beam_size_, cost,
+        [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i < end; i++) {
+            ProcessRow(sequences,
+                       next_token_scores.subspan(SafeInt<size_t>(i) * vocab_size_, static_cast<size_t>(vocab_size_)),
+                       static_cast<int>(i), apply_prefix_vocab_mask, apply_min_length);
+          }
+        });
+  }
+
   NextTokenScores<float> input_scores = {next_token_scores, batch_beam_size_, vocab_size_};
   for (size_t i = 0; i < processor_list_.size(); i++) {
-    // Prefix vocab mask is applied to first iteration only.
-    if (step > 1 && processor_list_[i] == prefix_vocab_mask_processor_.get()) {
-      continue;
-    }
     processor_list_[i]->Process(sequences, input_scores);
   }
 }
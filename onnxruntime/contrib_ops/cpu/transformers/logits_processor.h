@@ -293,53 +293,37 @@ class TimestampLogitsProcessor : public ILogitsProcessor<T> {
   int max_initial_timestamp_index_;
 };
 
+// Applies the logits processors enabled by the generation parameters.
+// Repetition penalty, no repeat ngram, vocabulary masks, min length and temperature only depend on the row
+// (sequence) they update, so they are fused into a single pass per row that runs in parallel across rows.
+// They produce the same scores as applying the corresponding ILogitsProcessor one after another.
+// Presence penalty and timestamp processors are applied afterwards as separate processors.
 class LogitsProcessorList : public ILogitsProcessorList {
  public:
   LogitsProcessorList() = default;
   void Init(const BeamSearchParameters& parameters);
   void Init(const GreedySearchParameters& parameters);
   void Init(const SamplingParameters& parameters);
-  void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step);
+  void Process(const ISequences* sequences, gsl::span<float>& next_token_scores, int step,
+               onnxruntime::concurrency::ThreadPool* thread_pool) override;
 
  private:
+  // Apply the fused processors to the scores of one row.
+  void ProcessRow(const ISequences* sequences, gsl::span<float> scores, int batch_beam_index,
+                  bool apply_prefix_vocab_mask, bool apply_min_length) const;
+
   template <typename GenerationParametersT>
   void LogitsProcessorInitImpl(const GenerationParametersT& parameters) {
     processor_list_.clear();
 
-    if (parameters.repetition_penalty != 1.0f) {  // 1.0 means no penalty
-      repetition_penalty_processor_ = std::make_unique<RepetitionPenaltyLogitsProcessor<float>>(
-          parameters.repetition_penalty);
-      processor_list_.push_back(repetition_penalty_processor_.get());
-    }
-
-    if (parameters.no_repeat_ngram_size > 0) {
-      no_repeat_ngram_processor_ = std::make_unique<
-          NoRepeatNGramLogitsProcessor<float>>(parameters.no_repeat_ngram_size);
-      processor_list_.push_back(no_repeat_ngram_processor_.get());
-    }
-
-    if (!parameters.vocab_mask.empty()) {
-      vocab_mask_processor_ = std::make_unique<VocabMaskLogitsProcessor<float>>(parameters.vocab_mask);
-      processor_list_.push_back(vocab_mask_processor_.get());
-    }
-
-    if (!parameters.prefix_vocab_mask.empty()) {
-      prefix_vocab_mask_processor_ = std::make_unique<
-          PrefixVocabMaskLogitsProcessor<float>>(parameters.prefix_vocab_mask,
-                                                 parameters.batch_size);
-      processor_list_.push_back(prefix_vocab_mask_processor_.get());
-    }
-
-    if (parameters.min_length > 0) {
-      min_length_processor_ = std::make_unique<MinLengthLogitsProcessor<float>>(parameters.min_length,
-                                                                                parameters.eos_token_id);
-      processor_list_.push_back(min_length_processor_.get());
-    }
-
-    if (parameters.temperature > 0) {
-      temperature_processor_ = std::make_unique<TemperatureLogitsProcessor<float>>(parameters.temperature);
-      processor_list_.push_back(temperature_processor_.get());
-    }
+    repetition_penalty_ = parameters.repetition_penalty;  // 1.0 means no penalty
+    no_repeat_ngram_size_ = parameters.no_repeat_ngram_size;
+    vocab_mask_ = parameters.vocab_mask;
+    prefix_vocab_mask_ = parameters.prefix_vocab_mask;
+    num_beams_ = parameters.BatchBeamSize() / parameters.batch_size;
+    min_length_ = parameters.min_length;
+    eos_token_id_ = parameters.eos_token_id;
+    temperature_ = parameters.temperature > 0 ? parameters.temperature : 1.0f;  // 1.0 means no scaling
 
     if (!parameters.presence_mask.empty()) {
       presence_penalty_processor_ = std::make_unique<
@@ -369,14 +353,20 @@ class LogitsProcessorList : public ILogitsProcessorList {
 
   int batch_beam_size_;
   int vocab_size_;
+
+  // Parameters of the fused processors.
+  float repetition_penalty_ = 1.0f;
+  int no_repeat_ngram_size_ = 0;
+  gsl::span<const int32_t> vocab_mask_;
+  gsl::span<const int32_t> prefix_vocab_mask_;
+  int num_beams_ = 1;
+  int min_length_ = 0;
+  int eos_token_id_ = -1;
+  float temperature_ = 1.0f;
+
+  // Processors applied after the fused ones.
   InlinedVector<ILogitsProcessor<float>*> processor_list_;
 
-  std::unique_ptr<RepetitionPenaltyLogitsProcessor<float>> repetition_penalty_processor_;
-  std::unique_ptr<NoRepeatNGramLogitsProcessor<float>> no_repeat_ngram_processor_;
-  std::unique_ptr<VocabMaskLogitsProcessor<float>> vocab_mask_processor_;
-  std::unique_ptr<PrefixVocabMaskLogitsProcessor<float>> prefix_vocab_mask_processor_;
-  std::unique_ptr<MinLengthLogitsProcessor<float>> min_length_processor_;
-  std::unique_ptr<TemperatureLogitsProcessor<float>> temperature_processor_;
   std::unique_ptr<PresencePenaltyLogitsProcessor<float>> presence_penalty_processor_;
   std::unique_ptr<TimestampLogitsProcessor<float>> timestamp_processor_;
 };
@@ -496,13 +496,34 @@ std::string ThreadPool::StopProfiling() {
 
 namespace {
 thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
-}
+
+// The pool whose parallel loop the current thread is running work for, or nullptr. Loops and parallel sections
+// started from inside a loop run in the calling thread, as the pool's threads are already busy with the outer loop.
+thread_local const ThreadPool* current_parallel_loop_pool = nullptr;
+
+class ParallelLoopScope {
+ public:
+  explicit ParallelLoopScope(const ThreadPool* tp) : previous_(current_parallel_loop_pool) {
+    current_parallel_loop_pool = tp;
+  }
+
+  ~ParallelLoopScope() {
+    current_parallel_loop_pool = previous_;
+  }
+
+ private:
+  const ThreadPool* previous_;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ParallelLoopScope);
+};
+}  // namespace
 
 ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
-  ORT_ENFORCE(!current_parallel_section.has_value(), "Nested parallelism not supported");
   ORT_ENFORCE(!ps_);
   tp_ = tp;
-  if (tp && tp->underlying_threadpool_) {
+  // a nested section, or a section inside a parallel loop, has no effect. loops in it use the outer section, or
+  // run in the calling thread.
+  if (tp && tp->underlying_threadpool_ && !current_parallel_section.has_value() &&
+      current_parallel_loop_pool != tp) {
     current_parallel_section.emplace();
     ps_ = &*current_parallel_section;
     tp_->underlying_threadpool_->StartParallelSection(*ps_);
@@ -510,20 +531,26 @@ ThreadPool::ParallelSection::ParallelSection(ThreadPool* tp) {
 }
 
 ThreadPool::ParallelSection::~ParallelSection() {
-  if (current_parallel_section) {
+  if (ps_) {
     tp_->underlying_threadpool_->EndParallelSection(*ps_);
     current_parallel_section.reset();
   }
 }
 
 void ThreadPool::RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t block_size) {
-  if (underlying_threadpool_) {
+  if (underlying_threadpool_ && current_parallel_loop_pool != this) {
+    // the work items claim iterations until the loop is done, so a nested loop is complete after running fn(0).
+    std::function<void(unsigned idx)> loop_fn = [this, &fn](unsigned idx) {
+      ParallelLoopScope scope(this);
+      fn(idx);
+    };
+
     if (current_parallel_section.has_value()) {
       underlying_threadpool_->RunInParallelSection(*current_parallel_section,
-                                                   std::move(fn),
+                                                   std::move(loop_fn),
                                                    n, block_size);
     } else {
-      underlying_threadpool_->RunInParallel(std::move(fn),
+      underlying_threadpool_->RunInParallel(std::move(loop_fn),
                                             n, block_size);
     }
   } else {
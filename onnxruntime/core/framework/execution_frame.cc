@@ -357,7 +357,9 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
       device_streams_(device_streams),
 #endif
       session_state_(session_state),
-      mem_patterns_(nullptr) {
+      mem_patterns_(nullptr),
+      recycle_pattern_buffers_(session_state.GetGraphViewer().IsSubgraph() &&
+                               session_state.GetEnableMemoryPatternBufferPool()) {
   Init(
       feed_mlvalue_idxs, feeds, session_state.GetInitializedTensors(),
 #if !defined(DISABLE_SPARSE_TENSORS)
@@ -449,10 +451,10 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
                   stream_aware_alloc->SecureTheChunk(mem_pattern_stream, device_streams_->GetStream(j), nullptr);
                 }
               } else {
-                buffer = alloc->Alloc(peak_size);
+                buffer = AllocateMemoryPatternBuffer(alloc, location, peak_size);
               }
 #else
-              buffer = alloc->Alloc(peak_size);
+              buffer = AllocateMemoryPatternBuffer(alloc, location, peak_size);
 #endif
               // handle allocator that doesn't throw
               if (buffer == nullptr) {
@@ -492,7 +494,33 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
   }
 }
 
-ExecutionFrame::~ExecutionFrame() = default;
+ExecutionFrame::~ExecutionFrame() {
+  // hand the memory pattern buffers back to the SessionState so the next execution of the subgraph can use them.
+  // nothing allocated from these buffers outlives the frame as graph outputs are never part of the memory pattern.
+  if (recycle_pattern_buffers_ && mem_patterns_) {
+    for (size_t i = 0; i < mem_patterns_->locations.size(); i++) {
+      const auto& location = mem_patterns_->locations[i];
+      auto it = buffers_.find(location);
+      if (location.Type() == OrtDevice::CPU && it != buffers_.end() && it->second) {
+        session_state_.RecycleMemoryPatternBuffer(location, mem_patterns_->patterns[i].PeakSize(),
+                                                  std::move(it->second));
+      }
+    }
+  }
+}
+
+void* ExecutionFrame::AllocateMemoryPatternBuffer(const AllocatorPtr& alloc, const OrtDevice& location, size_t size) {
+  // control flow subgraphs are typically executed many times with the same input shapes (e.g. an If node in a loop),
+  // so re-use a buffer released by a previous execution instead of going through the allocator each time.
+  if (recycle_pattern_buffers_ && location.Type() == OrtDevice::CPU) {
+    void* buffer = session_state_.AcquireMemoryPatternBuffer(location, size);
+    if (buffer != nullptr) {
+      return buffer;
+    }
+  }
+
+  return alloc->Alloc(size);
+}
 
 Status ExecutionFrame::CopyTensor(const Tensor& src, Tensor& dest) const {
   return session_state_.GetDataTransferMgr().CopyTensor(src, dest);
@@ -231,6 +231,9 @@ class ExecutionFrame final : public IExecutionFrame {
 
   Stream* GetValueStream(int ort_value_idx) const;
 
+  // allocate the buffer for a memory pattern, re-using one from a previous execution if possible
+  void* AllocateMemoryPatternBuffer(const AllocatorPtr& alloc, const OrtDevice& location, size_t size);
+
 #ifdef ORT_ENABLE_STREAM
   const DeviceStreamCollection* device_streams_;
 #endif
@@ -245,6 +248,10 @@ class ExecutionFrame final : public IExecutionFrame {
   // kernel's input/output tensors.
   const MemoryPatternGroup* mem_patterns_;
 
+  // true if the memory pattern buffers are returned to the SessionState for re-use when the frame is destroyed.
+  // only done for subgraphs as they are executed repeatedly by their control flow node.
+  const bool recycle_pattern_buffers_;
+
   // If no cached memory pattern, and we enable the memory pattern optimization
   // use this planner_ to trace the memory allocation in current executor.
   std::optional<OrtValuePatternPlanner> planner_;
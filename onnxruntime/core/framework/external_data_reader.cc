@@ -0,0 +1,80 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/external_data_reader.h"
+
+#include <algorithm>
+#include <exception>
+
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+
+void ExternalDataReader::Add(const std::basic_string<ORTCHAR_T>& file_path, FileOffsetType offset, size_t length,
+                             void* buffer) {
+  if (length == 0) {
+    return;
+  }
+
+  requests_.push_back(Request{file_path, offset, length, buffer});
+}
+
+Status ExternalDataReader::Read(concurrency::ThreadPool* thread_pool) {
+  if (requests_.empty()) {
+    return Status::OK();
+  }
+
+  std::sort(requests_.begin(), requests_.end(), [](const Request& lhs, const Request& rhs) {
+    return lhs.file_path != rhs.file_path ? lhs.file_path < rhs.file_path : lhs.offset < rhs.offset;
+  });
+
+  // task i reads requests_[task_starts[i], task_starts[i + 1])
+  std::vector<size_t> task_starts;
+  size_t task_bytes = 0;
+  for (size_t i = 0; i < requests_.size(); ++i) {
+    if (task_starts.empty() || task_bytes >= max_bytes_per_task_ ||
+        requests_[i].file_path != requests_[i - 1].file_path) {
+      task_starts.push_back(i);
+      task_bytes = 0;
+    }
+    task_bytes += requests_[i].length;
+  }
+  task_starts.push_back(requests_.size());
+
+  const size_t num_tasks = task_starts.size() - 1;
+  std::vector<Status> task_status(num_tasks);
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(num_tasks),
+      [&](std::ptrdiff_t task) {
+        ORT_TRY {
+          // all the requests of a task are in the same file, which is opened once for them
+          const size_t begin = task_starts[task];
+          const size_t end = task_starts[task + 1];
+          std::vector<FileOffsetType> offsets;
+          std::vector<gsl::span<char>> buffers;
+          offsets.reserve(end - begin);
+          buffers.reserve(end - begin);
+          for (size_t i = begin; i < end; ++i) {
+            offsets.push_back(requests_[i].offset);
+            buffers.push_back(gsl::make_span(static_cast<char*>(requests_[i].buffer), requests_[i].length));
+          }
+
+          task_status[task] = env_.ReadFileIntoBuffers(requests_[begin].file_path.c_str(), offsets, buffers);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            task_status[task] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+          });
+        }
+      });
+
+  requests_.clear();
+
+  for (const auto& status : task_status) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
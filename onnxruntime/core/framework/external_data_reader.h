@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+namespace concurrency {
+class ThreadPool;
+}
+
+/**
+Reads the external data of many tensors into their destination buffers.
+
+The ranges are grouped by file and sorted by offset. Consecutive ranges of a file are read by the same task until the
+task holds at least max_bytes_per_task, and the tasks run in parallel on the thread pool. Each task opens its file
+once, and ranges that are adjacent in the file are read together (see Env::ReadFileIntoBuffers). The device then
+serves a few large sequential streams at the same time instead of one small read at a time.
+*/
+class ExternalDataReader {
+ public:
+  static constexpr size_t kDefaultMaxBytesPerTask = 64 * 1024 * 1024;
+
+  explicit ExternalDataReader(const Env& env, size_t max_bytes_per_task = kDefaultMaxBytesPerTask)
+      : env_(env), max_bytes_per_task_(max_bytes_per_task) {}
+
+  // Adds a read of 'length' bytes at 'offset' in 'file_path' into 'buffer', which must stay valid until Read returns.
+  void Add(const std::basic_string<ORTCHAR_T>& file_path, FileOffsetType offset, size_t length, void* buffer);
+
+  // Reads all the ranges added so far, in parallel if thread_pool is not null. Returns the first failure.
+  Status Read(concurrency::ThreadPool* thread_pool);
+
+  size_t NumRequests() const { return requests_.size(); }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ExternalDataReader);
+
+  struct Request {
+    std::basic_string<ORTCHAR_T> file_path;
+    FileOffsetType offset;
+    size_t length;
+    void* buffer;
+  };
+
+  const Env& env_;
+  const size_t max_bytes_per_task_;
+  std::vector<Request> requests_;
+};
+
+}  // namespace onnxruntime
@@ -90,6 +90,9 @@ SessionState::SessionState(Graph& graph,
 {
   enable_mem_pattern_ = sess_options_.enable_mem_pattern &&
                         sess_options_.execution_mode == ExecutionMode::ORT_SEQUENTIAL;
+  enable_mem_pattern_buffer_pool_ =
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableSubgraphMemoryPatternBufferPool,
+                                                      "0") != "1";
   if (parent_allocators) {
     allocators_ = parent_allocators;
   } else {
@@ -405,202 +408,247 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
 
 Status SessionState::PrepackConstantInitializedTensors(
     InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
-                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
-    for (auto& node : GetGraphViewer().Nodes()) {
-      auto kernel = GetMutableKernel(node.Index());
-      int input_idx = 0;
-      for (auto& input_def : node.InputDefs()) {
-        if (input_def->Exists()) {
-          const std::string& input_name = input_def->Name();
-          SessionState* st = this;
-          auto* prepacked_for_graph = &graph_.GetPrepacked();
-          // subgraph can use the value from outer scope,
-          // so it needs to check if current node uses constant initialized tensor from current and outer graphs
-          do {
-            int ort_value_idx;
-            if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
-              std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
-
-              if (constant_initialized_tensors.count(ort_value_idx)) {
-                bool is_packed = false;
-                const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
-
-                auto iter = initializers_to_share_map.find(input_name);
-                bool is_shared_initializer = (iter != initializers_to_share_map.end());
-
-                // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
-                if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
-                    node.GetExecutionProviderType() == kCpuExecutionProvider) {
-                  // caching of pre-packed weights' turned ON
-
-                  AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
-                  ORT_ENFORCE(allocator_for_caching.get() != nullptr);
-
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
-                  // because other static properties of the node like node attributes could play a role in the
-                  // pre-packed weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  if (is_packed) {
-                    // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
-                    // to be cached if the weight was pre-packed
-                    ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
-                                "The kernel corresponding to the node ", node.Name(),
-                                " doesn't have an implementation that can cache computed pre-packed weights");
-
-                    const auto& op_type = node.OpType();
-
-                    // Sanity check
-                    // TODO: Check if some version of the ONNX IR allows op_type to be empty
-                    ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
-
-                    // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
-                    // that we just got by invoking PrePack() on this kernel.
-
-                    const std::string prepacked_weights_container_key =
-                        GenerateKeyForPrepackedWeightsMap(op_type,
-                                                          weights_to_be_filled_in);
-
-                    bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
-                        prepacked_weights_container_key);
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    concurrency::ThreadPool* thread_pool) {
+  // Kernels may run PrePack concurrently. Everything else below (the initializer maps, the use counts, the
+  // pre-packed weights containers and the counters) is shared between the nodes and only touched under this mutex.
+  std::mutex prepack_mutex;
+  auto prepack_node = [this, &constant_initializers_use_count, &initializers_to_share_map, &prepack_mutex](
+                          const Node& node, bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    auto kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (auto& input_def : node.InputDefs()) {
+      if (input_def->Exists()) {
+        const std::string& input_name = input_def->Name();
+        SessionState* st = this;
+        auto* prepacked_for_graph = &graph_.GetPrepacked();
+        // subgraph can use the value from outer scope,
+        // so it needs to check if current node uses constant initialized tensor from current and outer graphs
+        do {
+          std::unique_lock<std::mutex> lock(prepack_mutex);
+          int ort_value_idx;
+          if (st->GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+            std::unordered_map<int, OrtValue>& constant_initialized_tensors = st->constant_initialized_tensors_;
+
+            if (constant_initialized_tensors.count(ort_value_idx)) {
+              bool is_packed = false;
+              const Tensor& const_initialized_tensor = constant_initialized_tensors[ort_value_idx].Get<Tensor>();
+
+              auto iter = initializers_to_share_map.find(input_name);
+              bool is_shared_initializer = (iter != initializers_to_share_map.end());
+
+              // Caching pre-packed weights is limited to shared initializers associated with the CPU EP for now
+              if (is_shared_initializer && should_cache_prepacked_weights_for_shared_initializers &&
+                  node.GetExecutionProviderType() == kCpuExecutionProvider) {
+                // caching of pre-packed weights' turned ON
+
+                AllocatorPtr allocator_for_caching = prepacked_weights_container_->GetOrCreateAllocator(CPU);
+                ORT_ENFORCE(allocator_for_caching.get() != nullptr);
+
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed  weight with the pre-packed weight generated by this instance of the same op_type
+                // because other static properties of the node like node attributes could play a role in the
+                // pre-packed weights' contents.
+                lock.unlock();
+                Status prepack_status = kernel->PrePack(const_initialized_tensor, input_idx, allocator_for_caching,
+                                                        is_packed,
+                                                        &weights_to_be_filled_in);
+                lock.lock();
+                ORT_RETURN_IF_ERROR(prepack_status);
 
-                    if (container_contains_packed_weight) {
-                      LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
-                                          << input_name
-                                          << " used in the node: " << node.Name() << " which is of op type: "
-                                          << node.OpType();
-
-                      const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          prepacked_shared,
-                                                                          node.Name()));
-
-                      ++used_shared_pre_packed_weights_counter_;
-
-                      // Write references to what is stored in the shared container
-                      // and release memory mapped entries this container may have loaded from disk
-                      std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
-                                                                                      prepacked_weights_container_key,
-                                                                                      prepacked_shared);
-
-                    } else {
-                      // container doesn't contain the pre-packed weight - so write into it for sharing across
-                      // kernel instances
-
-                      // Check if we loaded it from disk, then put it into the shared container so
-                      // everybody can share the same memory mapped entry
-                      // the shared container takes ownership of the memory mapped entries
-
-                      // The next line replaces the existing entry with references to it
-                      // and returns the container that holds the memory mapped entries
-                      // so we can transfer it to shared container.
-                      // if there is not an entry, we replace it with references to weights_to_be_filled_in
-                      // in saving mode and return std::nullopt
-                      auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
-                          input_name,
-                          prepacked_weights_container_key,
-                          weights_to_be_filled_in);
-
-                      if (prepacked_from_disk.has_value()) {
-                        weights_to_be_filled_in = std::move(*prepacked_from_disk);
-                      }
-
-                      if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
-                                                                     std::move(weights_to_be_filled_in))) {
-                        return ORT_MAKE_STATUS(
-                            ONNXRUNTIME, FAIL,
-                            "Unable to write the provided PrePackedWeights instance into the container");
-                      }
-
-                      const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
-                          prepacked_weights_container_key);
-                      ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                          shared_prepacked,
-                                                                          node.Name()));
-                    }
-                  }
+                if (is_packed) {
+                  // BUG CHECK: Ensure that the kernel has filled in the pre-packed weight
+                  // to be cached if the weight was pre-packed
+                  ORT_ENFORCE(weights_to_be_filled_in.buffers_.size() > 0,
+                              "The kernel corresponding to the node ", node.Name(),
+                              " doesn't have an implementation that can cache computed pre-packed weights");
 
-                } else {
-                  // cross session caching of pre-packed weights' turned OFF
-                  // we use serialization container to share weights loaded from disk
-                  // within this session. Or if the weight is not present on disk,
-                  // we store the newly minted pre-packed data.
-
-                  AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
-                  PrePackedWeights weights_to_be_filled_in;
-                  // The reason we invoke PrePack() before looking into the container for any pre-packed weight
-                  // cached by another instance of the same op_type (for the same constant initializer) is because
-                  // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
-                  // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
-                  // other static properties of the node like node attributes could play a role in the pre-packed
-                  // weights' contents.
-                  ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
-                                                      is_packed,
-                                                      &weights_to_be_filled_in));
-
-                  // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
-                  // even though they set is_packed = true so we leave it up to them.
-                  // We can change their behavior if we wish do so in a separate PR
-                  // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
-                  // produce them.
-                  if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
-                    const auto& op_type = node.OpType();
-                    const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
-                        op_type,
-                        weights_to_be_filled_in);
+                  const auto& op_type = node.OpType();
+
+                  // Sanity check
+                  // TODO: Check if some version of the ONNX IR allows op_type to be empty
+                  ORT_ENFORCE(!op_type.empty(), "The op type of a node cannot be empty");
+
+                  // The key for the pre-packed weights container lookup is the op_type + hash of the prepacked-weight
+                  // that we just got by invoking PrePack() on this kernel.
 
-                    // See if we can use pre-packed data from disk
-                    const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                  const std::string prepacked_weights_container_key =
+                      GenerateKeyForPrepackedWeightsMap(op_type,
+                                                        weights_to_be_filled_in);
+
+                  bool container_contains_packed_weight = prepacked_weights_container_->HasWeight(
+                      prepacked_weights_container_key);
+
+                  if (container_contains_packed_weight) {
+                    LOGS(logger_, INFO) << "Using cached version of pre-packed weight for constant initializer: "
+                                        << input_name
+                                        << " used in the node: " << node.Name() << " which is of op type: "
+                                        << node.OpType();
+
+                    const auto& prepacked_shared = prepacked_weights_container_->GetWeight(
                         prepacked_weights_container_key);
+                    ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                        prepacked_shared,
+                                                                        node.Name()));
+
+                    ++used_shared_pre_packed_weights_counter_;
+
+                    // Write references to what is stored in the shared container
+                    // and release memory mapped entries this container may have loaded from disk
+                    std::ignore = prepacked_for_graph->ReplaceWithReferenceIfSaving(input_name,
+                                                                                    prepacked_weights_container_key,
+                                                                                    prepacked_shared);
+
+                  } else {
+                    // container doesn't contain the pre-packed weight - so write into it for sharing across
+                    // kernel instances
+
+                    // Check if we loaded it from disk, then put it into the shared container so
+                    // everybody can share the same memory mapped entry
+                    // the shared container takes ownership of the memory mapped entries
+
+                    // The next line replaces the existing entry with references to it
+                    // and returns the container that holds the memory mapped entries
+                    // so we can transfer it to shared container.
+                    // if there is not an entry, we replace it with references to weights_to_be_filled_in
+                    // in saving mode and return std::nullopt
+                    auto prepacked_from_disk = prepacked_for_graph->ReplaceWithReferenceIfSaving(
+                        input_name,
+                        prepacked_weights_container_key,
+                        weights_to_be_filled_in);
+
+                    if (prepacked_from_disk.has_value()) {
+                      weights_to_be_filled_in = std::move(*prepacked_from_disk);
+                    }
 
-                    if (weights_to_use == nullptr) {
-                      // In this case pre-packed container owns the data
-                      prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
-                                                                   std::move(weights_to_be_filled_in));
-                      weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
-                      assert(weights_to_use != nullptr);
+                    if (!prepacked_weights_container_->WriteWeight(prepacked_weights_container_key,
+                                                                   std::move(weights_to_be_filled_in))) {
+                      return ORT_MAKE_STATUS(
+                          ONNXRUNTIME, FAIL,
+                          "Unable to write the provided PrePackedWeights instance into the container");
                     }
 
+                    const auto& shared_prepacked = prepacked_weights_container_->GetWeight(
+                        prepacked_weights_container_key);
                     ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
-                                                                        *weights_to_use,
+                                                                        shared_prepacked,
                                                                         node.Name()));
                   }
                 }
 
-                if (is_packed) {
-                  ++number_of_prepacks_counter_;
-
-                  if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
-                    // release the constant initialized tensor
-                    st->initialized_tensors_.erase(ort_value_idx);
-                    constant_initialized_tensors.erase(ort_value_idx);
+              } else {
+                // cross session caching of pre-packed weights' turned OFF
+                // we use serialization container to share weights loaded from disk
+                // within this session. Or if the weight is not present on disk,
+                // we store the newly minted pre-packed data.
+
+                AllocatorPtr session_cpu_alloc = GetAllocator(kernel->Info().GetDevice(OrtMemType::OrtMemTypeDefault));
+                PrePackedWeights weights_to_be_filled_in;
+                // The reason we invoke PrePack() before looking into the container for any pre-packed weight
+                // cached by another instance of the same op_type (for the same constant initializer) is because
+                // to truly know if we can use a cached pre-packed weight, we would have to compare the cached
+                // pre-packed weight with the pre-packed weight generated by this instance of the same op_type because
+                // other static properties of the node like node attributes could play a role in the pre-packed
+                // weights' contents.
+                lock.unlock();
+                Status prepack_status = kernel->PrePack(const_initialized_tensor, input_idx, session_cpu_alloc,
+                                                        is_packed,
+                                                        &weights_to_be_filled_in);
+                lock.lock();
+                ORT_RETURN_IF_ERROR(prepack_status);
+
+                // Some kernels (matmul_nbits and non-CPU related kernels) do not share their pre-packed results
+                // even though they set is_packed = true so we leave it up to them.
+                // We can change their behavior if we wish do so in a separate PR
+                // XXX: Interestingly enough, matmul_nbits does accept shared pre-packs, but does not
+                // produce them.
+                if (is_packed && !weights_to_be_filled_in.buffers_.empty()) {
+                  const auto& op_type = node.OpType();
+                  const std::string prepacked_weights_container_key = GenerateKeyForPrepackedWeightsMap(
+                      op_type,
+                      weights_to_be_filled_in);
+
+                  // See if we can use pre-packed data from disk
+                  const auto* weights_to_use = prepacked_for_graph->GetPrepackedWeights(
+                      prepacked_weights_container_key);
+
+                  if (weights_to_use == nullptr) {
+                    // In this case pre-packed container owns the data
+                    prepacked_for_graph->WritePackedMaybeForSave(input_name, prepacked_weights_container_key,
+                                                                 std::move(weights_to_be_filled_in));
+                    weights_to_use = prepacked_for_graph->GetPrepackedWeights(prepacked_weights_container_key);
+                    assert(weights_to_use != nullptr);
                   }
+
+                  ORT_RETURN_IF_ERROR(KernelUseSharedPrePackedBuffers(*kernel, input_idx,
+                                                                      *weights_to_use,
+                                                                      node.Name()));
                 }
               }
-              // stop searching in 2 cases:
-              // 1. value is not from OuterScope
-              // 2. value is from OuterScope and the current OuterScope has the value
-              if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
-                break;
+
+              if (is_packed) {
+                ++number_of_prepacks_counter_;
+
+                if (constant_initializers_use_count.count(input_name) && --constant_initializers_use_count[input_name] == 0) {
+                  // release the constant initialized tensor
+                  st->initialized_tensors_.erase(ort_value_idx);
+                  constant_initialized_tensors.erase(ort_value_idx);
+                }
               }
             }
-            st = st->Parent();
-            prepacked_for_graph = &st->graph_.GetPrepacked();
-          } while (st);
-        }
-        input_idx++;
+            // stop searching in 2 cases:
+            // 1. value is not from OuterScope
+            // 2. value is from OuterScope and the current OuterScope has the value
+            if (st != this || !st->graph_.IsOuterScopeValue(input_name)) {
+              break;
+            }
+          }
+          st = st->Parent();
+          prepacked_for_graph = &st->graph_.GetPrepacked();
+        } while (st);
       }
+      input_idx++;
+    }
+
+    return Status::OK();
+  };
+
+  auto prepacked_constant_weights = [this, &prepack_node, thread_pool](
+                                        bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
+    if (thread_pool == nullptr) {
+      for (auto& node : GetGraphViewer().Nodes()) {
+        ORT_RETURN_IF_ERROR(prepack_node(node, should_cache_prepacked_weights_for_shared_initializers));
+      }
+      return Status::OK();
+    }
+
+    // the inputs of one kernel are still pre-packed in order, as a kernel may depend on its earlier inputs
+    InlinedVector<const Node*> nodes;
+    for (auto& node : GetGraphViewer().Nodes()) {
+      nodes.push_back(&node);
     }
 
+    std::vector<Status> node_status(nodes.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(nodes.size()),
+        [&](std::ptrdiff_t i) {
+          ORT_TRY {
+            node_status[i] = prepack_node(*nodes[i], should_cache_prepacked_weights_for_shared_initializers);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              node_status[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PrePack failed for node ", nodes[i]->Name(),
+                                               ": ", ex.what());
+            });
+          }
+        });
+
+    for (const auto& status : node_status) {
+      ORT_RETURN_IF_ERROR(status);
+    }
     return Status::OK();
   };
 
@@ -880,9 +928,18 @@ const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
       out_inferred_shapes = &shape_insert.first->second;
       return ptr;
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
 #endif
+    // The symbolic memory pattern gives the pattern for new input shapes right away, instead of the first Run with
+    // these shapes tracing its allocations.
+    if (symbolic_memory_pattern_) {
+      MemoryPatternGroup mem_patterns;
+      const auto status = symbolic_memory_pattern_->Evaluate(tensor_inputs, feed_mlvalue_idxs, mem_patterns);
+      if (status.IsOK()) {
+        return &mem_patterns_.insert_or_assign(key, std::move(mem_patterns)).first->second;
+      }
+
+      LOGS(logger_, VERBOSE) << "[Symbolic memory pattern] " << status.ErrorMessage();
+    }
     return nullptr;
   }
 
@@ -937,6 +994,17 @@ void SessionState::ResolveMemoryPatternFlag() {
       }
     }
   }
+
+  symbolic_memory_pattern_.reset();
+  if (enable_mem_pattern_ && GetExecutionPlan() != nullptr &&
+      sess_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSymbolicMemoryPattern, "0") == "1") {
+    symbolic_memory_pattern_ = SymbolicMemoryPattern::Create(*graph_viewer_, *GetExecutionPlan(),
+                                                             ort_value_name_idx_map_, logger_);
+    if (symbolic_memory_pattern_) {
+      LOGS(logger_, INFO) << "[Symbolic memory pattern] Planned " << symbolic_memory_pattern_->NumTensors()
+                          << " tensors in " << symbolic_memory_pattern_->NumSymbols() << " symbolic dimensions.";
+    }
+  }
 }
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
@@ -949,6 +1017,57 @@ Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> ten
   return Status::OK();
 }
 
+// the number of buffers is bounded by the number of concurrent executions of the subgraph, so a small limit is enough
+// to cover nested control flow and concurrent Run calls without holding on to an unbounded amount of memory.
+static constexpr size_t kMaxPooledMemoryPatternBuffers = 8;
+
+void* SessionState::AcquireMemoryPatternBuffer(const OrtDevice& location, size_t size) const {
+  std::lock_guard<std::mutex> lock(mem_pattern_buffer_pool_mutex_);
+
+  // pick the smallest buffer that is large enough
+  auto best = mem_pattern_buffer_pool_.end();
+  for (auto it = mem_pattern_buffer_pool_.begin(), end = mem_pattern_buffer_pool_.end(); it != end; ++it) {
+    if (it->location == location && it->size >= size && (best == end || it->size < best->size)) {
+      best = it;
+    }
+  }
+
+  if (best == mem_pattern_buffer_pool_.end()) {
+    return nullptr;
+  }
+
+  void* buffer = best->buffer.release();
+  mem_pattern_buffer_pool_.erase(best);
+  return buffer;
+}
+
+void SessionState::RecycleMemoryPatternBuffer(const OrtDevice& location, size_t size, BufferUniquePtr buffer) const {
+  std::lock_guard<std::mutex> lock(mem_pattern_buffer_pool_mutex_);
+  if (buffer && mem_pattern_buffer_pool_.size() < kMaxPooledMemoryPatternBuffers) {
+    mem_pattern_buffer_pool_.push_back({location, size, std::move(buffer)});
+  }
+
+  // otherwise the buffer is freed when it goes out of scope
+}
+
+void SessionState::ReleaseMemoryPatternBuffers() const {
+  {
+    std::lock_guard<std::mutex> lock(mem_pattern_buffer_pool_mutex_);
+    mem_pattern_buffer_pool_.clear();
+  }
+
+  for (const auto& node_to_subgraph_ss : subgraph_session_states_) {
+    for (const auto& attr_name_to_subgraph_ss : node_to_subgraph_ss.second) {
+      attr_name_to_subgraph_ss.second->ReleaseMemoryPatternBuffers();
+    }
+  }
+}
+
+size_t SessionState::GetNumberOfPooledMemoryPatternBuffers() const {
+  std::lock_guard<std::mutex> lock(mem_pattern_buffer_pool_mutex_);
+  return mem_pattern_buffer_pool_.size();
+}
+
 bool SessionState::GetEnableMemoryPattern() const { return enable_mem_pattern_; }
 
 bool SessionState::GetEnableMemoryReuse() const { return sess_options_.enable_mem_reuse; }
@@ -1435,6 +1554,17 @@ static void AccumulateAllNestedSubgraphsInfo(
   }
 }
 
+// Logs the time taken by a stage of the session initialization and records it as a session event when profiling.
+static void RecordInitializationStage(profiling::Profiler& profiler, const logging::Logger& logger,
+                                      const GraphViewer& graph_viewer, const std::string& stage,
+                                      const TimePoint& start_time) {
+  LOGS(logger, INFO) << "Initialization stage " << stage << " of graph '" << graph_viewer.Name() << "' took "
+                     << TimeDiffMicroSeconds(start_time) << " us";
+  if (profiler.IsEnabled()) {
+    profiler.EndTimeAndRecordEvent(profiling::SESSION_EVENT, stage, start_time);
+  }
+}
+
 Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_TYPE>& graph_location,
                                               const KernelRegistryManager& kernel_registry_manager,
                                               _In_opt_ const Node* parent_node,
@@ -1555,8 +1685,11 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   //  out of memory error in some training tests. Need to create kernel first,
   //  and let the kernel tells us whether the initializer needs to be traced.
   //
+  // Lazy initializers need to be released one by one as well, so they don't use the memory pattern either.
+  const bool lazy_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyInitializers, "0") == "1";
   std::unique_ptr<ITensorAllocator> tensor_allocator = nullptr;
-  if (disable_prepacking) {
+  if (disable_prepacking && !lazy_initializers) {
     tensor_allocator = ITensorAllocator::Create(enable_mem_pattern_, *p_seq_exec_plan_, *this, weights_buffers_);
   } else {
     tensor_allocator = ITensorAllocator::Create(false, *p_seq_exec_plan_, *this, weights_buffers_);
@@ -1594,6 +1727,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   }
 #endif
 
+  // with parallel initialization the intra-op pool unpacks the initializers and runs PrePack
+  concurrency::ThreadPool* initialization_thread_pool =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigParallelInitialization, "0") == "1"
+          ? thread_pool_
+          : nullptr;
+
+  TimePoint stage_start_time = std::chrono::high_resolution_clock::now();
   ORT_RETURN_IF_ERROR(session_state_utils::SaveInitializedTensors(
       Env::Default(), graph_location, *graph_viewer_,
       GetAllocator(OrtDevice()),
@@ -1607,7 +1747,8 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
         return Status::OK();
       },
       logger_, data_transfer_mgr_, external_data_loader_mgr_, *p_seq_exec_plan_, session_options,
-      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked()));
+      memory_profile_func, name_to_buffered_tensor_, graph_.GetPrepacked(), initialization_thread_pool));
+  RecordInitializationStage(profiler_, logger_, *graph_viewer_, "initializer_deserialization", stage_start_time);
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   // Record Weight allocation info on device
@@ -1621,11 +1762,16 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
+  stage_start_time = std::chrono::high_resolution_clock::now();
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
+  RecordInitializationStage(profiler_, logger_, *graph_viewer_, "kernel_creation", stage_start_time);
 
   if (!disable_prepacking) {
+    stage_start_time = std::chrono::high_resolution_clock::now();
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
-                                                          session_options.initializers_to_share_map));
+                                                          session_options.initializers_to_share_map,
+                                                          initialization_thread_pool));
+    RecordInitializationStage(profiler_, logger_, *graph_viewer_, "prepacking", stage_start_time);
   }
 
   ORT_RETURN_IF_ERROR(
@@ -18,6 +18,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/buffer_deleter.h"
 #include "core/framework/callback.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/external_data_loader_manager.h"
@@ -33,6 +34,7 @@
 #include "core/framework/node_index_info.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/symbolic_memory_pattern.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/onnx_protobuf.h"
 #include <mutex>
@@ -238,6 +240,32 @@ class SessionState {
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Get a memory pattern buffer of at least size bytes on the given device that was released by a previous execution.
+  A subgraph of a control flow node is typically executed many times with the same input shapes, so keeping the
+  buffer alive avoids an allocation and free on each execution.
+  Returns nullptr if no buffer is available. Ownership is transferred to the caller.
+  */
+  void* AcquireMemoryPatternBuffer(const OrtDevice& location, size_t size) const;
+
+  /**
+  Return a memory pattern buffer of the given size so it can be re-used by a later execution.
+  The buffer is freed if the pool is full.
+  */
+  void RecycleMemoryPatternBuffer(const OrtDevice& location, size_t size, BufferUniquePtr buffer) const;
+
+  /**
+  Free the memory pattern buffers pooled by this SessionState and the SessionStates of its subgraphs,
+  e.g. before the memory arenas are shrunk. Buffers in use by a running execution are not affected.
+  */
+  void ReleaseMemoryPatternBuffers() const;
+
+  // Whether executions of this subgraph return their memory pattern buffers to the pool.
+  bool GetEnableMemoryPatternBufferPool() const { return enable_mem_pattern_buffer_pool_; }
+
+  // Number of memory pattern buffers currently in the pool.
+  size_t GetNumberOfPooledMemoryPatternBuffers() const;
+
   bool GetUseDeterministicCompute() const { return sess_options_.use_deterministic_compute; }
 
   /**
@@ -254,6 +282,7 @@ class SessionState {
   /**
   Update enable_mem_pattern_ flag according to the presence of graph inputs' shape
   If any one of the graph input is shapeless, enable_mem_pattern_ will be set to false
+  Creates the symbolic memory pattern if it is enabled in the session options.
   */
   void ResolveMemoryPatternFlag();
 
@@ -409,9 +438,11 @@ class SessionState {
   /**
    * Prepack the constant initialized tensors for better performance.
    * The original constant initialized tensors will be removed to save memory.
+   * If thread_pool is not null the kernels of different nodes run PrePack in parallel.
    */
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
-                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
+                                           const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+                                           concurrency::ThreadPool* thread_pool);
 
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
@@ -532,6 +563,9 @@ class SessionState {
   // cache for the generated mem_patterns. key is calculated based on input shapes.
   // must be a node based container as a pointer is cached.
   mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
+  // memory pattern with sizes in the symbolic dimensions of the graph inputs, used to fill mem_patterns_ for new
+  // input shapes. Set only when session.symbolic_memory_pattern is enabled.
+  std::unique_ptr<SymbolicMemoryPattern> symbolic_memory_pattern_;
   // This is mutable under mutex in training scenarios so execution frame would make a copy
   // of the value when created.
 #ifdef ENABLE_TRAINING
@@ -540,6 +574,18 @@ class SessionState {
   NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
 #endif
 
+  struct PooledMemoryPatternBuffer {
+    OrtDevice location;
+    size_t size;
+    BufferUniquePtr buffer;
+  };
+
+  // memory pattern buffers released by previous executions. see AcquireMemoryPatternBuffer.
+  mutable std::mutex mem_pattern_buffer_pool_mutex_;
+  mutable std::vector<PooledMemoryPatternBuffer> mem_pattern_buffer_pool_;
+  // disabled by session.disable_subgraph_memory_pattern_buffer_pool
+  bool enable_mem_pattern_buffer_pool_;
+
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
 
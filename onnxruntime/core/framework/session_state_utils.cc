@@ -16,6 +16,7 @@
 #include "core/common/logging/logging.h"
 #include "core/graph/graph_viewer.h"
 #include "core/framework/data_transfer_manager.h"
+#include "core/framework/external_data_reader.h"
 #include "core/framework/graph_partitioner.h"
 #include "core/framework/ort_value.h"
 #include "core/framework/ort_value_pattern_planner.h"
@@ -28,6 +29,8 @@
 #include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/framework/mem_buffer.h"
 #include "core/framework/tensor_allocator.h"
+#include "core/platform/path_lib.h"
+#include "core/platform/threadpool.h"
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 #include "core/framework/memory_info.h"
 #endif
@@ -330,6 +333,57 @@ common::Status SaveInitializedTensors(
     id_to_initialized_tensor[ort_value_index] = entry.second;
   }
 
+  // In lazy mode initializers with external data used on CPU are never planned or copied. Their file is mapped and
+  // pages are read on first use, and the mapping goes away once all the consumers have pre-packed the tensor.
+  const bool lazy_initializers =
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsLazyInitializers, "0") == "1";
+
+  // With a thread pool the external data of initializers used on CPU can be read into planned buffers by an
+  // ExternalDataReader, which streams large ranges of the files in parallel instead of mapping each initializer.
+  // Initializers whose data is in memory or comes with pre-packed blobs keep going through DeserializeTensorProto.
+  struct ExternalDataRange {
+    std::basic_string<ORTCHAR_T> file_path;
+    FileOffsetType offset;
+    size_t length;
+  };
+  InlinedHashMap<int, ExternalDataRange> external_data_reads;
+  if (thread_pool != nullptr && !lazy_initializers &&
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsParallelExternalDataRead, "0") == "1") {
+    std::basic_string<ORTCHAR_T> tensor_proto_dir;
+    if (!graph_loc.empty()) {
+      ORT_RETURN_IF_ERROR(GetDirNameFromFilePath(graph_loc, tensor_proto_dir));
+    }
+
+    for (const auto& entry : id_to_initialized_tensor) {
+      const auto& tensor_proto = *entry.second;
+      if (!utils::HasExternalData(tensor_proto) ||
+          tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+          exec_plan.GetLocation(entry.first).Type() != OrtDevice::CPU ||
+          user_supplied_initializer_ids.find(entry.first) != user_supplied_initializer_ids.end() ||
+          buffered_tensors.find(tensor_proto.name()) != buffered_tensors.end()) {
+        continue;
+      }
+
+      ExternalDataRange range;
+      SafeInt<size_t> length = 0;
+      ExternalDataInfo::PrepackedInfos prepacked_infos;
+      ORT_RETURN_IF_ERROR(utils::GetExternalDataInfo(tensor_proto, tensor_proto_dir, range.file_path, range.offset,
+                                                     length, &prepacked_infos));
+      if (range.file_path == utils::kTensorProtoMemoryAddressTag || !prepacked_infos.empty()) {
+        continue;
+      }
+
+      range.length = length;
+      external_data_reads.emplace(entry.first, std::move(range));
+    }
+  }
+
+  auto is_mapped_on_cpu = [&exec_plan, &external_data_reads](int ort_value_index,
+                                                             const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+    return utils::HasExternalData(tensor_proto) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU &&
+           external_data_reads.find(ort_value_index) == external_data_reads.end();
+  };
+
   // tensors requiring a specific allocation order are traced first, to ensure they are allocated in order
   // NB1: vector with init allocation order may contain a subset of all tensors (or none at all)
   // NB2: only skip tracing and planning memory when data is external (i.e mmap) and on CPU.
@@ -339,7 +393,7 @@ common::Status SaveInitializedTensors(
     const auto entry = initialized_tensors_to_allocate.find(ort_value_index);
     ORT_ENFORCE(entry != initialized_tensors_to_allocate.end(),
                 "OrtValue index: ", ort_value_index, " from initializer_allocation_order not found among initialized tensors");
-    if (!(utils::HasExternalData(*entry->second) && exec_plan.GetLocation(ort_value_index).Type() == OrtDevice::CPU)) {
+    if (!is_mapped_on_cpu(ort_value_index, *entry->second)) {
       // can not trace string tensor
       ORT_ENFORCE(entry->second->data_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING, "Can not trace string tensor");
       ORT_RETURN_IF_ERROR(planner.Trace(entry->first, entry->second));
@@ -356,6 +410,9 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    if (lazy_initializers && is_mapped_on_cpu(entry.first, *entry.second)) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
 
@@ -376,6 +433,48 @@ common::Status SaveInitializedTensors(
 
   OrtCallback deleter{nullptr, nullptr};
 
+  auto save_tensor = [&](const std::string& name, int ort_value_index, const OrtValue& ort_value) -> Status {
+    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
+    // so we need to output this message prior to calling save_tensor_func
+    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+
+    // any outer scope value is shadowed by a local value and can't override it.
+    // due to that check_outer_scope is false
+    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
+#if !defined(DISABLE_SPARSE_TENSORS)
+    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
+    return save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse);
+#else
+    return save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false);
+#endif
+  };
+
+  // Initializers with their data in the model that go to CPU memory only need their own buffer to be unpacked,
+  // so with a thread pool they are deserialized in parallel after the loop below and saved afterwards.
+  struct DeferredInitializer {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::optional<MemBuffer> m;
+    AllocatorPtr alloc;
+    OrtValue ort_value;
+  };
+  std::vector<DeferredInitializer> deferred_initializers;
+
+  // Initializers filled by external_data_reader once all the reads are known.
+  struct ReadInitializer {
+    int ort_value_index;
+    const ONNX_NAMESPACE::TensorProto* tensor_proto;
+    std::unique_ptr<Tensor> tensor;
+  };
+  std::vector<ReadInitializer> read_initializers;
+  ExternalDataReader external_data_reader(env);
+
+  // lazy mode keeps initializers out of the arena so that the memory of an original released after pre-packing
+  // goes back to the system
+  const bool use_device_allocator_for_initializers =
+      lazy_initializers ||
+      session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+
   // 3. create weight tensors based on weights buffer
   for (const auto& entry : id_to_initialized_tensor) {
     int ort_value_index = entry.first;
@@ -399,10 +498,13 @@ common::Status SaveInitializedTensors(
 
       std::optional<MemBuffer> m;
       AllocatorPtr alloc;
-      // TODO: if the tensor need be copied, does it have enough room?
-      ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
-      bool use_device_allocator_for_initializers =
-          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsUseDeviceAllocatorForInitializers, "0") == "1";
+      if (lazy_initializers && is_mapped_on_cpu(ort_value_index, tensor_proto)) {
+        // not planned. the allocator only tells DeserializeTensorProto that the data stays on CPU
+        alloc = default_cpu_alloc;
+      } else {
+        // TODO: if the tensor need be copied, does it have enough room?
+        ORT_RETURN_IF_ERROR(planner.GetPreallocatedBuffer(ort_value_index, name, m, alloc));
+      }
 
       Tensor* p_tensor = nullptr;
       auto buffered_tensors_iter = buffered_tensors.find(name);
@@ -410,6 +512,32 @@ common::Status SaveInitializedTensors(
         p_tensor = buffered_tensors_iter->second.get();
       }
 
+      const auto& memory_info = m.has_value() ? m->GetAllocInfo() : alloc->Info();
+      const auto external_data_read = external_data_reads.find(ort_value_index);
+      if (external_data_read != external_data_reads.end() &&
+          external_data_loader_mgr.GetExternalDataLoader(memory_info) == nullptr) {
+        TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+        const DataTypeImpl* const type =
+            DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
+        std::unique_ptr<Tensor> tensor;
+        ORT_RETURN_IF_ERROR(AllocateTensor(m.has_value() ? &*m : nullptr, tensor, type, tensor_shape,
+                                           use_device_allocator_for_initializers, alloc));
+
+        const auto& range = external_data_read->second;
+        ORT_RETURN_IF(range.length != tensor->SizeInBytes(), "External initializer: ", name,
+                      " size to read: ", range.length, " does not match the tensor size: ", tensor->SizeInBytes());
+        external_data_reader.Add(range.file_path, range.offset, range.length, tensor->MutableDataRaw());
+        read_initializers.push_back(ReadInitializer{ort_value_index, &tensor_proto, std::move(tensor)});
+        continue;
+      }
+
+      if (thread_pool != nullptr && p_tensor == nullptr && !utils::HasExternalData(tensor_proto) &&
+          memory_info.device.Type() == OrtDevice::CPU) {
+        deferred_initializers.push_back(DeferredInitializer{ort_value_index, &tensor_proto, std::move(m),
+                                                            std::move(alloc), OrtValue()});
+        continue;
+      }
+
       Status st = DeserializeTensorProto(env, graph_loc, tensor_proto, (m.has_value()) ? &*m : nullptr, alloc,
                                          default_cpu_alloc, ort_value, data_transfer_mgr, external_data_loader_mgr,
                                          prepacked_for_graph,
@@ -427,19 +555,56 @@ common::Status SaveInitializedTensors(
       }
     }
 
-    // 'name' is a reference to a string within the TensorProto that save_tensor_func may free
-    // so we need to output this message prior to calling save_tensor_func
-    VLOGS(logger, 1) << "Adding weight with name : " << name << " with index: " << ort_value_index;
+    ORT_RETURN_IF_ERROR(save_tensor(name, ort_value_index, ort_value));
+  }
 
-    // any outer scope value is shadowed by a local value and can't override it.
-    // due to that check_outer_scope is false
-    const bool constant = graph.IsConstantInitializer(name, /* check_outer_scope */ false);
-#if !defined(DISABLE_SPARSE_TENSORS)
-    const bool sparse = graph.GetGraph().IsSparseInitializer(name);
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, sparse));
-#else
-    ORT_RETURN_IF_ERROR(save_tensor_func(name, ort_value_index, ort_value, deleter, constant, false));
-#endif
+  if (!read_initializers.empty()) {
+    LOGS(logger, INFO) << "Reading the external data of " << read_initializers.size() << " initializers.";
+    ORT_RETURN_IF_ERROR(external_data_reader.Read(thread_pool));
+
+    for (auto& initializer : read_initializers) {
+      if constexpr (endian::native != endian::little) {
+        utils::ConvertRawDataInTensorProto(const_cast<ONNX_NAMESPACE::TensorProto*>(initializer.tensor_proto),
+                                           initializer.tensor->MutableDataRaw(), initializer.tensor->SizeInBytes());
+      }
+
+      OrtValue ort_value;
+      Tensor::InitOrtValue(std::move(*initializer.tensor), ort_value);
+      ORT_RETURN_IF_ERROR(save_tensor(initializer.tensor_proto->name(), initializer.ort_value_index, ort_value));
+    }
+  }
+
+  if (!deferred_initializers.empty()) {
+    std::vector<Status> deserialize_status(deferred_initializers.size());
+    concurrency::ThreadPool::TrySimpleParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(deferred_initializers.size()),
+        [&](std::ptrdiff_t i) {
+          auto& initializer = deferred_initializers[i];
+          ORT_TRY {
+            deserialize_status[i] = DeserializeTensorProto(
+                env, graph_loc, *initializer.tensor_proto, initializer.m.has_value() ? &*initializer.m : nullptr,
+                initializer.alloc, default_cpu_alloc, initializer.ort_value, data_transfer_mgr,
+                external_data_loader_mgr, prepacked_for_graph, use_device_allocator_for_initializers);
+          }
+          ORT_CATCH(const std::exception& ex) {
+            ORT_HANDLE_EXCEPTION([&]() {
+              deserialize_status[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, ex.what());
+            });
+          }
+        });
+
+    for (size_t i = 0; i < deferred_initializers.size(); ++i) {
+      const Status& st = deserialize_status[i];
+      const auto& initializer = deferred_initializers[i];
+      if (!st.IsOK()) {
+        std::ostringstream oss;
+        oss << "Deserialize tensor " << initializer.tensor_proto->name() << " failed." << st.ErrorMessage();
+        return Status(st.Category(), st.Code(), oss.str());
+      }
+
+      ORT_RETURN_IF_ERROR(save_tensor(initializer.tensor_proto->name(), initializer.ort_value_index,
+                                      initializer.ort_value));
+    }
   }
 
   LOGS(logger, INFO) << "Done saving initialized tensors";
@@ -26,6 +26,9 @@ class OrtValueNameIdxMap;
 class DataTransferManager;
 class ExternalDataLoaderManager;
 class NodeArg;
+namespace concurrency {
+class ThreadPool;
+}
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
 class MemoryInfo;
 #endif
@@ -39,6 +42,9 @@ using SaveTensorFunction = std::function<Status(const std::string& name, int idx
                                                 const OrtCallback& d, bool constant, bool sparse)>;
 using MemoryProfileFunction = std::function<void(ITensorAllocator& planner)>;
 
+// If thread_pool is not null, initializers whose data is stored in the model and which are deserialized to CPU
+// memory are unpacked in parallel. With "session.parallel_external_data_read" the external data of the initializers
+// used on CPU is also read in parallel into planned buffers.
 common::Status SaveInitializedTensors(
     const Env& env, const std::basic_string<PATH_CHAR_TYPE>& graph_loc,
     const GraphViewer& graph, const AllocatorPtr& default_cpu_memory_info,
@@ -52,7 +58,8 @@ common::Status SaveInitializedTensors(
     const SessionOptions& session_options,
     const MemoryProfileFunction& memory_profile_func,
     std::unordered_map<std::string, std::unique_ptr<Tensor>>& buffered_tensors,
-    PrepackedWeightsForGraph& prepacked_for_graph);
+    PrepackedWeightsForGraph& prepacked_for_graph,
+    concurrency::ThreadPool* thread_pool = nullptr);
 
 common::Status AllocateTensor(
     const onnxruntime::MemBuffer* m,
@@ -0,0 +1,198 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/symbolic_memory_pattern.h"
+
+#include <string>
+
+#include "core/common/logging/logging.h"
+#include "core/framework/data_types_internal.h"
+#include "core/framework/ort_value_name_idx_map.h"
+#include "core/framework/ort_value_pattern_planner.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// The memory pattern planner only traces tensors that are not strings, see ExecutionFrame::TraceFree.
+bool IsTracedTensor(const AllocPlanPerValue& per_value_plan) {
+  return per_value_plan.value_type != nullptr && per_value_plan.value_type->IsTensorType() &&
+         !utils::IsDataTypeString(static_cast<const TensorTypeBase*>(per_value_plan.value_type)->GetElementType());
+}
+
+}  // namespace
+
+std::unique_ptr<SymbolicMemoryPattern> SymbolicMemoryPattern::Create(const GraphViewer& graph_viewer,
+                                                                     const SequentialExecutionPlan& execution_plan,
+                                                                     const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                                     const logging::Logger& logger) {
+  // With several streams the relative order of allocations on different streams is not fixed.
+  if (execution_plan.NumberOfValidStreams() != 1) {
+    return nullptr;
+  }
+
+  std::unique_ptr<SymbolicMemoryPattern> pattern(new SymbolicMemoryPattern(execution_plan));
+
+  // Collect the symbolic dimensions of the graph inputs, and of the implicit inputs for a subgraph, as they are all
+  // fed to the execution frame.
+  InlinedHashMap<std::string, int> symbol_ids;
+  auto add_symbol_sources = [&](const NodeArg& input) {
+    const auto* shape = input.Shape();
+    int ort_value_idx = -1;
+    if (shape == nullptr || !ort_value_name_idx_map.GetIdx(input.Name(), ort_value_idx).IsOK()) {
+      return;
+    }
+
+    for (int axis = 0; axis < shape->dim_size(); ++axis) {
+      const auto& dim = shape->dim(axis);
+      if (!dim.has_dim_param()) {
+        continue;
+      }
+
+      auto inserted = symbol_ids.emplace(dim.dim_param(), static_cast<int>(pattern->symbol_sources_.size()));
+      if (inserted.second) {
+        pattern->symbol_sources_.emplace_back();
+      }
+      pattern->symbol_sources_[inserted.first->second].push_back({ort_value_idx, static_cast<size_t>(axis)});
+    }
+  };
+
+  for (const auto* input : graph_viewer.GetInputs()) {
+    add_symbol_sources(*input);
+  }
+  if (graph_viewer.IsSubgraph()) {
+    for (const auto* implicit_input : graph_viewer.ParentNode()->ImplicitInputDefs()) {
+      add_symbol_sources(*implicit_input);
+    }
+  }
+
+  const auto& allocation_plan = execution_plan.allocation_plan;
+  InlinedVector<size_t> release_counts;
+  release_counts.reserve(execution_plan.release_actions.size());
+  for (const auto& action : execution_plan.release_actions) {
+    release_counts.push_back(action.ref_count);
+  }
+
+  // Follow the steps of the single stream: a kernel allocates its outputs, then the values released after the node
+  // are freed, as in RecycleNodeInputs.
+  InlinedHashSet<NodeIndex> visited_nodes;
+  for (const auto& logic_stream : execution_plan.execution_plan) {
+    for (const auto& step : logic_stream->steps_) {
+      const NodeIndex node_index = step->GetNodeIndex();
+      const Node* node = graph_viewer.GetNode(node_index);
+      if (node == nullptr || !visited_nodes.insert(node_index).second) {
+        continue;
+      }
+
+      for (const auto* output : node->OutputDefs()) {
+        int ort_value_idx = -1;
+        if (!output->Exists() || !ort_value_name_idx_map.GetIdx(output->Name(), ort_value_idx).IsOK()) {
+          continue;
+        }
+
+        const auto& per_value_plan = allocation_plan[ort_value_idx];
+        if (per_value_plan.alloc_kind != AllocKind::kAllocate || !IsTracedTensor(per_value_plan)) {
+          continue;
+        }
+
+        TensorTemplate tensor{ort_value_idx,
+                              static_cast<const TensorTypeBase*>(per_value_plan.value_type)->GetElementType(),
+                              {}};
+        const auto* shape = output->Shape();
+        bool resolved = shape != nullptr;
+        for (int axis = 0; resolved && axis < shape->dim_size(); ++axis) {
+          const auto& dim = shape->dim(axis);
+          if (dim.has_dim_value() && dim.dim_value() > 0) {
+            tensor.dims.push_back(dim.dim_value());
+            continue;
+          }
+
+          const auto symbol = dim.has_dim_param() ? symbol_ids.find(dim.dim_param()) : symbol_ids.end();
+          if (symbol != symbol_ids.end()) {
+            tensor.dims.push_back(-static_cast<int64_t>(symbol->second) - 1);
+          } else {
+            resolved = false;
+          }
+        }
+
+        // left out of the pattern, so the execution frame allocates it dynamically like a tensor of unknown size
+        if (!resolved) {
+          LOGS(logger, VERBOSE) << "[Symbolic memory pattern] The shape of " << output->Name()
+                                << " can't be expressed in the dimensions of the graph inputs. It is not planned.";
+          continue;
+        }
+
+        pattern->events_.push_back({ort_value_idx, static_cast<int>(pattern->tensors_.size())});
+        pattern->tensors_.push_back(std::move(tensor));
+      }
+
+      for (auto release_index : execution_plan.node_release_list[node_index]) {
+        if (--release_counts[release_index] == 0) {
+          const int ort_value_idx = static_cast<int>(execution_plan.release_actions[release_index].value_index);
+          if (IsTracedTensor(allocation_plan[ort_value_idx])) {
+            pattern->events_.push_back({ort_value_idx, -1});
+          }
+        }
+      }
+    }
+  }
+
+  if (pattern->tensors_.empty()) {
+    return nullptr;
+  }
+
+  return pattern;
+}
+
+Status SymbolicMemoryPattern::Evaluate(gsl::span<const OrtValue> feeds, gsl::span<const int> feed_mlvalue_idxs,
+                                       MemoryPatternGroup& output) const {
+  InlinedHashMap<int, const Tensor*> feed_tensors;
+  feed_tensors.reserve(feed_mlvalue_idxs.size());
+  for (size_t i = 0, end = feed_mlvalue_idxs.size(); i < end; ++i) {
+    ORT_RETURN_IF_NOT(feeds[i].IsTensor(), "Symbolic memory pattern requires tensor feeds.");
+    feed_tensors.emplace(feed_mlvalue_idxs[i], &feeds[i].Get<Tensor>());
+  }
+
+  InlinedVector<int64_t> symbol_values(symbol_sources_.size(), -1);
+  for (size_t symbol = 0; symbol < symbol_sources_.size(); ++symbol) {
+    for (const auto& source : symbol_sources_[symbol]) {
+      auto feed = feed_tensors.find(source.ort_value_idx);
+      if (feed == feed_tensors.end() || source.axis >= feed->second->Shape().NumDimensions()) {
+        continue;
+      }
+
+      const int64_t value = feed->second->Shape()[source.axis];
+      ORT_RETURN_IF(symbol_values[symbol] != -1 && symbol_values[symbol] != value,
+                    "Symbolic dimension ", symbol, " is bound to both ", symbol_values[symbol], " and ", value);
+      symbol_values[symbol] = value;
+    }
+
+    ORT_RETURN_IF(symbol_values[symbol] < 0, "Symbolic dimension ", symbol, " is not found in the feeds.");
+  }
+
+  OrtValuePatternPlanner planner(execution_plan_);
+  TensorShapeVector dims;
+  for (const auto& event : events_) {
+    if (event.tensor < 0) {
+      ORT_RETURN_IF_ERROR(planner.TraceFree(event.ort_value_idx));
+      continue;
+    }
+
+    const auto& tensor = tensors_[event.tensor];
+    dims.clear();
+    for (auto dim : tensor.dims) {
+      dims.push_back(dim >= 0 ? dim : symbol_values[static_cast<size_t>(-dim - 1)]);
+    }
+
+    size_t size = 0;
+    ORT_RETURN_IF_ERROR(Tensor::CalculateTensorStorageSize(tensor.element_type, TensorShape(dims), kAllocAlignment,
+                                                           size));
+    ORT_RETURN_IF_ERROR(planner.TraceAllocation(event.ort_value_idx, size));
+  }
+
+  return planner.GeneratePatterns(output);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,88 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/mem_pattern.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/sequential_execution_plan.h"
+
+namespace onnxruntime {
+
+class GraphViewer;
+class OrtValueNameIdxMap;
+namespace logging {
+class Logger;
+}
+
+/**
+Memory pattern of a graph whose tensor sizes are expressions in the symbolic dimensions of the graph inputs.
+
+The sizes are kept as shape templates where each dimension is either a fixed value or one of the symbolic dimensions
+(e.g. 'batch', 'seq_len') of the graph inputs. The order in which the execution plan allocates and releases the planned
+tensors does not depend on the shapes, so it is recorded once. For a set of feeds, Evaluate binds the symbolic
+dimensions to the feed shapes, computes every tensor size and replays the allocations to produce the same
+MemoryPatternGroup the first Run with those shapes would have traced. A tensor whose shape can't be expressed this way
+is left out of the pattern and allocated dynamically by the execution frame.
+
+SessionState::GeneratePatternGroupCache does a similar computation in training builds, but it depends on the program
+counters and the node order that only the training allocation planner records, and it resolves every NodeArg shape
+again for each new set of input shapes. This class works with the inference execution plan and does the shape
+analysis once, when the session state is finalized.
+*/
+class SymbolicMemoryPattern {
+ public:
+  /**
+  Creates the pattern for a single stream execution plan.
+  Returns nullptr if the plan uses more than one stream, or if none of the tensors that the plan allocates has a shape
+  made of fixed dimensions and symbolic dimensions of the graph inputs.
+  */
+  static std::unique_ptr<SymbolicMemoryPattern> Create(const GraphViewer& graph_viewer,
+                                                       const SequentialExecutionPlan& execution_plan,
+                                                       const OrtValueNameIdxMap& ort_value_name_idx_map,
+                                                       const logging::Logger& logger);
+
+  /**
+  Computes the memory pattern for the shapes of the given feeds.
+  Fails if a symbolic dimension is missing from the feeds or has different values in different feeds.
+  */
+  Status Evaluate(gsl::span<const OrtValue> feeds, gsl::span<const int> feed_mlvalue_idxs,
+                  MemoryPatternGroup& output) const;
+
+  size_t NumSymbols() const { return symbol_sources_.size(); }
+  size_t NumTensors() const { return tensors_.size(); }
+
+ private:
+  explicit SymbolicMemoryPattern(const SequentialExecutionPlan& execution_plan) : execution_plan_(execution_plan) {}
+
+  // A graph input dimension a symbolic dimension is read from.
+  struct SymbolSource {
+    int ort_value_idx;
+    size_t axis;
+  };
+
+  // A dimension >= 0 is a fixed value. A dimension < 0 refers to the symbolic dimension at index -(dim + 1).
+  struct TensorTemplate {
+    int ort_value_idx;
+    MLDataType element_type;
+    InlinedVector<int64_t> dims;
+  };
+
+  // Allocation of tensors_[tensor] if tensor >= 0, otherwise the release of ort_value_idx.
+  struct Event {
+    int ort_value_idx;
+    int tensor;
+  };
+
+  const SequentialExecutionPlan& execution_plan_;
+  std::vector<InlinedVector<SymbolSource>> symbol_sources_;
+  std::vector<TensorTemplate> tensors_;
+  std::vector<Event> events_;
+};
+
+}  // namespace onnxruntime
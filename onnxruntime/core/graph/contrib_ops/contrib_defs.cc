@@ -631,6 +631,54 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Evaluates a chain or DAG of element-wise float operators in one pass over the data, so that intermediate
+results stay in cache. Created by the ElementwiseFusion graph transformer when the session config entry
+"optimization.enable_elementwise_fusion" is "1".
+
+The node runs a small program. Registers 0 to N-1 hold the N inputs and register N+i holds the result
+of instruction i. Instruction i applies ops[i] to the registers operands[2*i] and operands[2*i+1]
+(the second one is -1 for unary operators). Output j is register outputs[j].
+Every input has either the shape of the outputs or a single element, which is broadcast.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDomain(kMSDomain)
+        .SinceVersion(1)
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops", "ONNX operator type of each instruction: Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Neg, Abs, Exp or Sqrt.",
+              AttributeProto::STRINGS)
+        .Attr("operands", "Two register indices per instruction. The second one is -1 for unary operators.",
+              AttributeProto::INTS)
+        .Attr("outputs", "Register index of each output.", AttributeProto::INTS)
+        .Input(0, "inputs", "The inputs of the program.", "T", OpSchema::Variadic)
+        .Output(0, "outputs", "The outputs of the program.", "T", OpSchema::Variadic)
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+            propagateElemTypeFromInputToOutput(ctx, 0, i);
+          }
+
+          for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+            if (!hasInputShape(ctx, i)) {
+              return;
+            }
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto shape = getInputShape(ctx, 0);
+          for (size_t i = 1; i < ctx.getNumInputs(); ++i) {
+            ONNX_NAMESPACE::TensorShapeProto broadcast_shape;
+            bidirectionalBroadcastShapeInference(shape, getInputShape(ctx, i), broadcast_shape);
+            shape = broadcast_shape;
+          }
+
+          for (size_t i = 0; i < ctx.getNumOutputs(); ++i) {
+            *getOutputShape(ctx, i) = shape;
+          }
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -1325,6 +1373,11 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
                                       AttributeProto::INT, static_cast<int64_t>(-1))
+                                .Attr("num_speculative_tokens",
+                                      "Maximum number of tokens proposed by prompt lookup (matching the last n-gram against earlier tokens) "
+                                      "and verified in a single `decoder` run. 0 disables speculative decoding. "
+                                      "Only supported by the CPU GPT-2 implementation with batch_size 1 and without past_present_share_buffer; other configurations fail.",
+                                      AttributeProto::INT, static_cast<int64_t>(0))
                                 .Input(0, "input_ids", "The sequence used as a prompt for the generation. Shape is (batch_size, sequence_length)", "I")
                                 .Input(1, "max_length", "The maximum length of the sequence to be generated. Shape is (1)", "I")
                                 .Input(2, "min_length", "The minimum length below which the score of eos_token_id is set to -Inf. Shape is (1)", "I", OpSchema::Optional)
@@ -600,6 +600,35 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+const char* QLinearGeluDoc_ver1 = R"DOC(
+QLinearGelu takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(Gelu(dequantize(x)))`, is applied to the data tensor elementwise.
+Where the function `Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))`, or its tanh approximation if `approximate` is
+"tanh". )DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearGelu, 1,
+    OpSchema()
+        .SetDoc(QLinearGeluDoc_ver1)
+        .Attr("approximate", "Gelu approximation algorithm: \"none\" (default) or \"tanh\".", AttributeProto::STRING,
+              std::string("none"))
+        .Input(0, "X", "Input tensor", "T")
+        .Input(1, "X_scale", "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(3, "Y_scale", "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(4, "Y_zero_point",
+               "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Output(0, "Y", "Output tensor", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     QLinearSoftmax, 1,
     OpSchema()
@@ -654,6 +683,32 @@ The output tensor has the same shape.
           propagateShapeFromInputToOutput(ctx, 0, 0);
         }));
 
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearLayerNormalization, 1,
+    OpSchema()
+        .SetDoc(R"DOC(
+QLinearLayerNormalization computes LayerNormalization(dequantize(X), Scale, B) and quantizes the result with the
+quantization parameters of 'Y'. Each normalized row is computed in float, so the surrounding quantized tensors do not
+need to be materialized in float.
+)DOC")
+        .Attr("axis", "The first normalization dimension. Negative value means counting dimensions from the back.",
+              AttributeProto::INT, static_cast<int64_t>(-1))
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+        .Attr("stash_type", "Type of Mean and InvStdDev. Ignored, the statistics are always computed in float.",
+              AttributeProto::INT, static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT))
+        .Input(0, "X", "Input data tensor.", "T")
+        .Input(1, "X_scale", "Scale of quantized input 'X'. It must be a scalar.", "tensor(float)")
+        .Input(2, "X_zero_point", "Zero point of quantized input 'X'. It must be a scalar.", "T", OpSchema::Optional)
+        .Input(3, "Y_scale", "Scale of quantized output 'Y'. It must be a scalar.", "tensor(float)")
+        .Input(4, "Y_zero_point", "Zero point of quantized output 'Y'. It must be a scalar.", "T", OpSchema::Optional)
+        .Input(5, "Scale", "Scale tensor, with the shape of the normalized dimensions of 'X'.", "tensor(float)")
+        .Input(6, "B", "Bias tensor, with the shape of the normalized dimensions of 'X'.", "tensor(float)",
+               OpSchema::Optional)
+        .Output(0, "Y", "Output data tensor, with the same shape as 'X'.", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"},
+                        "Constrain input and output types to signed/unsigned int8 tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     DynamicQuantizeLSTM, 1,
     OpSchema()
@@ -9,6 +9,7 @@
 #include <numeric>
 #include <queue>
 #include <stack>
+#include <type_traits>
 
 #include <gsl/gsl>
 
@@ -993,6 +994,9 @@ void Node::CreateSubgraph(const std::string& attr_name) {
 
 void Node::AddAttributeProto(AttributeProto value) {
   utils::SetNodeAttribute(std::move(value), attributes_);
+#if !defined(ORT_MINIMAL_BUILD)
+  inference_signature_.clear();
+#endif
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
@@ -1041,6 +1045,9 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 bool Node::ClearAttribute(const std::string& attr_name) {
+#if !defined(ORT_MINIMAL_BUILD)
+  inference_signature_.clear();
+#endif
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   return attributes_.erase(attr_name) > 0;
@@ -1049,6 +1056,9 @@ bool Node::ClearAttribute(const std::string& attr_name) {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
 int Node::PruneRemovableAttributes(gsl::span<const std::string> removable_attributes) {
+#if !defined(ORT_MINIMAL_BUILD)
+  inference_signature_.clear();
+#endif
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
   int n_removed = 0;
@@ -2664,9 +2674,17 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
     // only return data if it's for a constant initializer. checks for outer scope initializers
     // if this is a subgraph and the name isn't found locally.
     const TensorProto* initializer = graph_.GetConstantInitializer(def->Name(), true);
+    if (initializer != nullptr &&
+        std::find(data_inputs_.begin(), data_inputs_.end(), static_cast<int>(index)) == data_inputs_.end()) {
+      data_inputs_.push_back(static_cast<int>(index));
+    }
+
     return initializer;
   }
 
+  // indices of the inputs whose constant initializer data was read by the inference
+  const InlinedVector<int>& DataInputs() const { return data_inputs_; }
+
   // ORT does not implement partial data propagation yet so just return nullptr.
   const TensorShapeProto* getSymbolicInput(size_t) const override {
     return nullptr;
@@ -2703,6 +2721,7 @@ class InferenceContextImpl : public ONNX_NAMESPACE::InferenceContext {
   std::vector<std::unique_ptr<GraphInferencerImpl>> graph_inferencers_;
   const Graph& graph_;
   const Graph::ResolveOptions& options_;
+  mutable InlinedVector<int> data_inputs_;
 };
 
 Status Graph::InferAndVerifySubgraphTypes(const Node& node, Graph& subgraph,
@@ -2910,6 +2929,9 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     ORT_RETURN_IF_ERROR(status);
   }
 
+  // the data read by the inference is part of the node's inference signature for incremental Resolve
+  node.inference_data_inputs_ = context.DataInputs();
+
   const auto& onnx_inferred_types(context.InferredOutputTypes());
 
   // Infer and verify node output arg type information.
@@ -3134,12 +3156,35 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     lsc.output_names.insert(std::string(input));
   }
 
+  // incremental resolve is configured on the main graph
+  const Graph* main_graph = this;
+  while (main_graph->parent_graph_ != nullptr) {
+    main_graph = main_graph->parent_graph_;
+  }
+
+  const bool incremental = main_graph->incremental_resolve_ && !options.override_types;
+  size_t num_nodes_skipped = 0;
+  std::string signature;
+
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
 
     const auto& node_name = node.Name();
 
+    // inferring a node again with the same schema, attributes, inputs and outputs gives the same result
+    if (incremental && !node.inference_signature_.empty() && !node.ContainsSubgraph()) {
+      ComputeInferenceSignature(node, signature);
+      if (node.inference_signature_ == signature) {
+        for (const auto& output : node.OutputDefs()) {
+          lsc.output_names.insert(output->Name());
+        }
+
+        ++num_nodes_skipped;
+        continue;
+      }
+    }
+
     if (!node.Op()) {
       {
         auto status = Status::OK();
@@ -3224,6 +3269,11 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     }
 
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
+    if (incremental) {
+      ComputeInferenceSignature(node, node.inference_signature_);
+    } else {
+      node.inference_signature_.clear();
+    }
 
     // Accumulate output names of the iterated Node
     for (const auto& output : node.OutputDefs()) {
@@ -3231,6 +3281,16 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     }
   }
 
+  num_nodes_skipped_by_last_resolve_ = num_nodes_skipped;
+  if (num_nodes_skipped > 0) {
+    LOGS(logger_, VERBOSE) << "Incremental resolve skipped type and shape inference for " << num_nodes_skipped
+                           << " of " << nodes_in_topological_order_.size() << " nodes";
+
+    if (main_graph->verify_incremental_resolve_) {
+      ORT_RETURN_IF_ERROR(VerifyIncrementalInference(options));
+    }
+  }
+
   // verify subgraphs
   for (auto node_index : nodes_in_topological_order_) {
     auto& node = *GetNode(node_index);
@@ -3243,6 +3303,132 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   return Status::OK();
 }
 
+namespace {
+
+template <typename T>
+void AppendToSignature(const T& value, std::string& signature) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only the bytes of trivially copyable values are appended.");
+  signature.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void AppendToSignature(const std::string& value, std::string& signature) {
+  // the length keeps the concatenation of several strings unambiguous
+  AppendToSignature(value.size(), signature);
+  signature.append(value);
+}
+
+// A value's type and shape. Tensor types are written without serializing them.
+void AppendTypeProtoToSignature(const TypeProto* type, std::string& signature) {
+  AppendToSignature(type != nullptr, signature);
+  if (type == nullptr) {
+    return;
+  }
+
+  AppendToSignature(utils::HasTensorType(*type), signature);
+  if (utils::HasTensorType(*type)) {
+    const auto& tensor_type = type->tensor_type();
+    AppendToSignature(tensor_type.elem_type(), signature);
+    AppendToSignature(tensor_type.has_shape(), signature);
+    AppendToSignature(tensor_type.shape().dim_size(), signature);
+    for (const auto& dim : tensor_type.shape().dim()) {
+      AppendToSignature(static_cast<int>(dim.value_case()), signature);
+      if (utils::HasDimValue(dim)) {
+        AppendToSignature(dim.dim_value(), signature);
+      } else if (utils::HasDimParam(dim)) {
+        AppendToSignature(dim.dim_param(), signature);
+      }
+    }
+  } else {
+    AppendToSignature(type->SerializeAsString(), signature);
+  }
+}
+
+}  // namespace
+
+void Graph::ComputeInferenceSignature(const Node& node, std::string& signature) const {
+  signature.clear();
+  AppendToSignature(node.Op(), signature);
+  AppendToSignature(node.SinceVersion(), signature);
+
+  AppendToSignature(node.InputDefs().size(), signature);
+  for (const NodeArg* input : node.InputDefs()) {
+    AppendToSignature(input->Name(), signature);
+    AppendToSignature(input->Exists(), signature);
+    if (input->Exists()) {
+      AppendTypeProtoToSignature(input->TypeAsProto(), signature);
+      // inference can only read the data of a constant initializer, so adding or removing one changes the result
+      AppendToSignature(GetConstantInitializer(input->Name(), true) != nullptr, signature);
+    }
+  }
+
+  // the data of the constant initializers read by the last inference, e.g. the shape of a Reshape. the hash of the
+  // data rather than the address of the initializer catches an initializer replaced by another one.
+  AppendToSignature(node.inference_data_inputs_.size(), signature);
+  for (const int index : node.inference_data_inputs_) {
+    const auto& name = node.InputDefs()[index]->Name();
+    const TensorProto* initializer = GetConstantInitializer(name, true);
+    AppendToSignature(initializer != nullptr, signature);
+    if (initializer != nullptr) {
+      // the initializer may come from an outer scope, whose graph holds its hash
+      const Graph* graph = this;
+      while (graph->parent_graph_ != nullptr && graph->name_to_initial_tensor_.count(name) == 0) {
+        graph = graph->parent_graph_;
+      }
+
+      AppendToSignature(graph->GetInitializerDataHash(name, *initializer), signature);
+    }
+  }
+
+  // an output that was replaced or whose type was changed from outside needs to be inferred again
+  AppendToSignature(node.OutputDefs().size(), signature);
+  for (const NodeArg* output : node.OutputDefs()) {
+    AppendToSignature(output->Name(), signature);
+    AppendTypeProtoToSignature(output->TypeAsProto(), signature);
+  }
+}
+
+size_t Graph::GetInitializerDataHash(const std::string& name, const TensorProto& initializer) const {
+  auto it = initializer_data_hashes_.find(name);
+  if (it == initializer_data_hashes_.end()) {
+    it = initializer_data_hashes_.emplace(name, std::hash<std::string>{}(initializer.SerializeAsString())).first;
+  }
+
+  return it->second;
+}
+
+Status Graph::VerifyIncrementalInference(const ResolveOptions& options) {
+  // the types and shapes after the incremental pass
+  InlinedHashMap<const NodeArg*, std::string> incremental_types;
+  for (auto node_index : nodes_in_topological_order_) {
+    for (const NodeArg* output : GetNode(node_index)->OutputDefs()) {
+      if (output->Exists() && output->TypeAsProto() != nullptr) {
+        incremental_types[output] = output->TypeAsProto()->SerializeAsString();
+      }
+    }
+  }
+
+  // a full pass merges the inferred types into the existing ones, so any difference shows up as a change
+  for (auto node_index : nodes_in_topological_order_) {
+    auto& node = *GetNode(node_index);
+    NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *node.Op(), options)));
+
+    for (const NodeArg* output : node.OutputDefs()) {
+      if (!output->Exists() || output->TypeAsProto() == nullptr) {
+        continue;
+      }
+
+      const auto incremental_type = incremental_types.find(output);
+      if (incremental_type == incremental_types.end() ||
+          incremental_type->second != output->TypeAsProto()->SerializeAsString()) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Incremental resolve did not infer the type and shape of output '",
+                               output->Name(), "' of node '", node.Name(), "' that a full resolve infers.");
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
 Status Graph::VerifyInputAndInitializerNames() {
   std::unordered_set<std::string_view>& inputs_and_initializers = resolve_context_.inputs_and_initializers;
 
@@ -3414,6 +3600,17 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_.emplace(tensor.name(), tensor_added);
   SetGraphResolveNeeded();
+#if !defined(ORT_MINIMAL_BUILD)
+  initializer_data_hashes_.erase(tensor.name());
+  const Graph* main_graph = this;
+  while (main_graph->parent_graph_ != nullptr) {
+    main_graph = main_graph->parent_graph_;
+  }
+
+  if (main_graph->incremental_resolve_) {
+    ORT_IGNORE_RETURN_VALUE(GetInitializerDataHash(tensor.name(), *tensor_added));
+  }
+#endif
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
@@ -3504,6 +3701,9 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
 #if !defined(DISABLE_SPARSE_TENSORS)
     sparse_tensor_names_.erase(tensor_name);
 #endif
+#if !defined(ORT_MINIMAL_BUILD)
+    initializer_data_hashes_.erase(tensor_name);
+#endif
 
     // doesn't matter if it existed or not
     ORT_IGNORE_RETURN_VALUE(ortvalue_initializers_.erase(tensor_name));
@@ -3564,6 +3764,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
   ORT_ENFORCE(existing_entry != mutable_initializers.pointer_end(),
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
+  initializer_data_hashes_.erase(initializer_name);
   **existing_entry = std::move(new_initializer);
 
   return Status::OK();
@@ -3634,6 +3835,7 @@ Status Graph::InjectExternalInitializersFromFilesInMemory(
                            OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator));
       auto new_tensor_proto = utils::TensorToTensorProto(tensor, tensor_name);
       **existing_entry = std::move(new_tensor_proto);
+      initializer_data_hashes_.erase(tensor_name);
     }
   }
 
@@ -3665,6 +3867,9 @@ bool Graph::GetOrtValueInitializer(const std::string& name, OrtValue& value) con
 
 void Graph::CleanAllInitializedTensors() noexcept {
   name_to_initial_tensor_.clear();
+#if !defined(ORT_MINIMAL_BUILD)
+  initializer_data_hashes_.clear();
+#endif
 #if !defined(DISABLE_SPARSE_TENSORS)
   sparse_tensor_names_.clear();
 #endif
@@ -5037,6 +5242,7 @@ Status Graph::InlineIfSubgraph(bool condition_value, Node& if_node, const loggin
 #endif
 
     graph_to_inline.name_to_initial_tensor_.erase(src_name);
+    graph_to_inline.initializer_data_hashes_.erase(src_name);
     const gsl::not_null<TensorProto*> tensor{graph_proto_->add_initializer()};
     *tensor = std::move(*initializer);
 
@@ -0,0 +1,296 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/activation_recompute.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/framework/session_options.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+// Deterministic element-wise nodes that are cheap compared with keeping their output alive.
+bool IsRecomputableOpType(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "LeakyRelu", {6, 16}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Erf", {9, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Cast", {6, 9, 13, 19, 21}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Clip", {6, 11, 12, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Where", {9, 16}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "BiasGelu", {1}, kMSDomain) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "QuickGelu", {1}, kMSDomain);
+}
+
+// Nodes whose output reuses the buffer of their first input on CPU.
+bool IsAliasOpType(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Reshape", {5, 13, 14, 19, 21}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Squeeze", {1, 11, 13, 21}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Unsqueeze", {1, 11, 13, 21}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Flatten", {1, 9, 11, 13, 21}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Identity", {1, 13, 14, 16, 19, 21});
+}
+
+// Size of a tensor with a static shape, or 0 if it is unknown.
+size_t EstimateSizeInBytes(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() ||
+      type->tensor_type().elem_type() == TensorProto_DataType_STRING) {
+    return 0;
+  }
+
+  size_t size = 0;
+  if (!utils::GetSizeInBytesFromTensorTypeProto<0>(type->tensor_type(), &size).IsOK()) {
+    return 0;
+  }
+
+  return size;
+}
+
+struct Consumer {
+  Node* node;
+  size_t position;
+};
+
+// A buffer is an activation with the activations that alias it. It is alive from the step that produces it to
+// the last step that reads it or one of its aliases.
+struct Buffer {
+  size_t bytes;
+  size_t first;
+  size_t last;
+  bool aliased;
+  // direct consumers of the activation owning the buffer
+  std::vector<Consumer> consumers;
+};
+
+struct Liveness {
+  InlinedHashMap<const NodeArg*, const NodeArg*> buffer_of;
+  InlinedHashMap<const NodeArg*, Buffer> buffers;
+  size_t peak_bytes = 0;
+  size_t peak_position = 0;
+};
+
+Liveness ComputeLiveness(Graph& graph, const std::vector<NodeIndex>& order) {
+  Liveness liveness;
+  InlinedHashSet<const NodeArg*> graph_outputs(graph.GetOutputs().begin(), graph.GetOutputs().end());
+
+  for (size_t position = 0; position < order.size(); ++position) {
+    Node* node = graph.GetNode(order[position]);
+
+    auto add_use = [&](const NodeArg* input, bool direct) {
+      auto buffer_of = liveness.buffer_of.find(input);
+      if (buffer_of == liveness.buffer_of.end()) {
+        return;  // initializer, graph input or outer scope value
+      }
+
+      auto& buffer = liveness.buffers[buffer_of->second];
+      buffer.last = std::max(buffer.last, position);
+      if (direct && buffer_of->second == input) {
+        buffer.consumers.push_back(Consumer{node, position});
+      }
+    };
+
+    for (const auto* input : node->InputDefs()) {
+      if (input->Exists()) {
+        add_use(input, true);
+      }
+    }
+    for (const auto* input : node->ImplicitInputDefs()) {
+      add_use(input, false);
+    }
+
+    const bool alias = IsAliasOpType(*node) && !node->InputDefs().empty() &&
+                       liveness.buffer_of.count(node->InputDefs()[0]) != 0;
+    for (const auto* output : node->OutputDefs()) {
+      if (!output->Exists()) {
+        continue;
+      }
+
+      if (alias) {
+        const NodeArg* buffer_owner = liveness.buffer_of[node->InputDefs()[0]];
+        liveness.buffer_of[output] = buffer_owner;
+        liveness.buffers[buffer_owner].aliased = true;
+      } else {
+        liveness.buffer_of[output] = output;
+        liveness.buffers[output] = Buffer{EstimateSizeInBytes(*output), position, position, false, {}};
+      }
+
+      if (graph_outputs.count(output) != 0) {
+        liveness.buffers[liveness.buffer_of[output]].last = order.size();
+      }
+    }
+  }
+
+  std::vector<int64_t> deltas(order.size() + 2, 0);
+  for (const auto& entry : liveness.buffers) {
+    deltas[entry.second.first] += static_cast<int64_t>(entry.second.bytes);
+    deltas[entry.second.last + 1] -= static_cast<int64_t>(entry.second.bytes);
+  }
+
+  int64_t live_bytes = 0;
+  for (size_t position = 0; position < order.size(); ++position) {
+    live_bytes += deltas[position];
+    if (static_cast<size_t>(live_bytes) > liveness.peak_bytes) {
+      liveness.peak_bytes = static_cast<size_t>(live_bytes);
+      liveness.peak_position = position;
+    }
+  }
+
+  return liveness;
+}
+
+struct Candidate {
+  const NodeArg* activation = nullptr;
+  Node* producer = nullptr;
+  size_t bytes = 0;
+  // consumers after the peak, which read the recomputed activation
+  std::vector<Consumer> late_consumers;
+};
+
+}  // namespace
+
+Status ActivationRecompute::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                      const logging::Logger& logger) const {
+  // The budget applies to the main graph. Subgraphs run within the lifetime of their parent node.
+  if (graph.IsSubgraph()) {
+    return Status::OK();
+  }
+
+  InlinedHashSet<const NodeArg*> graph_outputs(graph.GetOutputs().begin(), graph.GetOutputs().end());
+  InlinedHashSet<std::string> visited;
+
+  while (true) {
+    GraphViewer graph_viewer(graph);
+    const auto& order = graph_viewer.GetNodesInTopologicalOrder(ExecutionOrder::PRIORITY_BASED);
+    Liveness liveness = ComputeLiveness(graph, order);
+    if (liveness.peak_bytes <= memory_budget_) {
+      break;
+    }
+
+    const size_t peak = liveness.peak_position;
+    Candidate best;
+    for (const auto& entry : liveness.buffers) {
+      const NodeArg* activation = entry.first;
+      const Buffer& buffer = entry.second;
+      if (buffer.bytes <= best.bytes || buffer.aliased || buffer.first >= peak || buffer.last <= peak ||
+          graph_outputs.count(activation) != 0 || visited.count(activation->Name()) != 0) {
+        continue;
+      }
+
+      Node* producer = graph.GetMutableProducerNode(activation->Name());
+      if (producer == nullptr || producer->OutputDefs().size() != 1 || !IsRecomputableOpType(*producer) ||
+          !graph_utils::IsSupportedProvider(*producer, GetCompatibleExecutionProviders())) {
+        continue;
+      }
+
+      // the activation must be used before the peak, unused at the peak, and every late use must read it directly.
+      // without an early use the original would be left without consumers.
+      std::vector<Consumer> late_consumers;
+      size_t direct_last = 0;
+      bool used_before_peak = false;
+      bool used_at_peak = false;
+      for (const auto& consumer : buffer.consumers) {
+        used_before_peak |= consumer.position < peak;
+        used_at_peak |= consumer.position == peak;
+        direct_last = std::max(direct_last, consumer.position);
+        if (consumer.position > peak) {
+          late_consumers.push_back(consumer);
+        }
+      }
+      if (!used_before_peak || used_at_peak || late_consumers.empty() || direct_last != buffer.last) {
+        continue;
+      }
+
+      size_t first_late = buffer.last;
+      for (const auto& consumer : late_consumers) {
+        first_late = std::min(first_late, consumer.position);
+      }
+
+      // the inputs of the producer must be alive when the copy runs, otherwise their lifetime would grow
+      bool inputs_alive = true;
+      for (const auto* input : producer->InputDefs()) {
+        auto buffer_of = input->Exists() ? liveness.buffer_of.find(input) : liveness.buffer_of.end();
+        if (buffer_of != liveness.buffer_of.end() && liveness.buffers.at(buffer_of->second).last < first_late) {
+          inputs_alive = false;
+          break;
+        }
+      }
+      if (!inputs_alive) {
+        continue;
+      }
+
+      best = Candidate{activation, producer, buffer.bytes, std::move(late_consumers)};
+    }
+
+    if (best.activation == nullptr) {
+      LOGS(logger, WARNING) << "Estimated peak activation memory of " << liveness.peak_bytes
+                            << " bytes is above the budget of " << memory_budget_
+                            << " bytes and no remaining activation can be recomputed.";
+      break;
+    }
+
+    visited.insert(best.activation->Name());
+
+    Node& producer = *best.producer;
+    auto& recomputed = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(best.activation->Name() + "_recompute"),
+                                                best.activation->TypeAsProto());
+    visited.insert(recomputed.Name());
+
+    Node& recompute_node = graph.AddNode(graph.GenerateNodeName(producer.Name() + "_recompute"),
+                                         producer.OpType(),
+                                         "Recompute of " + producer.Name() + " to meet the activation memory budget",
+                                         producer.MutableInputDefs(),
+                                         {&recomputed},
+                                         &producer.GetAttributes(),
+                                         producer.Domain());
+    recompute_node.SetExecutionProviderType(producer.GetExecutionProviderType());
+    // the priority based order schedules the copy as late as possible, right before its first consumer
+    recompute_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+
+    for (auto it = producer.InputEdgesBegin(), end = producer.InputEdgesEnd(); it != end; ++it) {
+      graph.AddEdge(it->GetNode().Index(), recompute_node.Index(), it->GetSrcArgIndex(), it->GetDstArgIndex());
+    }
+
+    for (const auto& consumer : best.late_consumers) {
+      Node& node = *consumer.node;
+      const auto& input_defs = node.InputDefs();
+      for (int i = 0, end = static_cast<int>(input_defs.size()); i < end; ++i) {
+        if (input_defs[i] != best.activation) {
+          continue;
+        }
+
+        graph.RemoveEdge(producer.Index(), node.Index(), 0, i);
+        graph_utils::ReplaceNodeInput(node, i, recomputed);
+        graph.AddEdge(recompute_node.Index(), node.Index(), 0, i);
+      }
+    }
+
+    LOGS(logger, VERBOSE) << "Recomputing " << best.activation->Name() << " (" << best.bytes << " bytes) to lower "
+                          << "the estimated peak activation memory of " << liveness.peak_bytes << " bytes.";
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
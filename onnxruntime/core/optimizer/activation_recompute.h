@@ -0,0 +1,38 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ActivationRecompute
+
+Graph transformer that bounds the estimated peak activation memory of an inference graph.
+
+The activations are sized from their static shapes and their lifetimes follow the priority based execution order.
+While the peak is above the budget, the largest activation that is alive at the peak without being used there and
+whose producer is a cheap element-wise node is recomputed: the producer is duplicated with a low priority and the
+consumers after the peak read the copy, so the original is released early. A producer is only duplicated if its own
+inputs are alive until the copy runs anyway, so the recomputation never extends another lifetime.
+
+Activations with a symbolic dimension have no static size and are ignored. Free dimension overrides make such
+dimensions fixed before this transformer runs.
+*/
+class ActivationRecompute : public GraphTransformer {
+ public:
+  ActivationRecompute(size_t memory_budget,
+                      const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ActivationRecompute", compatible_execution_providers), memory_budget_(memory_budget) {}
+
+  bool ShouldOnlyApplyOnce() const override { return true; }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const size_t memory_budget_;
+};
+
+}  // namespace onnxruntime
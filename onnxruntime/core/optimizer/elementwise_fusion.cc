@@ -0,0 +1,254 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_fusion.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+namespace {
+
+bool IsFusableOpType(const Node& node) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Exp", {6, 13}) ||
+         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13});
+}
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Dimensions match if they have the same value or the same symbolic name.
+bool SameShape(const TensorShapeProto& lhs, const TensorShapeProto& rhs) {
+  if (lhs.dim_size() != rhs.dim_size()) {
+    return false;
+  }
+
+  for (int i = 0; i < lhs.dim_size(); ++i) {
+    const auto& lhs_dim = lhs.dim(i);
+    const auto& rhs_dim = rhs.dim(i);
+    if (utils::HasDimValue(lhs_dim) && utils::HasDimValue(rhs_dim)) {
+      if (lhs_dim.dim_value() != rhs_dim.dim_value()) {
+        return false;
+      }
+    } else if (utils::HasDimParam(lhs_dim) && utils::HasDimParam(rhs_dim)) {
+      if (lhs_dim.dim_param() != rhs_dim.dim_param()) {
+        return false;
+      }
+    } else {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool IsSingleElement(const TensorShapeProto& shape) {
+  for (const auto& dim : shape.dim()) {
+    if (!utils::HasDimValue(dim) || dim.dim_value() != 1) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns the output shape of a node that can be fused, or nullptr if it can't be.
+const TensorShapeProto* GetFusableShape(const Node& node,
+                                        const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!IsFusableOpType(node) || !graph_utils::IsSupportedProvider(node, compatible_providers) ||
+      node.OutputDefs().size() != 1) {
+    return nullptr;
+  }
+
+  const NodeArg& output = *node.OutputDefs()[0];
+  if (!IsFloatTensor(output) || output.Shape() == nullptr || IsSingleElement(*output.Shape())) {
+    return nullptr;
+  }
+
+  const TensorShapeProto& shape = *output.Shape();
+  for (const NodeArg* input : node.InputDefs()) {
+    if (!input->Exists() || !IsFloatTensor(*input) || input->Shape() == nullptr) {
+      return nullptr;
+    }
+
+    const TensorShapeProto& input_shape = *input->Shape();
+    if (!SameShape(input_shape, shape) &&
+        !(IsSingleElement(input_shape) && input_shape.dim_size() <= shape.dim_size())) {
+      return nullptr;
+    }
+  }
+
+  return &shape;
+}
+
+// Replaces the nodes of a group, given in topological order, by one FusedElementwise node.
+void FuseGroup(Graph& graph, gsl::span<const NodeIndex> group_nodes, const logging::Logger& logger) {
+  const InlinedHashSet<NodeIndex> members(group_nodes.begin(), group_nodes.end());
+
+  // registers 0 to inputs.size() - 1 hold the group inputs, followed by one register per node
+  InlinedVector<NodeArg*> inputs;
+  InlinedHashMap<const NodeArg*, int64_t> input_registers;
+  InlinedHashMap<const NodeArg*, int64_t> node_indices;
+  for (size_t i = 0; i < group_nodes.size(); ++i) {
+    node_indices[graph.GetNode(group_nodes[i])->OutputDefs()[0]] = static_cast<int64_t>(i);
+  }
+
+  for (const NodeIndex node_index : group_nodes) {
+    for (NodeArg* input : graph.GetNode(node_index)->MutableInputDefs()) {
+      if (node_indices.count(input) == 0 && input_registers.count(input) == 0) {
+        input_registers[input] = static_cast<int64_t>(inputs.size());
+        inputs.push_back(input);
+      }
+    }
+  }
+
+  const auto num_inputs = static_cast<int64_t>(inputs.size());
+  auto register_of = [&](const NodeArg* arg) {
+    const auto node_index = node_indices.find(arg);
+    return node_index != node_indices.end() ? num_inputs + node_index->second : input_registers.at(arg);
+  };
+
+  std::vector<std::string> ops;
+  std::vector<int64_t> operands;
+  std::vector<int64_t> output_registers;
+  InlinedVector<NodeArg*> outputs;
+  for (size_t i = 0; i < group_nodes.size(); ++i) {
+    Node& node = *graph.GetNode(group_nodes[i]);
+    const auto& node_inputs = node.InputDefs();
+    ops.push_back(node.OpType());
+    operands.push_back(register_of(node_inputs[0]));
+    operands.push_back(node_inputs.size() > 1 ? register_of(node_inputs[1]) : -1);
+
+    // values used after the group become outputs of the fused node
+    NodeArg* output = node.MutableOutputDefs()[0];
+    bool used_outside = graph.IsOutput(output);
+    for (const Node* consumer : graph.GetConsumerNodes(output->Name())) {
+      used_outside = used_outside || members.count(consumer->Index()) == 0;
+    }
+
+    if (used_outside) {
+      outputs.push_back(output);
+      output_registers.push_back(num_inputs + static_cast<int64_t>(i));
+    }
+  }
+
+  const Node& first_node = *graph.GetNode(group_nodes[0]);
+  const std::string fused_name = graph.GenerateNodeName(first_node.Name() + "/FusedElementwise");
+  const std::string execution_provider = first_node.GetExecutionProviderType();
+
+  // remove the nodes before adding the fused node, which takes over their outputs
+  for (auto it = group_nodes.rbegin(); it != group_nodes.rend(); ++it) {
+    Node& node = *graph.GetNode(*it);
+    graph_utils::RemoveNodeOutputEdges(graph, node);
+    graph.RemoveNode(node.Index());
+  }
+
+  Node& fused_node = graph.AddNode(fused_name, "FusedElementwise", "Fused element-wise nodes", inputs, outputs,
+                                   nullptr, kMSDomain);
+  fused_node.AddAttribute("ops", ops);
+  fused_node.AddAttribute("operands", operands);
+  fused_node.AddAttribute("outputs", output_registers);
+  fused_node.SetExecutionProviderType(execution_provider);
+
+  LOGS(logger, VERBOSE) << "Fused " << group_nodes.size() << " element-wise nodes into " << fused_name;
+}
+
+struct Group {
+  const TensorShapeProto* shape;
+  size_t first_position;            // position of the first node in topological order
+  InlinedVector<NodeIndex> nodes;  // in topological order
+};
+
+}  // namespace
+
+Status ElementwiseFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  std::vector<Group> groups;
+  InlinedHashMap<NodeIndex, size_t> position_of_node;
+  InlinedHashMap<NodeIndex, size_t> group_of_node;
+
+  for (size_t position = 0; position < node_topology_list.size(); ++position) {
+    const NodeIndex node_index = node_topology_list[position];
+    Node* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) {
+      continue;
+    }
+
+    Node& node = *p_node;
+    position_of_node[node_index] = position;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const TensorShapeProto* shape = GetFusableShape(node, GetCompatibleExecutionProviders());
+    if (shape == nullptr) {
+      continue;
+    }
+
+    // Join the group of a producer if every other input of the node is produced by that group or before the group
+    // starts. Then every edge between the fused nodes goes forward in the original topological order, so fusing
+    // can't create a cycle.
+    std::optional<size_t> joined_group;
+    for (auto edge = node.InputEdgesBegin(); edge != node.InputEdgesEnd() && !joined_group; ++edge) {
+      const auto producer_group = group_of_node.find(edge->GetNode().Index());
+      if (producer_group == group_of_node.end() || !SameShape(*groups[producer_group->second].shape, *shape)) {
+        continue;
+      }
+
+      const Group& group = groups[producer_group->second];
+      bool can_join = true;
+      for (auto other = node.InputEdgesBegin(); other != node.InputEdgesEnd() && can_join; ++other) {
+        const NodeIndex other_index = other->GetNode().Index();
+        const auto other_group = group_of_node.find(other_index);
+        const bool in_group = other_group != group_of_node.end() && other_group->second == producer_group->second;
+        can_join = in_group || position_of_node[other_index] < group.first_position;
+      }
+
+      if (can_join) {
+        joined_group = producer_group->second;
+      }
+    }
+
+    if (joined_group) {
+      groups[*joined_group].nodes.push_back(node_index);
+      group_of_node[node_index] = *joined_group;
+    } else {
+      group_of_node[node_index] = groups.size();
+      groups.push_back(Group{shape, position, {node_index}});
+    }
+  }
+
+  for (const Group& group : groups) {
+    if (group.nodes.size() < 2) {
+      continue;
+    }
+
+    FuseGroup(graph, group.nodes, logger);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,33 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseFusion
+
+Graph transformer that collapses connected float element-wise nodes (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Neg,
+Abs, Exp, Sqrt) into one com.microsoft.FusedElementwise node, so the intermediate values of the chain stay in cache
+instead of going through memory once per node.
+
+A node is fused when the shapes of its output and inputs are known, its output has the shape shared by the whole
+group, and each input either has that shape or holds a single element (a broadcast scalar). Groups may be chains or
+DAGs with several outputs. A node only joins a group if all its inputs from outside the group are produced before the
+first node of the group, which keeps the graph acyclic after fusion.
+
+It runs after the pattern based fusions so that those keep the nodes they match.
+*/
+class ElementwiseFusion : public GraphTransformer {
+ public:
+  ElementwiseFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseFusion", compatible_execution_providers) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -19,6 +19,7 @@
 #if !defined(ORT_MINIMAL_BUILD)
 
 #include "core/mlas/inc/mlas.h"
+#include "core/optimizer/activation_recompute.h"
 #include "core/optimizer/attention_fusion.h"
 #include "core/optimizer/bias_dropout_fusion.h"
 #include "core/optimizer/bias_gelu_fusion.h"
@@ -35,6 +36,7 @@
 #include "core/optimizer/double_qdq_pairs_remover.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
@@ -55,6 +57,7 @@
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
+#include "core/optimizer/matmul_weight_quantization.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
@@ -334,6 +337,17 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                                                  p_buffered_tensors));
       }
 
+      // Load time weight quantization of float MatMul/Gemm. It runs before the fusions that would turn these nodes
+      // into FusedGemm/FusedMatMul, and MatMulNBitsFusion below folds a following bias Add into the MatMulNBits.
+      auto weight_quantization_options =
+          MatMulWeightQuantizationOptions::FromConfigOptions(session_options.config_options);
+      if (weight_quantization_options.bits != 0) {
+        transformers.emplace_back(std::make_unique<MatMulWeightQuantization>(std::move(weight_quantization_options),
+                                                                             intra_op_thread_pool,
+                                                                             p_buffered_tensors,
+                                                                             cpu_ep));
+      }
+
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_dml_acl_eps));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_acl_eps));
@@ -417,8 +431,30 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // PR #6351 implemented similar fusion-pattern for CUDA only, and can only fuse conv-add-relu,
       // while we can fuse more activation.
       transformers.emplace_back(std::make_unique<ConvAddActivationFusion>(cpu_ep));
+
+      // Generic fusion of the remaining element-wise nodes. It runs last so that the pattern based fusions above
+      // (e.g. Conv+Add+Relu, BiasGelu) still see the nodes they match.
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseFusion, "0") == "1") {
+        transformers.emplace_back(std::make_unique<ElementwiseFusion>(cpu_ep));
+      }
 #endif
 
+      // Recomputation for the activation memory budget runs last so that it sees the final nodes. It relies on the
+      // priority based execution order to run the recomputed nodes late.
+      const auto activation_memory_budget = ParseStringWithClassicLocale<int64_t>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsActivationMemoryBudgetInBytes, "0"));
+      ORT_ENFORCE(activation_memory_budget >= 0, kOrtSessionOptionsActivationMemoryBudgetInBytes,
+                  " must not be negative. Got ", activation_memory_budget);
+      if (activation_memory_budget > 0) {
+        if (session_options.execution_order == ExecutionOrder::PRIORITY_BASED) {
+          transformers.emplace_back(std::make_unique<ActivationRecompute>(
+              static_cast<size_t>(activation_memory_budget), cpu_ep));
+        } else {
+          LOGS(logger, WARNING) << kOrtSessionOptionsActivationMemoryBudgetInBytes
+                                << " is ignored as it requires the priority based execution order.";
+        }
+      }
+
     } break;
 
     default:
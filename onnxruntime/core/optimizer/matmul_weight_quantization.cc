@@ -0,0 +1,339 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/matmul_weight_quantization.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "core/common/parse_string.h"
+#include "core/common/string_utils.h"
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/graph/node_attr_utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/mlas/inc/mlas_q4.h"
+#include "core/optimizer/initializer.h"
+#include "core/platform/threadpool.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+
+MatMulWeightQuantizationOptions MatMulWeightQuantizationOptions::FromConfigOptions(
+    const ConfigOptions& config_options) {
+  MatMulWeightQuantizationOptions options;
+  options.bits = ParseStringWithClassicLocale<int64_t>(
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantizationBits, "0"));
+  ORT_ENFORCE(options.bits == 0 || options.bits == 4 || options.bits == 8,
+              kOrtSessionOptionsMatMulWeightQuantizationBits, " must be 0, 4 or 8. Got ", options.bits);
+
+  options.block_size = ParseStringWithClassicLocale<int64_t>(
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantizationBlockSize, "32"));
+  ORT_ENFORCE(options.block_size >= 16 && options.block_size <= 256 &&
+                  (options.block_size & (options.block_size - 1)) == 0,
+              kOrtSessionOptionsMatMulWeightQuantizationBlockSize,
+              " must be a power of 2 between 16 and 256. Got ", options.block_size);
+
+  options.accuracy_level = ParseStringWithClassicLocale<int64_t>(
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantizationAccuracyLevel, "4"));
+  ORT_ENFORCE(options.accuracy_level >= 0 && options.accuracy_level <= 4,
+              kOrtSessionOptionsMatMulWeightQuantizationAccuracyLevel, " must be between 0 and 4. Got ",
+              options.accuracy_level);
+
+  const std::string excluded_nodes =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantizationExcludedNodes, "");
+  for (const auto& name : utils::SplitString(excluded_nodes, ";")) {
+    options.excluded_nodes.emplace(name);
+  }
+
+  // Entries look like "node_name:level". Node names may contain ':', so split on the last one.
+  const std::string node_accuracy_levels =
+      config_options.GetConfigOrDefault(kOrtSessionOptionsMatMulWeightQuantizationNodeAccuracyLevels, "");
+  for (const auto& entry : utils::SplitString(node_accuracy_levels, ";")) {
+    const auto separator = entry.rfind(':');
+    ORT_ENFORCE(separator != std::string_view::npos && separator > 0,
+                kOrtSessionOptionsMatMulWeightQuantizationNodeAccuracyLevels,
+                " entries must have the form node_name:level. Got ", entry);
+    const auto level = ParseStringWithClassicLocale<int64_t>(entry.substr(separator + 1));
+    ORT_ENFORCE(level >= 0 && level <= 4, "Accuracy level of node ", entry.substr(0, separator),
+                " must be between 0 and 4. Got ", level);
+    options.node_accuracy_levels[std::string(entry.substr(0, separator))] = level;
+  }
+
+  return options;
+}
+
+namespace {
+
+// Initializers replacing one float weight. zero_points is nullptr when the quantization is symmetric.
+struct QuantizedWeight {
+  NodeArg* data = nullptr;
+  NodeArg* scales = nullptr;
+  NodeArg* zero_points = nullptr;
+};
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() && type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Gemm is a MatMul with a bias when transA is 0, alpha is 1 and C is absent or a constant [N] bias with beta 1.
+// trans_b and bias are set for a matched Gemm.
+bool IsSupportedGemm(const Graph& graph, const Node& node, bool& trans_b, const NodeArg*& bias) {
+  const auto* trans_a_attr = graph_utils::GetNodeAttribute(node, "transA");
+  const auto* trans_b_attr = graph_utils::GetNodeAttribute(node, "transB");
+  const auto* alpha_attr = graph_utils::GetNodeAttribute(node, "alpha");
+  const auto* beta_attr = graph_utils::GetNodeAttribute(node, "beta");
+  if ((trans_a_attr != nullptr && trans_a_attr->i() != 0) || (alpha_attr != nullptr && alpha_attr->f() != 1.0f)) {
+    return false;
+  }
+
+  trans_b = trans_b_attr != nullptr && trans_b_attr->i() != 0;
+  bias = nullptr;
+
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() > 2 && input_defs[2]->Exists()) {
+    const auto* c_proto = graph_utils::GetConstantInitializer(graph, input_defs[2]->Name());
+    if (c_proto == nullptr || c_proto->data_type() != TensorProto_DataType_FLOAT || c_proto->dims_size() != 1 ||
+        (beta_attr != nullptr && beta_attr->f() != 1.0f)) {
+      return false;
+    }
+
+    bias = input_defs[2];
+  }
+
+  return true;
+}
+
+Status AddQuantizedInitializer(Graph& graph, std::unique_ptr<Tensor> tensor, const std::string& name,
+                               std::unordered_map<std::string, std::unique_ptr<Tensor>>* p_buffered_tensors,
+                               NodeArg*& node_arg) {
+  auto tensor_proto = utils::TensorToTensorProto(*tensor, name, p_buffered_tensors != nullptr);
+  node_arg = &graph_utils::AddInitializer(graph, tensor_proto);
+
+  // A large tensor proto points at the buffer of the tensor instead of copying it, so the tensor has to be kept
+  // alive for the session.
+  if (tensor_proto.data_location() == TensorProto_DataLocation_EXTERNAL) {
+    ORT_RETURN_IF_NOT(p_buffered_tensors->emplace(name, std::move(tensor)).second,
+                      "Failed to add buffered tensor ", name);
+  }
+
+  return Status::OK();
+}
+
+// Block-wise 4 bits quantization in the MatMulNBits layout: data [N, blocks, block_size / 2], scales and zero points
+// flattened from [N, blocks] with two zero points per byte.
+Status QuantizeWeightTo4Bits(Graph& graph, const NodeArg& weight_arg, const float* weight, bool trans_b,
+                             int64_t K, int64_t N, int64_t block_size, concurrency::ThreadPool* thread_pool,
+                             std::unordered_map<std::string, std::unique_ptr<Tensor>>* p_buffered_tensors,
+                             QuantizedWeight& quantized) {
+  const int64_t block_count = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size / 2;
+
+  // MLAS expects a [K, N] source, so a transposed Gemm weight is transposed back first.
+  std::vector<float> transposed;
+  if (trans_b) {
+    transposed.resize(narrow<size_t>(K * N));
+    MlasTranspose(weight, transposed.data(), narrow<size_t>(N), narrow<size_t>(K));
+    weight = transposed.data();
+  }
+
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+  auto data = std::make_unique<Tensor>(DataTypeImpl::GetType<uint8_t>(), TensorShape{N, block_count, blob_size},
+                                       cpu_allocator);
+  auto scales = std::make_unique<Tensor>(DataTypeImpl::GetType<float>(), TensorShape{N * block_count},
+                                         cpu_allocator);
+  auto zero_points = std::make_unique<Tensor>(DataTypeImpl::GetType<uint8_t>(),
+                                              TensorShape{N * ((block_count + 1) / 2)}, cpu_allocator);
+
+  MlasQuantizeBlockwise<float, 4>(data->MutableData<uint8_t>(),
+                                  scales->MutableData<float>(),
+                                  zero_points->MutableData<uint8_t>(),
+                                  weight,
+                                  static_cast<int>(block_size),
+                                  true,
+                                  static_cast<int>(K),
+                                  static_cast<int>(N),
+                                  static_cast<int>(N),
+                                  thread_pool);
+
+  ORT_RETURN_IF_ERROR(AddQuantizedInitializer(graph, std::move(data),
+                                              graph.GenerateNodeArgName(weight_arg.Name() + "_Q4"),
+                                              p_buffered_tensors, quantized.data));
+  ORT_RETURN_IF_ERROR(AddQuantizedInitializer(graph, std::move(scales),
+                                              graph.GenerateNodeArgName(weight_arg.Name() + "_scales"),
+                                              p_buffered_tensors, quantized.scales));
+  ORT_RETURN_IF_ERROR(AddQuantizedInitializer(graph, std::move(zero_points),
+                                              graph.GenerateNodeArgName(weight_arg.Name() + "_zero_points"),
+                                              p_buffered_tensors, quantized.zero_points));
+  return Status::OK();
+}
+
+// Symmetric per column int8 quantization in the DynamicQuantizeMatMul layout: data [K, N] and scales [N].
+Status QuantizeWeightTo8Bits(Graph& graph, const NodeArg& weight_arg, const float* weight, bool trans_b,
+                             int64_t K, int64_t N, concurrency::ThreadPool* thread_pool,
+                             std::unordered_map<std::string, std::unique_ptr<Tensor>>* p_buffered_tensors,
+                             QuantizedWeight& quantized) {
+  auto cpu_allocator = std::make_shared<CPUAllocator>();
+  auto data = std::make_unique<Tensor>(DataTypeImpl::GetType<int8_t>(), TensorShape{K, N}, cpu_allocator);
+  auto scales = std::make_unique<Tensor>(DataTypeImpl::GetType<float>(), TensorShape{N}, cpu_allocator);
+  int8_t* data_ptr = data->MutableData<int8_t>();
+  float* scales_ptr = scales->MutableData<float>();
+
+  const ptrdiff_t k_stride = trans_b ? 1 : narrow<ptrdiff_t>(N);
+  const ptrdiff_t n_stride = trans_b ? narrow<ptrdiff_t>(K) : 1;
+  // Each column is read twice: once for its range, once to quantize it.
+  const double column_size = static_cast<double>(K);
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, narrow<std::ptrdiff_t>(N),
+      TensorOpCost{column_size * 2.0 * sizeof(float), column_size, column_size * 4.0},
+      [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t n = begin; n < end; ++n) {
+          const float* column = weight + n * n_stride;
+          float max_abs = 0.0f;
+          for (int64_t k = 0; k < K; ++k) {
+            max_abs = std::max(max_abs, std::fabs(column[k * k_stride]));
+          }
+
+          const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+          scales_ptr[n] = scale;
+          for (int64_t k = 0; k < K; ++k) {
+            const float value = std::nearbyint(column[k * k_stride] / scale);
+            data_ptr[k * N + n] = static_cast<int8_t>(std::clamp(value, -127.0f, 127.0f));
+          }
+        }
+      });
+
+  ORT_RETURN_IF_ERROR(AddQuantizedInitializer(graph, std::move(data),
+                                              graph.GenerateNodeArgName(weight_arg.Name() + "_Q8"),
+                                              p_buffered_tensors, quantized.data));
+  ORT_RETURN_IF_ERROR(AddQuantizedInitializer(graph, std::move(scales),
+                                              graph.GenerateNodeArgName(weight_arg.Name() + "_scales"),
+                                              p_buffered_tensors, quantized.scales));
+  return Status::OK();
+}
+
+}  // namespace
+
+Status MatMulWeightQuantization::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                           const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // A weight can be shared by several nodes, possibly with different transB values.
+  std::map<std::pair<std::string, bool>, QuantizedWeight> quantized_weights;
+  size_t quantized_node_count = 0;
+
+  for (auto node_index : node_topology_list) {
+    auto* p_node = graph.GetNode(node_index);
+    if (p_node == nullptr) {
+      continue;  // node was removed
+    }
+
+    Node& node = *p_node;
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    const bool is_matmul = graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13});
+    if ((!is_matmul && !graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gemm", {7, 9, 11, 13})) ||
+        !graph_utils::IsSupportedProvider(node, GetCompatibleExecutionProviders()) ||
+        options_.excluded_nodes.count(node.Name()) > 0 || !IsFloatTensor(*node.InputDefs()[0])) {
+      continue;
+    }
+
+    bool trans_b = false;
+    const NodeArg* bias = nullptr;
+    if (!is_matmul && !IsSupportedGemm(graph, node, trans_b, bias)) {
+      continue;
+    }
+
+    const NodeArg& weight_arg = *node.InputDefs()[1];
+    const auto* weight_proto = graph_utils::GetConstantInitializer(graph, weight_arg.Name());
+    if (weight_proto == nullptr || weight_proto->data_type() != TensorProto_DataType_FLOAT ||
+        weight_proto->dims_size() != 2) {
+      continue;
+    }
+
+    const int64_t K = weight_proto->dims(trans_b ? 1 : 0);
+    const int64_t N = weight_proto->dims(trans_b ? 0 : 1);
+    if (K == 0 || N == 0) {
+      continue;
+    }
+
+    if (bias != nullptr) {
+      const auto* bias_proto = graph_utils::GetConstantInitializer(graph, bias->Name());
+      if (bias_proto->dims(0) != N) {
+        continue;
+      }
+    }
+
+    auto quantized_it = quantized_weights.find({weight_arg.Name(), trans_b});
+    if (quantized_it == quantized_weights.end()) {
+      Initializer weight(*weight_proto, graph.ModelPath());
+      QuantizedWeight quantized;
+      if (options_.bits == 4) {
+        ORT_RETURN_IF_ERROR(QuantizeWeightTo4Bits(graph, weight_arg, weight.data<float>(), trans_b, K, N,
+                                                  options_.block_size, intra_op_thread_pool_, p_buffered_tensors_,
+                                                  quantized));
+      } else {
+        ORT_RETURN_IF_ERROR(QuantizeWeightTo8Bits(graph, weight_arg, weight.data<float>(), trans_b, K, N,
+                                                  intra_op_thread_pool_, p_buffered_tensors_, quantized));
+      }
+
+      quantized_it = quantized_weights.emplace(std::make_pair(weight_arg.Name(), trans_b), quantized).first;
+    }
+
+    const QuantizedWeight& quantized = quantized_it->second;
+    NodeArg& empty_arg = graph.GetOrCreateNodeArg("", nullptr);
+    NodeArg* bias_arg = bias != nullptr ? const_cast<NodeArg*>(bias) : &empty_arg;
+
+    NodeAttributes attributes;
+    std::string op_type;
+    InlinedVector<NodeArg*> input_defs;
+    if (options_.bits == 4) {
+      const auto accuracy_level_it = options_.node_accuracy_levels.find(node.Name());
+      const int64_t accuracy_level = accuracy_level_it != options_.node_accuracy_levels.end()
+                                         ? accuracy_level_it->second
+                                         : options_.accuracy_level;
+      utils::SetNodeAttribute(utils::MakeAttribute("K", K), attributes);
+      utils::SetNodeAttribute(utils::MakeAttribute("N", N), attributes);
+      utils::SetNodeAttribute(utils::MakeAttribute("bits", static_cast<int64_t>(4)), attributes);
+      utils::SetNodeAttribute(utils::MakeAttribute("block_size", options_.block_size), attributes);
+      utils::SetNodeAttribute(utils::MakeAttribute("accuracy_level", accuracy_level), attributes);
+      op_type = "MatMulNBits";
+      input_defs = {node.MutableInputDefs()[0], quantized.data, quantized.scales, quantized.zero_points,
+                    &empty_arg, bias_arg};
+    } else {
+      op_type = "DynamicQuantizeMatMul";
+      input_defs = {node.MutableInputDefs()[0], quantized.data, quantized.scales, &empty_arg, bias_arg};
+    }
+
+    // Drop the trailing missing optional inputs.
+    while (!input_defs.back()->Exists()) {
+      input_defs.pop_back();
+    }
+
+    Node& quantized_node = graph.AddNode(graph.GenerateNodeName(node.Name() + "_" + op_type), op_type,
+                                         "Weight quantized " + node.OpType() + " " + node.Name(),
+                                         input_defs, node.MutableOutputDefs(), &attributes, kMSDomain);
+    quantized_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {node}, quantized_node);
+    ++quantized_node_count;
+    modified = true;
+  }
+
+  if (quantized_node_count > 0) {
+    LOGS(logger, INFO) << "MatMulWeightQuantization: quantized the weights of " << quantized_node_count
+                       << " nodes to " << options_.bits << " bits.";
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "core/framework/config_options.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+class Tensor;
+namespace concurrency {
+class ThreadPool;
+}
+
+/** Settings of MatMulWeightQuantization. They come from the session.matmul_weight_quantization_* config entries. */
+struct MatMulWeightQuantizationOptions {
+  // 0 disables the transformer, 4 rewrites to MatMulNBits, 8 rewrites to DynamicQuantizeMatMul.
+  int64_t bits = 0;
+  // Number of K elements sharing one scale and zero point in the 4 bits mode.
+  int64_t block_size = 32;
+  // accuracy_level of the MatMulNBits nodes, unless overridden in node_accuracy_levels.
+  int64_t accuracy_level = 4;
+  // Names of MatMul/Gemm nodes that keep their float weight.
+  InlinedHashSet<std::string> excluded_nodes;
+  // Per-node accuracy_level overrides, keyed by node name.
+  InlinedHashMap<std::string, int64_t> node_accuracy_levels;
+
+  /** Reads and validates the options. Throws if a value is invalid. */
+  static MatMulWeightQuantizationOptions FromConfigOptions(const ConfigOptions& config_options);
+};
+
+/**
+@Class MatMulWeightQuantization
+
+Graph transformer that quantizes the constant float weight of MatMul and Gemm nodes when the session is loaded, so a
+float model can use the quantized CPU kernels without an offline quantization step.
+
+With 4 bits the weight is quantized block-wise along K (asymmetric, one scale and zero point per block) and the node
+is replaced by com.microsoft.MatMulNBits. With 8 bits the weight is quantized symmetrically per output column to int8
+and the node is replaced by com.microsoft.DynamicQuantizeMatMul.
+
+Gemm is handled when transA is 0, alpha is 1 and C is absent or is a constant 1-D bias of size N with beta 1.
+A weight shared by several nodes is quantized once.
+*/
+class MatMulWeightQuantization : public GraphTransformer {
+ public:
+  MatMulWeightQuantization(MatMulWeightQuantizationOptions options,
+                           concurrency::ThreadPool* intra_op_thread_pool,
+                           std::unordered_map<std::string, std::unique_ptr<Tensor>>* p_buffered_tensors,
+                           const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulWeightQuantization", compatible_execution_providers),
+        options_(std::move(options)),
+        intra_op_thread_pool_(intra_op_thread_pool),
+        p_buffered_tensors_(p_buffered_tensors) {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const MatMulWeightQuantizationOptions options_;
+  concurrency::ThreadPool* intra_op_thread_pool_;
+  std::unordered_map<std::string, std::unique_ptr<Tensor>>* p_buffered_tensors_;
+};
+
+}  // namespace onnxruntime
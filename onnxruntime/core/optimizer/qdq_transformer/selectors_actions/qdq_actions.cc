@@ -93,6 +93,28 @@ std::vector<NodeAndMoveInfo> WhereMoves() {
       MoveAll(q, ArgType::kOutput)};
   return moves;
 }
+
+// replacer for a LayerNormalization node with a DQ input for X. the float scale and bias stay float.
+ReplaceWithQLinear LayerNormalizationReplacer(bool has_bias) {
+  NTO::NodeLocation dq_x{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+  NTO::NodeLocation q{NTO::NodeType::kOutput, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAll(dq_x, ArgType::kInput),                               // append all inputs from x
+      MoveAndAppend(q, ArgType::kInput, 1, ArgType::kInput),        // append scale (input 1) from q
+      MoveAndAppend(q, ArgType::kInput, 2, ArgType::kInput),        // append zp (input 2) from q
+      MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput)};  // append the float scale
+
+  if (has_bias) {
+    moves.push_back(MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput));  // append the float bias
+  }
+
+  moves.push_back(MoveAll(q, ArgType::kOutput));
+
+  return ReplaceWithQLinear(kMSDomain, std::move(moves));
+}
+
 QDQReplaceWithNew SplitReplacer(bool has_split_as_input) {
   NTO::NodeLocation dq{NTO::NodeType::kInput, 0};
   NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
@@ -267,6 +289,12 @@ Status SplitReplaceWithQuant::Run(Graph& graph, const NodesToOptimize& selected_
   return SplitReplacer(has_split_as_input).Run(graph, selected_nodes);
 }
 
+Status LayerNormalizationReplaceWithQLinear::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  const auto& input_defs = selected_nodes.Target().InputDefs();
+  const bool has_bias = input_defs.size() > 2 && input_defs[2]->Exists();
+  return LayerNormalizationReplacer(has_bias).Run(graph, selected_nodes);
+}
+
 Status MatMulReplaceWithQLinear::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
   // if the output is empty there were no Q nodes selected, so replace with MatMulIntegerToFloat
   // otherwise replace with QLinearMatMul
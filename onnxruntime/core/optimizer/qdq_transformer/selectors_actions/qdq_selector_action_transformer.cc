@@ -163,6 +163,44 @@ void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void GeluQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ, Gelu, Q
+  // Replace with QLinearGelu, which is a lookup table in the CPU EP. Delete all original nodes.
+  const std::string action_name{"Gelu"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::UnaryReplaceWithQLinear>(kMSDomain);
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::UnarySelector>(providers);
+  const std::string ms_domain_gelu = SelectorActionRegistry::OpVersionsMapKey("Gelu", kMSDomain);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Gelu", {}},
+                                                          {ms_domain_gelu, {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void LayerNormalizationQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ for X, LayerNormalization, Q. The float scale and bias are kept as they are.
+  // Replace with QLinearLayerNormalization. Delete DQ, LayerNormalization and Q.
+  const std::string action_name{"LayerNormalization"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::LayerNormalizationReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::vector<const char*> providers = {kCpuExecutionProvider};
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::LayerNormalizationSelector>(providers);
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"LayerNormalization", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void BinaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
   // 4 nodes. 2 x DQ for inputs, target, Q
   // Replace with internal QLinear version of operator. Delete all original nodes.
@@ -360,6 +398,8 @@ SelectorActionRegistry CreateSelectorActionRegistry(
   DropQDQNodesRules(qdq_selector_action_registry);
   DropDQNodesRules(qdq_selector_action_registry);
   UnaryOpQDQRules(qdq_selector_action_registry);
+  GeluQDQRules(qdq_selector_action_registry);
+  LayerNormalizationQDQRules(qdq_selector_action_registry);
   BinaryOpQDQRules(qdq_selector_action_registry);
   VariadicOpQDQRules(qdq_selector_action_registry);
   ConvQDQRules(qdq_selector_action_registry, is_int8_allowed);
@@ -656,6 +656,38 @@ bool InstanceAndLayerNormalizationNodeGroupSelector::Check(const GraphViewer& gr
          (has_bias ? dt_bias == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT32 : true);
 }
 
+bool LayerNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
+                                                const Node* redundant_clip_node,
+                                                const std::vector<const Node*>& dq_nodes,
+                                                const std::vector<const Node*>& q_nodes) const {
+  if (redundant_clip_node) {
+    return false;
+  }
+
+  // the DQ nodes are ordered by input index, so a DQ for X is the first one
+  if (dq_nodes.empty() || dq_nodes[0]->OutputDefs()[0] != node.InputDefs()[0]) {
+    return false;
+  }
+
+  if (!CheckQDQNodes(graph_viewer, node, nullptr, {dq_nodes[0]}, q_nodes, 1)) {
+    return false;
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_scale = node.InputDefs()[1]->TypeAsProto()->tensor_type().elem_type();
+
+  return dt_input == dt_output &&
+         (dt_input == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_INT8 ||
+          dt_input == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8) &&
+         dt_scale == ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT;
+}
+
+void LayerNormalizationSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  // only the DQ for X is replaced. DQ nodes producing the float scale and B stay in the graph.
+  builder.input_nodes.resize(1);
+}
+
 bool BatchNormalizationNodeGroupSelector::Check(const GraphViewer& graph_viewer, const Node& node,
                                                 const Node* redundant_clip_node,
                                                 const std::vector<const Node*>& dq_nodes,
@@ -239,6 +239,15 @@ class InstanceAndLayerNormalizationNodeGroupSelector : public NodeGroupSelector
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// DQ node for X, float scale and optional B -> LayerNormalization -> Q
+// Scale and B may be produced by DQ nodes, which are not part of the group as they stay float.
+class LayerNormalizationNodeGroupSelector : public NodeGroupSelector {
+ private:
+  bool Check(const GraphViewer& graph_viewer, const Node& node, const Node* redundant_clip_node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 // DQ nodes for X, W and optionally B, not used for mean, var -> node -> Q
 class BatchNormalizationNodeGroupSelector : public NodeGroupSelector {
  public:
@@ -366,6 +375,15 @@ class ConvSelector : public BaseSelector {
   void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
 };
 
+// DQ node for X -> LayerNormalization -> Q
+class LayerNormalizationSelector : public BaseSelector {
+ public:
+  explicit LayerNormalizationSelector(gsl::span<const char*> compatible_providers = {})
+      : BaseSelector(std::make_unique<LayerNormalizationNodeGroupSelector>(), compatible_providers) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 class WhereSelector : public BaseSelector {
  public:
   explicit WhereSelector(gsl::span<const char*> compatible_providers = {}, bool allow_16bit = false,
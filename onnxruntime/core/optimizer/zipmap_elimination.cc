@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/zipmap_elimination.h"
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Fills `labels` with the class labels of the ZipMap node. Returns false if the node has none.
+bool GetZipMapLabels(const Node& zipmap, ONNX_NAMESPACE::TensorProto& labels) {
+  const auto* label_strings = graph_utils::GetNodeAttribute(zipmap, "classlabels_strings");
+  const auto* label_ints = graph_utils::GetNodeAttribute(zipmap, "classlabels_int64s");
+
+  if (label_strings != nullptr && label_strings->strings_size() > 0) {
+    labels.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_STRING);
+    for (const auto& label : label_strings->strings()) {
+      labels.add_string_data(label);
+    }
+    labels.add_dims(label_strings->strings_size());
+    return true;
+  }
+
+  if (label_ints != nullptr && label_ints->ints_size() > 0) {
+    labels.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT64);
+    for (const auto label : label_ints->ints()) {
+      labels.add_int64_data(label);
+    }
+    labels.add_dims(label_ints->ints_size());
+    return true;
+  }
+
+  return false;
+}
+
+}  // namespace
+
+Status ZipMapElimination::ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/,
+                                    const logging::Logger& logger) const {
+  // only the outputs of the main graph are returned to the user. the Identity replacing ZipMap needs the ONNX domain.
+  if (graph.IsSubgraph() || graph.DomainToVersionMap().count(kOnnxDomain) == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<NodeIndex> zipmap_nodes;
+  {
+    GraphViewer graph_viewer(graph);
+    for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+      const Node* node = graph.GetNode(node_index);
+      if (node == nullptr ||
+          !graph_utils::IsSupportedOptypeVersionAndDomain(*node, "ZipMap", {1}, kMLDomain)) {
+        continue;
+      }
+
+      const NodeArg* input = node->InputDefs()[0];
+      const NodeArg* output = node->OutputDefs()[0];
+      if (input->TypeAsProto() == nullptr || !graph.IsOutput(output) ||
+          !graph.GetConsumerNodes(output->Name()).empty()) {
+        continue;
+      }
+
+      zipmap_nodes.push_back(node_index);
+    }
+  }
+
+  for (const NodeIndex node_index : zipmap_nodes) {
+    Node& zipmap = *graph.GetNode(node_index);
+    NodeArg* input = zipmap.MutableInputDefs()[0];
+    NodeArg* output = zipmap.MutableOutputDefs()[0];
+
+    ONNX_NAMESPACE::TensorProto labels;
+    if (!GetZipMapLabels(zipmap, labels)) {
+      // leave an invalid ZipMap to its kernel to report
+      continue;
+    }
+
+    // the name of the labels output is part of the contract with the caller, so it can't be made unique
+    const std::string labels_name = output->Name() + "_labels";
+    const ONNX_NAMESPACE::TensorProto* existing_initializer = nullptr;
+    ORT_RETURN_IF(graph.GetNodeArg(labels_name) != nullptr ||
+                      graph.GetInitializedTensor(labels_name, existing_initializer),
+                  "Can't return the output of ZipMap node ", zipmap.Name(), " as a tensor: the name ", labels_name,
+                  " for its class labels is already used in the graph.");
+    labels.set_name(labels_name);
+
+    // the producer of the probabilities writes the graph output directly if nothing else reads them.
+    // otherwise, e.g. if the probabilities are a graph input or another node consumes them, an Identity is added.
+    const Node* producer = graph.GetProducerNode(input->Name());
+    const bool rewire_producer = producer != nullptr && !graph.IsOutput(input) &&
+                                 graph.GetConsumerNodes(input->Name()).size() == 1;
+    NodeIndex producer_index = 0;
+    int producer_output_index = 0;
+    if (producer != nullptr) {
+      producer_index = producer->Index();
+      producer_output_index = graph_utils::GetNodeOutputIndexFromOutputName(*producer, input->Name());
+    }
+
+    const std::string zipmap_name = zipmap.Name();
+    const std::string execution_provider = zipmap.GetExecutionProviderType();
+    graph.RemoveNode(node_index);
+
+    graph.SetNodeArgType(*output, *input->TypeAsProto());
+    if (rewire_producer) {
+      Node& producer_node = *graph.GetNode(producer_index);
+      producer_node.MutableOutputDefs()[producer_output_index] = output;
+      graph.UpdateProducerNode(output->Name(), producer_index);
+    } else {
+      Node& identity = graph.AddNode(graph.GenerateNodeName(zipmap_name + "_dense"), "Identity",
+                                     "Dense output replacing ZipMap " + zipmap_name, {input}, {output});
+      identity.SetExecutionProviderType(execution_provider);
+      if (producer != nullptr) {
+        graph.AddEdge(producer_index, identity.Index(), producer_output_index, 0);
+      }
+    }
+
+    NodeArg& labels_arg = graph_utils::AddInitializer(graph, labels);
+
+    // the labels follow the probabilities in the graph outputs
+    std::vector<const NodeArg*> graph_outputs;
+    graph_outputs.reserve(graph.GetOutputs().size() + 1);
+    for (const NodeArg* graph_output : graph.GetOutputs()) {
+      graph_outputs.push_back(graph_output);
+      if (graph_output == output) {
+        graph_outputs.push_back(&labels_arg);
+      }
+    }
+    graph.SetOutputs(graph_outputs);
+
+    LOGS(logger, INFO) << "Replaced ZipMap node " << zipmap_name << " by dense outputs " << output->Name()
+                       << " and " << labels_arg.Name();
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
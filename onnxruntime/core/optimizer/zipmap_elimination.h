@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ZipMapElimination
+
+Graph transformer that replaces an ai.onnx.ml ZipMap node producing a graph output by its dense input.
+
+ZipMap turns the [N, C] class probabilities of a classifier into a sequence of N maps from class label to
+probability, which costs one map per row to build and again to convert on the client side.
+The graph output keeps its name but becomes the float tensor [N, C], and a new graph output "<output name>_labels"
+is added holding the class labels [C] from the ZipMap attributes. Column j of the probabilities belongs to label j.
+It is an error if the graph already uses the name "<output name>_labels".
+
+Before:
+
+  P -> X [N, C] -> ZipMap -> Y (seq(map(label, float)))
+
+After:
+
+  P -> Y [N, C]
+  Y_labels [C] (initializer)
+
+P writes the graph output directly. If X has no producer, is a graph output or has other consumers, ZipMap is
+replaced by an Identity from X to Y instead.
+
+This changes the model outputs so it is only applied on request, see kOrtSessionOptionsZipMapOutputAsTensor.
+*/
+class ZipMapElimination : public GraphTransformer {
+ public:
+  ZipMapElimination() noexcept : GraphTransformer("ZipMapElimination") {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
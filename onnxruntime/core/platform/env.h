@@ -179,6 +179,18 @@ class Env {
   virtual common::Status ReadFileIntoBuffer(_In_z_ const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                                             gsl::span<char> buffer) const = 0;
 
+  /**
+   * Copies several ranges of a file into the provided buffers, opening the file once.
+   * Ranges that follow each other in the file are read without seeking in between, and with a single
+   * scatter read where the platform supports it.
+   * @param file_path The path to the file.
+   * @param offsets The file offset of each range, in increasing order.
+   * @param buffers The buffer in which to write each range. The length of a range is the size of its buffer.
+   */
+  virtual common::Status ReadFileIntoBuffers(_In_z_ const ORTCHAR_T* file_path,
+                                             gsl::span<const FileOffsetType> offsets,
+                                             gsl::span<const gsl::span<char>> buffers) const = 0;
+
   using MappedMemoryPtr = std::unique_ptr<char[], OrtCallbackInvoker>;
 
   /**
@@ -20,12 +20,14 @@ limitations under the License.
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <ftw.h>
+#include <limits.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <sys/mman.h>
+#include <sys/uio.h>
 #if !defined(_AIX)
 #include <sys/syscall.h>
 #endif
@@ -423,6 +425,73 @@ class PosixEnv : public Env {
     return Status::OK();
   }
 
+  Status ReadFileIntoBuffers(const ORTCHAR_T* file_path, gsl::span<const FileOffsetType> offsets,
+                             gsl::span<const gsl::span<char>> buffers) const override {
+    ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
+    ORT_RETURN_IF_NOT(offsets.size() == buffers.size(), "offsets.size() != buffers.size()");
+
+    ScopedFileDescriptor file_descriptor{open(file_path, O_RDONLY)};
+    if (!file_descriptor.IsValid()) {
+      return ReportSystemError("open", file_path);
+    }
+
+    std::vector<struct iovec> iovecs;
+    size_t begin = 0;
+    while (begin < offsets.size()) {
+      ORT_RETURN_IF_NOT(offsets[begin] >= 0, "offset < 0");
+
+      // the ranges that follow each other in the file are read with one readv
+      iovecs.clear();
+      size_t end = begin;
+      FileOffsetType run_end = offsets[begin];
+      while (end < offsets.size() && offsets[end] == run_end && iovecs.size() < static_cast<size_t>(IOV_MAX)) {
+        if (!buffers[end].empty()) {
+          iovecs.push_back(iovec{buffers[end].data(), buffers[end].size()});
+        }
+        run_end += static_cast<FileOffsetType>(buffers[end].size());
+        ++end;
+      }
+
+      if (!iovecs.empty()) {
+        const FileOffsetType seek_result = lseek(file_descriptor.Get(), offsets[begin], SEEK_SET);
+        if (seek_result == -1) {
+          return ReportSystemError("lseek", file_path);
+        }
+      }
+
+      size_t first = 0;
+      while (first < iovecs.size()) {
+        const ssize_t bytes_read = TempFailureRetry(readv, file_descriptor.Get(), iovecs.data() + first,
+                                                    static_cast<int>(iovecs.size() - first));
+
+        if (bytes_read == -1) {
+          return ReportSystemError("readv", file_path);
+        }
+
+        if (bytes_read == 0) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFileIntoBuffers - unexpected end of file. ", "File: ",
+                                 file_path, ", offset: ", offsets[begin], ", length: ", run_end - offsets[begin]);
+        }
+
+        // skip the buffers that are full and continue into the one that was partially read
+        size_t remaining = static_cast<size_t>(bytes_read);
+        while (first < iovecs.size() && remaining >= iovecs[first].iov_len) {
+          remaining -= iovecs[first].iov_len;
+          ++first;
+        }
+
+        if (remaining > 0) {
+          iovecs[first].iov_base = static_cast<char*>(iovecs[first].iov_base) + remaining;
+          iovecs[first].iov_len -= remaining;
+        }
+      }
+
+      begin = end;
+    }
+
+    return Status::OK();
+  }
+
   Status MapFileIntoMemory(const ORTCHAR_T* file_path, FileOffsetType offset, size_t length,
                            MappedMemoryPtr& mapped_memory) const override {
     ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
@@ -406,6 +406,60 @@ Status WindowsEnv::ReadFileIntoBuffer(_In_z_ const ORTCHAR_T* const file_path, c
   return Status::OK();
 }
 
+Status WindowsEnv::ReadFileIntoBuffers(_In_z_ const ORTCHAR_T* file_path, gsl::span<const FileOffsetType> offsets,
+                                       gsl::span<const gsl::span<char>> buffers) const {
+  ORT_RETURN_IF_NOT(file_path, "file_path == nullptr");
+  ORT_RETURN_IF_NOT(offsets.size() == buffers.size(), "offsets.size() != buffers.size()");
+  wil::unique_hfile file_handle{
+      CreateFile2(file_path, GENERIC_READ, FILE_SHARE_READ, OPEN_EXISTING, NULL)};
+  if (file_handle.get() == INVALID_HANDLE_VALUE) {
+    const auto error_code = GetLastError();
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "open file ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+  }
+
+  // the file position is only set at the start of each run of ranges that follow each other in the file
+  FileOffsetType position = -1;
+  for (size_t i = 0; i < offsets.size(); ++i) {
+    ORT_RETURN_IF_NOT(offsets[i] >= 0, "offset < 0");
+    const auto buffer = buffers[i];
+    if (buffer.empty()) {
+      continue;
+    }
+
+    if (offsets[i] != position) {
+      LARGE_INTEGER current_position;
+      current_position.QuadPart = offsets[i];
+      if (!SetFilePointerEx(file_handle.get(), current_position, &current_position, FILE_BEGIN)) {
+        const auto error_code = GetLastError();
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "SetFilePointerEx ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+      }
+    }
+
+    size_t total_bytes_read = 0;
+    while (total_bytes_read < buffer.size()) {
+      constexpr DWORD k_max_bytes_to_read = 1 << 30;  // read at most 1GB each time
+      const size_t bytes_remaining = buffer.size() - total_bytes_read;
+      const DWORD bytes_to_read = static_cast<DWORD>(std::min<size_t>(bytes_remaining, k_max_bytes_to_read));
+      DWORD bytes_read;
+
+      if (!ReadFile(file_handle.get(), buffer.data() + total_bytes_read, bytes_to_read, &bytes_read, nullptr)) {
+        const auto error_code = GetLastError();
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToUTF8String(Basename(file_path)), " fail, errcode = ", error_code, " - ", std::system_category().message(error_code));
+      }
+
+      if (bytes_read != bytes_to_read) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ReadFile ", ToUTF8String(Basename(file_path)), " fail: unexpected end");
+      }
+
+      total_bytes_read += bytes_read;
+    }
+
+    position = offsets[i] + static_cast<FileOffsetType>(buffer.size());
+  }
+
+  return Status::OK();
+}
+
 Status WindowsEnv::MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
                                      FileOffsetType offset,
                                      size_t length,
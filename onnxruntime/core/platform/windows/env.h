@@ -62,6 +62,8 @@ class WindowsEnv : public Env {
   common::Status GetFileLength(int fd, /*out*/ size_t& file_size) const override;
   Status ReadFileIntoBuffer(_In_z_ const ORTCHAR_T* const file_path, const FileOffsetType offset, const size_t length,
                             const gsl::span<char> buffer) const override;
+  Status ReadFileIntoBuffers(_In_z_ const ORTCHAR_T* file_path, gsl::span<const FileOffsetType> offsets,
+                             gsl::span<const gsl::span<char>> buffers) const override;
   Status MapFileIntoMemory(_In_z_ const ORTCHAR_T* file_path,
                            FileOffsetType offset,
                            size_t length,
@@ -23,6 +23,7 @@
 #include "core/framework/TensorSeq.h"
 #include "core/providers/utils.h"
 
+#include <algorithm>
 #include <gsl/gsl>
 
 #ifdef _MSC_VER
@@ -213,6 +214,13 @@ class LoopImpl {
   void CreateInitialFeeds(std::vector<OrtValue>& feeds);
   void SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outputs, std::vector<OrtValue>& next_inputs);
 
+  // create custom allocators for the tensor loop carried variables so an iteration can write a variable into the
+  // buffer that held its value two iterations earlier, instead of allocating a new buffer each iteration.
+  void CreateLoopCarriedVarAllocators(std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  // check if the buffer of the loop carried variable fed to the last iteration can be written by the next one.
+  bool CanRecycleLoopCarriedVar(const OrtValue& value, const std::vector<OrtValue>& last_outputs) const;
+
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
@@ -232,6 +240,14 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // buffers of loop carried variables that are no longer read, for the next iteration to write the variable into.
+  std::vector<OrtValue> recycled_loop_carried_vars_;
+  // whether the execution frame allocated the current iteration's output for each loop carried variable. only those
+  // buffers are owned by the loop. an output may also be a feed, an initializer or an outer scope value.
+  std::vector<bool> loop_carried_var_allocated_;
+  // whether the value fed to the current iteration for each loop carried variable was allocated by the frame.
+  std::vector<bool> loop_carried_var_feed_allocated_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -434,6 +450,10 @@ Status LoopImpl::Initialize() {
 
   loop_output_tensors_.resize(static_cast<size_t>(info_.num_outputs) - info_.num_loop_carried_vars);
 
+  recycled_loop_carried_vars_.resize(info_.num_loop_carried_vars);
+  loop_carried_var_allocated_.resize(info_.num_loop_carried_vars, false);
+  loop_carried_var_feed_allocated_.resize(info_.num_loop_carried_vars, false);
+
   return status;
 }
 
@@ -460,6 +480,19 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   // last_output: cond, loop vars..., loop output...
   // next_input: iter_num, cond, loop_vars. iter_num is re-used
 
+  // the loop carried vars fed to the last iteration are no longer read. keep the buffers the loop owns so the next
+  // iteration can write into them, which ping-pongs each variable between two buffers.
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    const OrtValue& previous_value = next_inputs[static_cast<ptrdiff_t>(i) + 2];  // skip iter_num and cond
+    if (loop_carried_var_feed_allocated_[i] && CanRecycleLoopCarriedVar(previous_value, last_outputs)) {
+      recycled_loop_carried_vars_[i] = previous_value;
+    } else {
+      recycled_loop_carried_vars_[i] = OrtValue();
+    }
+
+    loop_carried_var_feed_allocated_[i] = loop_carried_var_allocated_[i];
+  }
+
   // simple copy for cond and loop carried vars. start at 1 to skip iter_num in input
   for (ptrdiff_t i = 1; i < info_.num_subgraph_inputs; ++i) {
     next_inputs[i] = last_outputs[i - 1];
@@ -492,6 +525,57 @@ Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_outp
   return Status::OK();
 }
 
+bool LoopImpl::CanRecycleLoopCarriedVar(const OrtValue& value, const std::vector<OrtValue>& last_outputs) const {
+  if (!value.IsTensor()) {
+    return false;
+  }
+
+  // the buffer must not be shared with a value that is still used. the last iteration may have passed it through to
+  // an output, and a loop output from the iteration that produced it may share it.
+  const void* data = value.Get<Tensor>().DataRaw();
+  auto shares_buffer = [data](const OrtValue& other) {
+    return other.IsTensor() && other.Get<Tensor>().DataRaw() == data;
+  };
+
+  if (std::any_of(last_outputs.cbegin(), last_outputs.cend(), shares_buffer)) {
+    return false;
+  }
+
+  return std::none_of(loop_output_tensors_.cbegin(), loop_output_tensors_.cend(),
+                      [&shares_buffer](const std::vector<OrtValue>& per_iteration_outputs) {
+                        return !per_iteration_outputs.empty() && shares_buffer(per_iteration_outputs.back());
+                      });
+}
+
+void LoopImpl::CreateLoopCarriedVarAllocators(
+    std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  for (int i = 0; i < info_.num_loop_carried_vars; ++i) {
+    // custom allocators are only supported for tensors
+    if (!info_.loop_carried_vars_types[i]->has_tensor_type()) {
+      continue;
+    }
+
+    fetch_allocators[static_cast<size_t>(i) + 1] =  // skip cond
+        [this, i](const TensorShape& shape, const OrtDevice& location, OrtValue& ort_value, bool& allocated) {
+          // the frame allocates the buffer if there's nothing to recycle. either way the loop owns it.
+          loop_carried_var_allocated_[i] = true;
+
+          OrtValue& recycled = recycled_loop_carried_vars_[i];
+          if (recycled.IsAllocated()) {
+            const auto& tensor = recycled.Get<Tensor>();
+            if (tensor.Shape() == shape && tensor.Location().device == location) {
+              ort_value = recycled;
+              allocated = true;
+            }
+
+            recycled = OrtValue();
+          }
+
+          return Status::OK();
+        };
+  }
+}
+
 Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
   auto status = Status::OK();
 
@@ -500,15 +584,22 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   CreateInitialFeeds(feeds);
 
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  CreateLoopCarriedVarAllocators(fetch_allocators);
+
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+  // unlike Scan the iterations always run in order. each one depends on the condition produced by the previous one,
+  // and the trip count and the shapes of the scan outputs are only known once the loop has finished.
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
       fetches.clear();
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    std::fill(loop_carried_var_allocated_.begin(), loop_carried_var_allocated_.end(), false);
+
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
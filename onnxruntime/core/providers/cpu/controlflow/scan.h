@@ -35,6 +35,11 @@ struct Info {
 
   int num_implicit_inputs;
 
+  // true if each iteration of the subgraph only depends on its own slice of the scan inputs, i.e. there are no
+  // loop state variables. the iterations can be executed in any order, or concurrently, unless the subgraph runs
+  // a non-deterministic kernel. see scan::detail::RunsNonDeterministicKernels.
+  bool independent_iterations;
+
   std::vector<std::string> subgraph_input_names;
   std::vector<std::string> subgraph_output_names;
 };
@@ -16,6 +16,7 @@
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
 
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/utils.h"
@@ -113,7 +114,8 @@ class ScanImpl {
 
   // Execute the batch, by iterating the sequence in each batch entry
   // and calling the subgraph with each item in the sequence.
-  Status Execute(const FeedsFetchesManager& ffm);
+  // If allow_concurrent_iterations is true and the iterations are independent they are run using the thread pool.
+  Status Execute(const FeedsFetchesManager& ffm, bool allow_concurrent_iterations);
 
  private:
   // validate inputs and setup batch size and max sequence length.
@@ -206,6 +208,8 @@ Status Scan<9>::SetupSubgraphExecutionInfo(const SessionState& session_state,
   const auto& node = Node();
   info_ = std::make_unique<Scan<9>::Info>(node, subgraph_session_state.GetGraphViewer(),
                                           static_cast<int>(num_scan_inputs_));
+  info_->independent_iterations = info_->independent_iterations &&
+                                  !scan::detail::RunsNonDeterministicKernels(subgraph_session_state);
 
   auto status = scan::detail::CreateFeedsFetchesManager(node, *info_, session_state, subgraph_session_state,
                                                         /* is_v8 */ false, feeds_fetches_manager_);
@@ -228,7 +232,10 @@ Status Scan<9>::Compute(OpKernelContext* ctx) const {
   auto status = scan_impl.Initialize();
   ORT_RETURN_IF_ERROR(status);
 
-  status = scan_impl.Execute(*feeds_fetches_manager_);
+  // the subgraph outputs are written directly into slices of the Scan outputs which is only safe to do concurrently
+  // when the CPU EP is executing the node.
+  const bool allow_concurrent_iterations = Node().GetExecutionProviderType() == kCpuExecutionProvider;
+  status = scan_impl.Execute(*feeds_fetches_manager_, allow_concurrent_iterations);
 
   return status;
 }
@@ -424,7 +431,7 @@ Status ScanImpl::CreateLoopStateVariables(std::vector<LoopStateVariable>& loop_s
   return status;
 }
 
-Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
+Status ScanImpl::Execute(const FeedsFetchesManager& ffm, bool allow_concurrent_iterations) {
   Status status = Status::OK();
 
   std::vector<LoopStateVariable> loop_state_variables;
@@ -448,9 +455,15 @@ Status ScanImpl::Execute(const FeedsFetchesManager& ffm) {
   }
 
   // Call the subgraph for each item in the sequence
-  status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
-                           sequence_len_, info_.num_loop_state_variables, info_.num_inputs, info_.num_outputs,
-                           implicit_inputs_, output_iterators_, ffm);
+  if (allow_concurrent_iterations && info_.independent_iterations && sequence_len_ > 1 &&
+      concurrency::ThreadPool::DegreeOfParallelism(context_.GetOperatorThreadPool()) > 1) {
+    status = IterateSequenceInParallel(context_, session_state_, scan_input_stream_iterators, sequence_len_,
+                                       info_.num_inputs, info_.num_outputs, implicit_inputs_, output_iterators_, ffm);
+  } else {
+    status = IterateSequence(context_, session_state_, loop_state_variables, scan_input_stream_iterators,
+                             sequence_len_, info_.num_loop_state_variables, info_.num_inputs, info_.num_outputs,
+                             implicit_inputs_, output_iterators_, ffm);
+  }
 
   ORT_RETURN_IF_ERROR(status);
 
@@ -19,6 +19,7 @@
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/framework/session_options.h"
+#include "core/platform/threadpool.h"
 
 #ifdef _MSC_VER
 #pragma warning(pop)
@@ -42,6 +43,8 @@ Info::Info(const Node& node, const GraphViewer& subgraph_in, int num_scan_inputs
 
   num_implicit_inputs = static_cast<int>(node.ImplicitInputDefs().size());
 
+  independent_iterations = !is_v8 && num_loop_state_variables == 0;
+
   auto& graph_inputs = subgraph.GetInputs();
   auto num_subgraph_inputs = static_cast<int>(graph_inputs.size());
   ORT_ENFORCE(num_variadic_inputs == num_subgraph_inputs,
@@ -132,6 +135,25 @@ Status AllocateOutput(OpKernelContextInternal& context, const GraphViewer& subgr
   return Status::OK();
 }
 
+bool RunsNonDeterministicKernels(const SessionState& subgraph_session_state) {
+  for (const auto& node : subgraph_session_state.GetGraphViewer().Nodes()) {
+    const OpKernel* kernel = subgraph_session_state.GetKernel(node.Index());
+    if (kernel != nullptr && kernel->KernelDef().IsNonDeterministic()) {
+      return true;
+    }
+  }
+
+  for (const auto& entry : subgraph_session_state.GetSubgraphSessionStateMap()) {
+    for (const auto& name_to_session_state : entry.second) {
+      if (RunsNonDeterministicKernels(*name_to_session_state.second)) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 Status CreateFeedsFetchesManager(const Node& node,
                                  const Info& info,
                                  const SessionState& session_state,
@@ -293,6 +315,89 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
   return status;
 }
 
+Status IterateSequenceInParallel(OpKernelContextInternal& context, const SessionState& session_state,
+                                 std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>& scan_input_stream_iterators,
+                                 int64_t seq_length, int num_variadic_inputs, int num_variadic_outputs,
+                                 const std::vector<const OrtValue*>& implicit_inputs,
+                                 std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                                 const FeedsFetchesManager& ffm) {
+  // run the first iteration in order to allocate the final outputs. this also advances all the iterators.
+  std::vector<LoopStateVariable> no_loop_state_variables;
+  ORT_RETURN_IF_ERROR(IterateSequence(context, session_state, no_loop_state_variables, scan_input_stream_iterators,
+                                      /* seq_length */ 1, 0, num_variadic_inputs, num_variadic_outputs,
+                                      implicit_inputs, output_iterators, ffm));
+
+  const int64_t remaining = seq_length - 1;
+  if (remaining <= 0) {
+    return Status::OK();
+  }
+
+  std::vector<OrtValueTensorSlicer<OrtValue>::Iterator> scan_output_stream_iterators;
+  scan_output_stream_iterators.reserve(num_variadic_outputs);
+  for (int output = 0; output < num_variadic_outputs; ++output) {
+    scan_output_stream_iterators.push_back(output_iterators[output]->CurrentSlicerIterator());
+  }
+
+  auto* thread_pool = context.GetOperatorThreadPool();
+  const auto num_blocks = static_cast<std::ptrdiff_t>(
+      std::min<int64_t>(remaining, concurrency::ThreadPool::DegreeOfParallelism(thread_pool)));
+  std::vector<Status> block_status(num_blocks);
+
+  // custom allocators are only required for the first iteration
+  const std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
+  const auto num_implicit_inputs = implicit_inputs.size();
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool, num_blocks,
+      [&](std::ptrdiff_t block) {
+        const int64_t start = remaining * block / num_blocks;
+        const int64_t end = remaining * (block + 1) / num_blocks;
+
+        // each block has its own copy of the iterators, positioned at the start of its range
+        auto input_iterators = scan_input_stream_iterators;
+        auto output_slicer_iterators = scan_output_stream_iterators;
+        for (auto& iterator : input_iterators) {
+          iterator += static_cast<std::ptrdiff_t>(start);
+        }
+
+        for (auto& iterator : output_slicer_iterators) {
+          iterator += static_cast<std::ptrdiff_t>(start);
+        }
+
+        std::vector<OrtValue> feeds(num_variadic_inputs + num_implicit_inputs);
+        std::vector<OrtValue> fetches(num_variadic_outputs);
+        for (size_t i = 0; i < num_implicit_inputs; ++i) {
+          feeds[num_variadic_inputs + i] = *implicit_inputs[i];
+        }
+
+        for (int64_t seq_no = start; seq_no < end; ++seq_no) {
+          for (int input = 0; input < num_variadic_inputs; ++input) {
+            feeds[input] = *input_iterators[input];
+            ++input_iterators[input];
+          }
+
+          for (int output = 0; output < num_variadic_outputs; ++output) {
+            fetches[output] = *output_slicer_iterators[output];
+            ++output_slicer_iterators[output];
+          }
+
+          auto status = utils::ExecuteSubgraph(session_state, ffm, feeds, fetches, fetch_allocators,
+                                               ExecutionMode::ORT_SEQUENTIAL, context.GetTerminateFlag(),
+                                               context.Logger(), context.GetComputeStream());
+          if (!status.IsOK()) {
+            block_status[block] = status;
+            return;
+          }
+        }
+      });
+
+  for (const auto& status : block_status) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+
+  return Status::OK();
+}
+
 OrtValue AllocateTensorInMLValue(const MLDataType data_type, const TensorShape& shape, AllocatorPtr& allocator) {
   OrtValue ort_value;
   Tensor::InitOrtValue(data_type, shape, allocator, ort_value);
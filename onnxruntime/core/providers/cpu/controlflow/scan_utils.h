@@ -116,6 +116,14 @@ class OutputIterator {
     ORT_ENFORCE(final_output_mlvalue_, "Attempt to retrieve final output before it was set.");
     return *final_output_mlvalue_;
   }
+
+  // get a copy of the slicer iterator for the current iteration of a v9 scan output.
+  // the copy can be advanced independently, allowing different iterations to be written concurrently.
+  OrtValueTensorSlicer<OrtValue>::Iterator CurrentSlicerIterator() const {
+    ORT_ENFORCE(!is_v8_ && !is_loop_state_var_ && is_concrete_shape_,
+                "Slicer iterator is only available for an allocated scan output in Scan 9 and later.");
+    return *cur_slicer_iterator_;
+  }
   // std::unique_ptr needs to access this function.
   OutputIterator(OpKernelContextInternal& context,
                  int output_index,
@@ -173,6 +181,12 @@ Status AllocateOutput(OpKernelContextInternal& context, const GraphViewer& subgr
                       ScanDirection direction = ScanDirection::kForward,
                       bool temporary = false);
 
+/**
+Check if any kernel in the subgraph, or in a nested subgraph, is non-deterministic (e.g. generates random numbers).
+Iterations running such a kernel are executed in order so its state is consumed deterministically.
+*/
+bool RunsNonDeterministicKernels(const SessionState& subgraph_session_state);
+
 Status CreateFeedsFetchesManager(const Node& node, const Info& info,
                                  const SessionState& session_state,
                                  const SessionState& subgraph_session_state,
@@ -187,6 +201,19 @@ Status IterateSequence(OpKernelContextInternal& context, const SessionState& ses
                        std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
                        const FeedsFetchesManager& ffm);
 
+/**
+Execute the subgraph for each item in the sequence when Info::independent_iterations is true.
+The first iteration is run on the calling thread so that any symbolic dimensions in the outputs are resolved and
+the final output buffers are allocated. The remaining iterations are split into contiguous blocks that are run
+concurrently using the operator thread pool, with each iteration writing directly to its slice of the outputs.
+*/
+Status IterateSequenceInParallel(OpKernelContextInternal& context, const SessionState& session_state,
+                                 std::vector<OrtValueTensorSlicer<const OrtValue>::Iterator>& scan_input_stream_iterators,
+                                 int64_t seq_length, int num_variadic_inputs, int num_variadic_outputs,
+                                 const std::vector<const OrtValue*>& implicit_inputs,
+                                 std::vector<std::unique_ptr<OutputIterator>>& output_iterators,
+                                 const FeedsFetchesManager& ffm);
+
 OrtValue AllocateTensorInMLValue(MLDataType data_type, const TensorShape& shape, AllocatorPtr& allocator);
 
 /**
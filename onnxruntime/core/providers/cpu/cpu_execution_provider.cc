@@ -28,7 +28,7 @@ struct KernelRegistryAndStatus {
 
 namespace onnxruntime {
 CPUExecutionProvider::CPUExecutionProvider(const CPUExecutionProviderInfo& info)
-    : IExecutionProvider{onnxruntime::kCpuExecutionProvider}, info_{info} {}
+    : IExecutionProvider{onnxruntime::kCpuExecutionProvider}, info_{info}, tuning_context_(this, &tunable_op_) {}
 
 std::vector<AllocatorPtr> CPUExecutionProvider::CreatePreferredAllocators() {
   const bool create_arena = DoesCpuAllocatorSupportArenaUsage() ? info_.create_arena : false;
@@ -38,6 +38,10 @@ std::vector<AllocatorPtr> CPUExecutionProvider::CreatePreferredAllocators() {
   return std::vector<AllocatorPtr>{CreateAllocator(device_info)};
 }
 
+ITuningContext* CPUExecutionProvider::GetTuningContext() const {
+  return const_cast<CpuTuningContext*>(&tuning_context_);
+}
+
 // Forward declarations of op kernels
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 6, 10, Clip);
 class ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCpuExecutionProvider, kOnnxDomain, 6, 21, Elu);
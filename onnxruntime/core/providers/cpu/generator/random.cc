@@ -87,7 +87,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     1,
     KernelDefBuilder()
         .TypeConstraint("T",
-                        BuildKernelDefConstraintsFromTypeList<EnabledRandomNormalOutputTypes>()),
+                        BuildKernelDefConstraintsFromTypeList<EnabledRandomNormalOutputTypes>())
+        .NonDeterministic(),
     RandomNormal);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -95,7 +96,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     1,
     KernelDefBuilder()
         .TypeConstraint("T",
-                        BuildKernelDefConstraintsFromTypeList<EnabledRandomUniformOutputTypes>()),
+                        BuildKernelDefConstraintsFromTypeList<EnabledRandomUniformOutputTypes>())
+        .NonDeterministic(),
     RandomUniform);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -104,7 +106,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::AllTensorTypes())
         .TypeConstraint("T2",
-                        BuildKernelDefConstraintsFromTypeList<EnabledRandomNormalLikeOutputTypes>()),
+                        BuildKernelDefConstraintsFromTypeList<EnabledRandomNormalLikeOutputTypes>())
+        .NonDeterministic(),
     RandomNormalLike);
 
 ONNX_CPU_OPERATOR_KERNEL(
@@ -113,7 +116,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::AllTensorTypes())
         .TypeConstraint("T2",
-                        BuildKernelDefConstraintsFromTypeList<EnabledRandomUniformLikeOutputTypes>()),
+                        BuildKernelDefConstraintsFromTypeList<EnabledRandomUniformLikeOutputTypes>())
+        .NonDeterministic(),
     RandomUniformLike);
 
 // https://github.com/onnx/onnx/blob/main/docs/Operators.md#multinomial
@@ -123,7 +127,8 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder()
         .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("T2",
-                        BuildKernelDefConstraintsFromTypeList<EnabledMultinomialOutputTypes>()),
+                        BuildKernelDefConstraintsFromTypeList<EnabledMultinomialOutputTypes>())
+        .NonDeterministic(),
     Multinomial);
 
 template <typename T, typename TDistribution>
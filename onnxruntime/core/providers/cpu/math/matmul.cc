@@ -289,6 +289,13 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
       data[i].alpha = alpha_attr_;
       data[i].beta = 0.0f;
     }
+
+    if (tuning_ctx_ != nullptr && tuning_ctx_->IsTunableOpEnabled()) {
+      SgemmParams params(tuning_ctx_, trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
+                         M, N, K, data, thread_pool);
+      return sgemm_tunable_op_(&params);
+    }
+
     MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                   M, N, K, data.data(), max_len, thread_pool);
   }
@@ -5,6 +5,7 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/tunable/sgemm_tunable.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
 
 namespace onnxruntime {
@@ -30,6 +31,10 @@ class MatMul<float> final : public OpKernel {
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
 
+    if (info.GetExecutionProvider()->Type() == kCpuExecutionProvider) {
+      tuning_ctx_ = static_cast<CpuTuningContext*>(info.GetExecutionProvider()->GetTuningContext());
+    }
+
 #if defined(__aarch64__) && defined(__linux__)
     auto config_ops = info.GetConfigOptions().GetConfigEntry(kOrtSessionOptionsMlasGemmFastMathArm64Bfloat16);
     use_fastmath_mode_ = (config_ops == "1") && MlasBf16AccelerationSupported();
@@ -56,6 +61,10 @@ class MatMul<float> final : public OpKernel {
   bool trans_batch_a_;
   bool trans_batch_b_;
 
+  // chooses how the GEMMs are spread over the thread pool when TunableOp is enabled for the CPU EP
+  CpuTuningContext* tuning_ctx_ = nullptr;
+  mutable SgemmTunableOp sgemm_tunable_op_;
+
 #if defined(__aarch64__) && defined(__linux__)
   // fastmath mode state
   bool use_fastmath_mode_;
@@ -5,6 +5,7 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/hashed_lookup.h"
 #include "core/providers/cpu/ml/ml_common.h"
 
 namespace onnxruntime {
@@ -26,23 +27,16 @@ class CategoryMapper final : public OpKernel {
 
     ORT_ENFORCE(num_entries == int_categories.size());
 
-    string_to_int_map_.reserve(num_entries);
-    int_to_string_map_.reserve(num_entries);
-
-    for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_categories[i];
-      int64_t index = int_categories[i];
-
-      string_to_int_map_[str] = index;
-      int_to_string_map_[index] = str;
-    }
+    // Repeated categories map to the value given last, as they always have.
+    string_to_int_map_.Build(string_categories, int_categories, /*keep_last*/ true);
+    int_to_string_map_.Build(int_categories, string_categories, /*keep_last*/ true);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  HashedLookup<std::string, int64_t> string_to_int_map_;
+  HashedLookup<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
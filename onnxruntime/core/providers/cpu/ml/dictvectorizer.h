@@ -2,10 +2,13 @@
 // Licensed under the MIT License.
 
 #pragma once
+#include <algorithm>
 #include <string>
+#include <utility>
 #include <vector>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/hashed_lookup.h"
 
 namespace onnxruntime {
 namespace ml {
@@ -16,24 +19,47 @@ class DictVectorizerOp final : public OpKernel {
     // In some stupid models, the vocabulary could have duplicated elements.
     // We must support that, otherwise some tests will be break.
     ORT_ENFORCE(info.GetAttrs(std::is_same<AttrType, std::string>::value ? "string_vocabulary" : "int64_vocabulary", vocabulary_).IsOK());
+
+    // Index each word by its first position. Later copies of a word are filled from that position.
+    std::vector<size_t> positions(vocabulary_.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+      positions[i] = i;
+    }
+    vocabulary_index_.Build(vocabulary_, positions);
+    for (size_t i = 0; i < vocabulary_.size(); ++i) {
+      const size_t first = *vocabulary_index_.Find(vocabulary_[i]);
+      if (first != i) {
+        duplicates_.emplace_back(first, i);
+      }
+    }
   }
   common::Status Compute(OpKernelContext* ctx) const override {
     const auto* map = ctx->Input<std::map<AttrType, TargetType> >(0);
     auto* Y = ctx->Output(0, {1, static_cast<int64_t>(vocabulary_.size())});
-    auto* y_data = Y->MutableData<TargetType>();
-    for (size_t i = 0, end = vocabulary_.size(); i < end; ++i) {
-      auto index = map->find(vocabulary_[i]);
-      if (index != map->end()) {
-        *y_data++ = index->second;
-      } else {
-        // Any keys not present in the input dictionary, will be zero in the output array
-        *y_data++ = TargetType();
+    auto y_data = Y->MutableDataAsSpan<TargetType>();
+
+    // Any keys not present in the input dictionary, will be zero in the output array
+    std::fill(y_data.begin(), y_data.end(), TargetType());
+
+    // Walk the input dictionary rather than the vocabulary, so the cost is one probe per input entry.
+    for (const auto& entry : *map) {
+      const size_t* position = vocabulary_index_.Find(entry.first);
+      if (position != nullptr) {
+        y_data[*position] = entry.second;
       }
     }
+    for (const auto& duplicate : duplicates_) {
+      y_data[duplicate.second] = y_data[duplicate.first];
+    }
     return Status::OK();
   }
 
   std::vector<AttrType> vocabulary_;
+
+ private:
+  HashedLookup<AttrType, size_t> vocabulary_index_;
+  // (first position, repeated position) for each repeated word in the vocabulary.
+  std::vector<std::pair<size_t, size_t>> duplicates_;
 };
 
 }  // namespace ml
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace ml {
+
+// We don't make use of InlinedHashMap since we make use of a custom hash and equality function.
+// Introducing new template parameters in inlined_containers_fwd.h creates compilation errors
+// (see https://github.com/microsoft/onnxruntime/pull/17977#discussion_r1446510961).
+#ifndef DISABLE_ABSEIL
+template <typename T>
+using HashFunc = absl::container_internal::hash_default_hash<T>;
+
+template <typename T>
+using EqualFunc = absl::container_internal::hash_default_eq<T>;
+
+template <typename K, typename V, typename Hash, typename Equal>
+using HashMap = absl::flat_hash_map<K, V, Hash, Equal>;
+#else
+template <typename T>
+using HashFunc = std::hash<T>;
+
+template <typename T>
+using EqualFunc = std::equal_to<T>;
+
+template <typename K, typename V, typename Hash, typename Equal>
+using HashMap = std::unordered_map<K, V, Hash, Equal>;
+#endif  // DISABLE_ABSEIL
+
+template <typename T>
+struct NaNHash {
+  size_t operator()(const T& value) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        return 0;
+      }
+    }
+    return HashFunc<T>{}(value);
+  }
+};
+
+template <typename T>
+struct NaNEqual {
+  bool operator()(const T& lhs, const T& rhs) const {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(lhs) && std::isnan(rhs)) {
+        return true;
+      }
+    }
+    return EqualFunc<T>{}(lhs, rhs);
+  }
+};
+
+// Read-only key to value table shared by the mapping operators (CategoryMapper, LabelEncoder, DictVectorizer).
+//
+// The table is an open addressing (Swiss) hash map. String keys are copied once into a single contiguous buffer
+// and indexed by std::string_view, so the table holds no per-key allocation and probing does not chase a pointer
+// per candidate. NaN keys compare equal to each other. Lookups over a tensor run in small batches which prefetch
+// the hash slots of the whole batch before probing, and large inputs are split across the intra-op thread pool.
+template <typename TKey, typename TValue>
+class HashedLookup {
+ public:
+  using StoredKey = std::conditional_t<std::is_same_v<TKey, std::string>, std::string_view, TKey>;
+
+  HashedLookup() = default;
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(HashedLookup);
+
+  // Builds the table from keys[i] -> values[i]. A key that appears more than once keeps its first value,
+  // or its last value if keep_last is set.
+  void Build(gsl::span<const TKey> keys, gsl::span<const TValue> values, bool keep_last = false) {
+    ORT_ENFORCE(keys.size() == values.size(), "Keys and values must have the same length.");
+    map_.clear();
+    map_.reserve(keys.size());
+
+    if constexpr (std::is_same_v<TKey, std::string>) {
+      SafeInt<size_t> total_length = 0;
+      for (const auto& key : keys) {
+        total_length += key.size();
+      }
+      key_storage_ = std::make_unique<char[]>(static_cast<size_t>(total_length) + 1);
+      char* next = key_storage_.get();
+      for (size_t i = 0; i < keys.size(); ++i) {
+        std::memcpy(next, keys[i].data(), keys[i].size());
+        Insert(std::string_view(next, keys[i].size()), values[i], keep_last);
+        next += keys[i].size();
+      }
+    } else {
+      for (size_t i = 0; i < keys.size(); ++i) {
+        Insert(keys[i], values[i], keep_last);
+      }
+    }
+  }
+
+  size_t Size() const { return map_.size(); }
+
+  // Returns the value mapped to key, or nullptr if the key is not in the table.
+  const TValue* Find(const StoredKey& key) const {
+    const auto found = map_.find(key);
+    return found == map_.end() ? nullptr : &found->second;
+  }
+
+  // output[i] = table[input[i]], or default_value if input[i] is not in the table.
+  void Lookup(gsl::span<const TKey> input, gsl::span<TValue> output, const TValue& default_value,
+              concurrency::ThreadPool* thread_pool) const {
+    ORT_ENFORCE(input.size() == output.size(), "Lookup input and output must have the same length.");
+
+    // Probing a string key costs a hash over its characters and usually a cache miss on the slot.
+    const double compute_cost = std::is_same_v<TKey, std::string> ? 64.0 : 16.0;
+    concurrency::ThreadPool::TryParallelFor(
+        thread_pool, static_cast<std::ptrdiff_t>(input.size()),
+        TensorOpCost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)), compute_cost},
+        [this, input, output, &default_value](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          LookupRange(input, output, default_value, narrow<size_t>(begin), narrow<size_t>(end));
+        });
+  }
+
+ private:
+  // Number of keys whose slots are prefetched before probing.
+  static constexpr size_t kBatchSize = 16;
+
+  void Insert(const StoredKey& key, const TValue& value, bool keep_last) {
+    if (keep_last) {
+      map_.insert_or_assign(key, value);
+    } else {
+      map_.emplace(key, value);
+    }
+  }
+
+  void LookupRange(gsl::span<const TKey> input, gsl::span<TValue> output, const TValue& default_value,
+                   size_t begin, size_t end) const {
+    const auto map_end = map_.end();
+    for (size_t batch_begin = begin; batch_begin < end; batch_begin += kBatchSize) {
+      const size_t batch_end = std::min(batch_begin + kBatchSize, end);
+#ifndef DISABLE_ABSEIL
+      for (size_t i = batch_begin; i < batch_end; ++i) {
+        map_.prefetch(StoredKey(input[i]));
+      }
+#endif
+      for (size_t i = batch_begin; i < batch_end; ++i) {
+        const auto found = map_.find(StoredKey(input[i]));
+        output[i] = found == map_end ? default_value : found->second;
+      }
+    }
+  }
+
+  // Backing buffer for the string keys. The map keys are views into it.
+  std::unique_ptr<char[]> key_storage_;
+  HashMap<StoredKey, TValue, NaNHash<StoredKey>, NaNEqual<StoredKey>> map_;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
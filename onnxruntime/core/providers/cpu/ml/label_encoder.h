@@ -5,6 +5,7 @@
 #include <filesystem>
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/ml/hashed_lookup.h"
 #include "core/providers/cpu/ml/ml_common.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/common/safeint.h"
@@ -24,22 +25,20 @@ class LabelEncoder final : public OpKernel {
 
     auto num_entries = string_classes.size();
 
-    string_to_int_map_.reserve(num_entries);
-    int_to_string_map_.reserve(num_entries);
-
+    std::vector<int64_t> indices(num_entries);
     for (size_t i = 0; i < num_entries; ++i) {
-      const std::string& str = string_classes[i];
-
-      string_to_int_map_[str] = i;
-      int_to_string_map_[i] = str;
+      indices[i] = static_cast<int64_t>(i);
     }
+
+    string_to_int_map_.Build(string_classes, indices, /*keep_last*/ true);
+    int_to_string_map_.Build(indices, string_classes, /*keep_last*/ true);
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  std::unordered_map<std::string, int64_t> string_to_int_map_;
-  std::unordered_map<int64_t, std::string> int_to_string_map_;
+  HashedLookup<std::string, int64_t> string_to_int_map_;
+  HashedLookup<int64_t, std::string> int_to_string_map_;
 
   std::string default_string_;
   int64_t default_int_;
@@ -147,53 +146,6 @@ T GetDefault(const OpKernelInfo& info, const std::string& attr_name, const T& ba
   return backup;
 }
 
-// We don't make use of InlinedHashMap since we make use of a custom hash and equality function.
-// Introducing new template parameters in inlined_containers_fwd.h creates compilation errors
-// (see https://github.com/microsoft/onnxruntime/pull/17977#discussion_r1446510961).
-#ifndef DISABLE_ABSEIL
-template <typename T>
-using HashFunc = absl::container_internal::hash_default_hash<T>;
-
-template <typename T>
-using EqualFunc = absl::container_internal::hash_default_eq<T>;
-
-template <typename K, typename V, typename Hash, typename Equal>
-using HashMap = absl::flat_hash_map<K, V, Hash, Equal>;
-#else
-template <typename T>
-using HashFunc = std::hash<T>;
-
-template <typename T>
-using EqualFunc = std::equal_to<T>;
-
-template <typename K, typename V, typename Hash, typename Equal>
-using HashMap = std::unordered_map<K, V, Hash, Equal>;
-#endif  // DISABLE_ABSEIL
-
-template <typename T>
-struct NaNHash {
-  size_t operator()(const T& value) const {
-    if constexpr (std::is_floating_point_v<T>) {
-      if (std::isnan(value)) {
-        return 0;
-      }
-    }
-    return HashFunc<T>{}(value);
-  }
-};
-
-template <typename T>
-struct NaNEqual {
-  bool operator()(const T& lhs, const T& rhs) const {
-    if constexpr (std::is_floating_point_v<T>) {
-      if (std::isnan(lhs) && std::isnan(rhs)) {
-        return true;
-      }
-    }
-    return EqualFunc<T>{}(lhs, rhs);
-  }
-};
-
 template <typename TKey, typename TValue>
 class LabelEncoder_4 final : public OpKernel {
  public:
@@ -202,31 +154,21 @@ class LabelEncoder_4 final : public OpKernel {
     auto keys = GetAttribute<TKey>(kernel_info, key_field_name_, "keys_tensor");
     auto values = GetAttribute<TValue>(kernel_info, value_field_name_, "values_tensor");
     ORT_ENFORCE(keys.size() == values.size(), "Keys and values must have the same length.");
-    for (size_t i = 0; i < keys.size(); ++i) {
-      map_.emplace(keys[i], values[i]);
-    }
+    map_.Build(keys, values);
   }
   Status Compute(OpKernelContext* context) const override {
     const auto* X = context->Input<Tensor>(0);
     const TensorShape& shape = X->Shape();
     auto* Y = context->Output(0, shape);
 
-    auto input = X->template DataAsSpan<TKey>();
-    auto output = Y->template MutableDataAsSpan<TValue>();
-    auto input_iter = input.begin();
-    auto output_iter = output.begin();
-    while (input_iter != input.end()) {
-      const auto found = map_.find(*input_iter);
-      *output_iter = found == map_.end() ? default_value_ : found->second;
-      ++output_iter;
-      ++input_iter;
-    }
+    map_.Lookup(X->template DataAsSpan<TKey>(), Y->template MutableDataAsSpan<TValue>(), default_value_,
+                context->GetOperatorThreadPool());
     return Status::OK();
   }
 
  private:
   void InitializeAttrFields(const OpKernelInfo& kernel_info);
-  HashMap<TKey, TValue, NaNHash<TKey>, NaNEqual<TKey>> map_;
+  HashedLookup<TKey, TValue> map_;
   TValue default_value_;
   std::string key_field_name_;
   std::string value_field_name_;
@@ -391,7 +391,8 @@ static void write_scores(InlinedVector<T>& scores, POST_EVAL_TRANSFORM post_tran
 
 // TODO: Update TreeEnsemble* ops to use this instead of write_scores if possible.
 //       Attempted to parallelize the calculations if the number of scores to process was large, but no clear benefit
-//       was seen from testing with the arbitrary values of 1000 scores per threads.
+//       was seen from testing with the arbitrary values of 1000 scores per threads. The scalar PROBIT and SOFTMAX_ZERO
+//       transforms are the exception and go through TryParallelFor, which keeps small inputs on the calling thread.
 template <typename T>
 void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in, int64_t batch_size,
                                    POST_EVAL_TRANSFORM post_transform,
@@ -410,13 +411,22 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
   T* s = scores.data();
   const T* s_end = s + static_cast<int32_t>(num_scores);
 
+  // ComputeProbit has no vectorized MLAS equivalent, so large inputs are split across the thread pool instead.
+  // The cost keeps small inputs on the calling thread.
+  auto compute_probit = [threadpool](T* begin, ptrdiff_t count) {
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, count, TensorOpCost{static_cast<double>(sizeof(T)), static_cast<double>(sizeof(T)), 40.0},
+        [begin](ptrdiff_t first, ptrdiff_t last) {
+          for (T* p = begin + first; p < begin + last; ++p) {
+            *p = ComputeProbit(*p);
+          }
+        });
+  };
+
   if (batch_size > 1) {
     switch (post_transform) {
       case POST_EVAL_TRANSFORM::PROBIT: {
-        while (s < s_end) {
-          *s = ComputeProbit(*s);
-          ++s;
-        }
+        compute_probit(s, static_cast<int32_t>(num_scores));
         break;
       }
       case POST_EVAL_TRANSFORM::LOGISTIC: {
@@ -457,11 +467,16 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
         break;
       }
       case POST_EVAL_TRANSFORM::SOFTMAX_ZERO: {
-        while (s < s_end) {
-          gsl::span<float> scores_for_batch(s, s + batch_size);
-          ComputeSoftmaxZero(scores_for_batch);
-          s += batch_size;
-        }
+        concurrency::ThreadPool::TryParallelFor(
+            threadpool, static_cast<int32_t>(num_batches),
+            TensorOpCost{static_cast<double>(batch_size * sizeof(T)), static_cast<double>(batch_size * sizeof(T)),
+                         static_cast<double>(batch_size * 16)},
+            [s, batch_size](ptrdiff_t first, ptrdiff_t last) {
+              for (ptrdiff_t batch = first; batch < last; ++batch) {
+                gsl::span<float> scores_for_batch(s + batch * batch_size, onnxruntime::narrow<size_t>(batch_size));
+                ComputeSoftmaxZero(scores_for_batch);
+              }
+            });
         break;
       }
       case POST_EVAL_TRANSFORM::NONE:
@@ -470,10 +485,7 @@ void batched_update_scores_inplace(gsl::span<T> scores, int64_t num_batches_in,
     }
   } else {  // binary case
     if (post_transform == POST_EVAL_TRANSFORM::PROBIT) {
-      while (s < s_end) {
-        *s = ComputeProbit(*s);
-        ++s;
-      }
+      compute_probit(s, static_cast<int32_t>(num_scores));
     } else if (add_second_class >= 0) {
       // in this case we have a buffer that holds 2x scores. the actual scores are at the start of the buffer,
       // and for each score we need 2 entries.
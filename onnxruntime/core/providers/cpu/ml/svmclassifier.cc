@@ -63,6 +63,7 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   if (vector_count_ > 0) {
     feature_count_ = support_vectors_.size() / vector_count_;  // length of each support vector
     mode_ = SVM_TYPE::SVM_SVC;
+    PrepareSupportVectors(info, support_vectors_, vector_count_, feature_count_);
   } else {
     feature_count_ = coefficients_.size() / class_count_;  // liblinear mode
     mode_ = SVM_TYPE::SVM_LINEAR;
@@ -244,10 +245,10 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
 
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
-    batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
-                              threadpool);
+    batched_support_vector_kernel(x_data, num_batches, kernels_span, threadpool);
 
-    for (int64_t n = 0; n < num_batches; n++) {
+    auto reduce_batch = [this, kernels_span, classifier_scores, votes_span,
+                         num_slots_per_iteration, num_classifiers](ptrdiff_t n) {
       // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
       // per class.
       // coefficients: [num_classes - 1, vector_count_]
@@ -304,7 +305,19 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
           ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
         }
       }
-    }
+    };
+
+    // each batch reads its own row of kernels and writes its own scores and votes
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, num_batches,
+        TensorOpCost{static_cast<double>(vector_count_ * sizeof(float)),
+                     static_cast<double>(num_classifiers * sizeof(float) + class_count_ * sizeof(int64_t)),
+                     static_cast<double>(vector_count_ * (class_count_ - 1) * 2)},
+        [&reduce_batch](ptrdiff_t begin, ptrdiff_t end) {
+          for (ptrdiff_t n = begin; n < end; ++n) {
+            reduce_batch(n);
+          }
+        });
   }
 
   auto finalize_batch = [this, &final_scores, final_scores_per_batch,
@@ -374,16 +387,17 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
                                          write_additional_scores, true, nullptr);
   };
 
-  // TODO: Refine this rough metric to choose when to parallelize.
-  if (num_batches > 512) {
-    concurrency::ThreadPool::TryBatchParallelFor(threadpool, num_batches, finalize_batch, -1);
-  } else {
-    {
-      for (ptrdiff_t i = 0; i < num_batches; ++i) {
-        finalize_batch(i);
-      }
-    }
-  }
+  // the pairwise coupling for probabilities iterates over a class_count_ x class_count_ matrix, the rest is linear
+  const double finalize_cost = static_cast<double>(have_proba ? class_count_squared * 64 : class_count_ * 4);
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, num_batches,
+      TensorOpCost{static_cast<double>(final_scores_per_batch * sizeof(float)),
+                   static_cast<double>(final_scores_per_batch * sizeof(float)), finalize_cost},
+      [&finalize_batch](ptrdiff_t begin, ptrdiff_t end) {
+        for (ptrdiff_t i = begin; i < end; ++i) {
+          finalize_batch(i);
+        }
+      });
 
   return Status::OK();
 }
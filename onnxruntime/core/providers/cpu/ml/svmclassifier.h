@@ -3,8 +3,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+
 #include "core/common/common.h"
+#include "core/common/narrow.h"
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 #include "ml_common.h"
 #include "core/providers/cpu/math/gemm.h"
@@ -27,6 +33,111 @@ class SVMCommon {
     }
   }
 
+  // Prepares the support vectors [vector_count, feature_count] for batched_support_vector_kernel.
+  // For the kernels that start from a dot product the support vectors are packed once for MLAS SGEMM.
+  // support_vectors must stay alive and unchanged as long as this object is used.
+  void PrepareSupportVectors(const OpKernelInfo& info, gsl::span<const float> support_vectors,
+                             ptrdiff_t vector_count, ptrdiff_t feature_count) {
+    support_vectors_data_ = support_vectors.data();
+    support_vector_count_ = narrow<size_t>(vector_count);
+    support_vector_feature_count_ = narrow<size_t>(feature_count);
+
+    if (kernel_type_ == KERNEL::RBF || support_vector_count_ == 0 || support_vector_feature_count_ == 0) {
+      return;
+    }
+
+    const size_t packed_size = MlasGemmPackBSize(support_vector_count_, support_vector_feature_count_);
+    if (packed_size != 0) {
+      AllocatorPtr alloc = info.GetAllocator(OrtMemType::OrtMemTypeDefault);
+      packed_support_vectors_ = IAllocator::MakeUniquePtr<void>(alloc, packed_size, true);
+      memset(packed_support_vectors_.get(), 0, packed_size);
+      MlasGemmPackB(CblasTrans, support_vector_count_, support_vector_feature_count_, support_vectors_data_,
+                    support_vector_feature_count_, packed_support_vectors_.get());
+    }
+  }
+
+  // Applies the kernel to every pair of input row and support vector given to PrepareSupportVectors.
+  // a: [m, feature_count], out: [m, vector_count]
+  // POLY, SIGMOID and LINEAR start from one SGEMM over the packed support vectors. RBF computes the squared
+  // distances directly, as expanding them into dot products loses precision for inputs of large magnitude.
+  // The element-wise part of each kernel runs per row on the thread pool with the MLAS vectorized exp/tanh.
+  void batched_support_vector_kernel(gsl::span<const float> a, ptrdiff_t m, gsl::span<float> out,
+                                     concurrency::ThreadPool* threadpool) const {
+    const size_t M = narrow<size_t>(m);
+    const size_t N = support_vector_count_;
+    const size_t K = support_vector_feature_count_;
+    assert(a.size() == M * K && out.size() == M * N);
+
+    if (M == 0 || N == 0) {
+      return;
+    }
+
+    if (kernel_type_ != KERNEL::RBF) {
+      const float alpha = kernel_type_ == KERNEL::LINEAR ? 1.f : gamma_;
+      if (K == 0) {
+        std::fill(out.begin(), out.end(), 0.f);
+      } else if (packed_support_vectors_) {
+        MlasGemm(CblasNoTrans, M, N, K, alpha, a.data(), K, packed_support_vectors_.get(), 0.f, out.data(), N,
+                 threadpool);
+      } else {
+        MLAS_SGEMM_DATA_PARAMS data;
+        data.A = a.data();
+        data.lda = K;
+        data.B = support_vectors_data_;
+        data.ldb = K;
+        data.C = out.data();
+        data.ldc = N;
+        data.alpha = alpha;
+        data.beta = 0.f;
+        MlasGemm(CblasNoTrans, CblasTrans, M, N, K, data, threadpool);
+      }
+
+      if (kernel_type_ == KERNEL::LINEAR) {
+        return;
+      }
+    }
+
+    const double compute_cost = kernel_type_ == KERNEL::RBF ? static_cast<double>(N * (K * 3 + 8))
+                                                            : static_cast<double>(N * 8);
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, m,
+        TensorOpCost{static_cast<double>(K * sizeof(float)), static_cast<double>(N * sizeof(float)), compute_cost},
+        [this, a, out, N, K](ptrdiff_t begin, ptrdiff_t end) {
+          for (ptrdiff_t row = begin; row < end; ++row) {
+            float* cur_out = out.data() + narrow<size_t>(row) * N;
+
+            if (kernel_type_ == KERNEL::RBF) {
+              const float* x = a.data() + narrow<size_t>(row) * K;
+              const float* cur_support_vector = support_vectors_data_;
+              for (size_t j = 0; j < N; ++j, cur_support_vector += K) {
+                float sum = 0.f;
+                for (size_t feature = 0; feature < K; ++feature) {
+                  const float val = x[feature] - cur_support_vector[feature];
+                  sum += val * val;
+                }
+                cur_out[j] = -gamma_ * sum;
+              }
+              MlasComputeExp(cur_out, cur_out, N);
+            } else if (kernel_type_ == KERNEL::POLY) {
+              for (size_t j = 0; j < N; ++j) {
+                const float v = cur_out[j] + coef0_;
+                if (degree_ == 2)
+                  cur_out[j] = v * v;
+                else if (degree_ == 3)
+                  cur_out[j] = v * v * v;
+                else
+                  cur_out[j] = std::pow(v, degree_);
+              }
+            } else if (kernel_type_ == KERNEL::SIGMOID) {
+              for (size_t j = 0; j < N; ++j) {
+                cur_out[j] += coef0_;
+              }
+              MlasComputeTanh(cur_out, cur_out, N);
+            }
+          }
+        });
+  }
+
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
@@ -100,10 +211,17 @@ class SVMCommon {
   float gamma_{0.f};
   float coef0_{0.f};
   float degree_{0.f};
+
+  // set by PrepareSupportVectors
+  const float* support_vectors_data_{nullptr};
+  size_t support_vector_count_{0};
+  size_t support_vector_feature_count_{0};
+  IAllocatorUniquePtr<void> packed_support_vectors_;  // not used by RBF
 };
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::batched_support_vector_kernel;
   using SVMCommon::get_kernel_type;
   using SVMCommon::set_kernel_type;
 
@@ -15,7 +15,8 @@ namespace onnxruntime {
       KernelDefBuilder()                                                    \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T1>())           \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T2>())          \
-          .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>()),       \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>())        \
+          .NonDeterministic(),                                              \
       Dropout<T1, T2>);
 
 #define REGISTER_KERNEL_TYPED(OpName, VER, T1, T2)                    \
@@ -26,7 +27,8 @@ namespace onnxruntime {
       KernelDefBuilder()                                              \
           .TypeConstraint("T", DataTypeImpl::GetTensorType<T1>())     \
           .TypeConstraint("T1", DataTypeImpl::GetTensorType<T2>())    \
-          .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>()), \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<bool>())  \
+          .NonDeterministic(),                                        \
       Dropout<T1, T2>);
 
 // REVIEW(mzs): ConstEigenVectorArrayMap.cast<MLFLoat16) does not seem to be supported.
@@ -9,7 +9,9 @@
 #include "core/platform/threadpool.h"
 
 #include <functional>
+#include <limits>
 #include <string_view>
+#include <type_traits>
 
 namespace onnxruntime {
 
@@ -25,66 +27,76 @@ ONNX_CPU_OPERATOR_KERNEL(
 
 namespace ngram_details {
 
-// NgrampPart implements a Trie like structure
-// for a unigram (1) it would insert into a root map with a valid id.
-// for (1,2,3) node 2 would be a child of 1 but have id == 0
-// because (1,2) does not exists. Node 3 would have a valid id.
-template <class T>
-struct NgramPart;
-
-template <>
-struct NgramPart<int64_t>;
-
-template <>
-struct NgramPart<std::string>;
-
-using NgramPartInt = NgramPart<int64_t>;
-using NgramPartString = NgramPart<std::string>;
-
-// Avoid recursive class definitions using unique_ptr + forward declaration
-using IntMap = InlinedHashMap<int64_t, std::unique_ptr<NgramPartInt>>;
-
-#ifndef DISABLE_ABSEIL
-using StrMap = absl::flat_hash_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                   std::hash<std::string>, std::equal_to<std::string>>;
-#else
-using StrMap = std::unordered_map<std::reference_wrapper<const std::string>, std::unique_ptr<NgramPartString>,
-                                  std::hash<std::string>, std::equal_to<std::string>>;
-#endif
-
-template <>
-struct NgramPart<int64_t> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  IntMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
-};
+// The n-gram pool is kept as a trie flattened into integer tables.
+// Every distinct item of the pool gets a dense token id, so an input item is hashed once
+// no matter how many n-grams and skip distances it takes part in. Trie nodes are numbered densely
+// and node 0 is the root. The children of the root are indexed directly by token id, all the other edges
+// live in a single flat hash map keyed by (parent node, token id). Each node records the id of the n-gram
+// that ends at it, or 0 if the node is only a prefix of longer n-grams.
+class NgramTrie {
+ public:
+  static constexpr int32_t kUnknownToken = -1;
+
+  NgramTrie() : ngram_ids_(1, 0) {}
+
+  bool Empty() const { return ngram_ids_.size() == 1; }
+
+  // Returns the child of node for the token, or 0 if there is none.
+  uint32_t Child(uint32_t node, int32_t token) const {
+    if (node == 0) {
+      return static_cast<size_t>(token) < root_children_.size() ? root_children_[token] : 0;
+    }
+    auto hit = edges_.find(EdgeKey(node, token));
+    return hit == edges_.end() ? 0 : hit->second;
+  }
+
+  size_t NgramId(uint32_t node) const { return ngram_ids_[node]; }
+
+  void Insert(gsl::span<const int32_t> tokens, size_t ngram_id) {
+    uint32_t node = 0;
+    for (int32_t token : tokens) {
+      uint32_t child = Child(node, token);
+      if (child == 0) {
+        ORT_ENFORCE(ngram_ids_.size() < std::numeric_limits<uint32_t>::max(), "Too many n-gram items in the pool");
+        child = static_cast<uint32_t>(ngram_ids_.size());
+        ngram_ids_.push_back(0);
+        if (node == 0) {
+          if (static_cast<size_t>(token) >= root_children_.size()) {
+            root_children_.resize(static_cast<size_t>(token) + 1, 0);
+          }
+          root_children_[token] = child;
+        } else {
+          edges_.emplace(EdgeKey(node, token), child);
+        }
+      }
+      node = child;
+    }
+    ORT_ENFORCE(ngram_ids_[node] == 0, "Duplicate ngram detected, size: ", tokens.size(), " id: ", ngram_id);
+    ngram_ids_[node] = ngram_id;
+  }
 
-template <>
-struct NgramPart<std::string> {
-  size_t id_;  // 0 - means no entry, search for a bigger N
-  StrMap leafs_;
-  explicit NgramPart(size_t id) : id_(id) {}
+ private:
+  static uint64_t EdgeKey(uint32_t node, int32_t token) {
+    return (uint64_t{node} << 32) | static_cast<uint32_t>(token);
+  }
+
+  InlinedVector<uint32_t> root_children_;
+  InlinedHashMap<uint64_t, uint32_t> edges_;
+  InlinedVector<size_t> ngram_ids_;
 };
 
 // Returns next ngram_id
-template <class K, class ForwardIter, class Map>
+template <class ForwardIter, class TokenFn>
 inline size_t PopulateGrams(ForwardIter first, size_t ngrams, size_t ngram_size, size_t ngram_id,
-                            Map& c) {
+                            TokenFn&& token_of, NgramTrie& trie) {
+  InlinedVector<int32_t> tokens(ngram_size);
   for (; ngrams > 0; --ngrams) {
-    size_t n = 1;
-    Map* m = &c;
-    while (true) {
-      auto p = m->emplace(*first, std::make_unique<NgramPart<K>>(0));
+    for (auto& token : tokens) {
+      token = token_of(*first);
       ++first;
-      if (n == ngram_size) {
-        ORT_ENFORCE(p.first->second->id_ == 0, "Duplicate ngram detected, size: ", ngram_size, " id: ", ngram_id);
-        p.first->second->id_ = ngram_id;
-        ++ngram_id;
-        break;
-      }
-      ++n;
-      m = &p.first->second->leafs_;
     }
+    trie.Insert(tokens, ngram_id);
+    ++ngram_id;
   }
   return ngram_id;
 }
@@ -96,10 +108,6 @@ using namespace onnxruntime::ngram_details;
 
 namespace onnxruntime {
 
-inline const void* AdvanceElementPtr(const void* p, size_t elements, size_t element_size) {
-  return reinterpret_cast<const uint8_t*>(p) + elements * element_size;
-}
-
 // The weighting criteria.
 // "TF"(term frequency),
 //    the counts are propagated to output
@@ -134,11 +142,12 @@ struct TfIdfVectorizer::Impl {
   gsl::span<const int64_t> ngram_indexes_;
   gsl::span<const float> weights_;
 
-  // This map contains references to pool_string_ entries
-  // of pool_strings attribute
-  StrMap str_map_;
-  // This map contains pool_int64s entries
-  IntMap int64_map_;
+  // Token ids of the items in pool_strings. The keys refer to the attribute strings.
+  InlinedHashMap<std::string_view, int32_t> str_tokens_;
+  // Token ids of the items in pool_int64s
+  InlinedHashMap<int64_t, int32_t> int64_tokens_;
+  NgramTrie trie_;
+  bool pool_is_string_ = false;
 
   size_t output_size_ = 0;
 
@@ -153,6 +162,17 @@ struct TfIdfVectorizer::Impl {
     assert(ngram_id < ngram_indexes_.size());
     return SafeInt<size_t>(ngram_indexes_[ngram_id]);
   }
+
+  template <class T>
+  inline int32_t TokenOf(const T& item) const {
+    if constexpr (std::is_same_v<T, std::string>) {
+      auto hit = str_tokens_.find(std::string_view(item));
+      return hit == str_tokens_.end() ? NgramTrie::kUnknownToken : hit->second;
+    } else {
+      auto hit = int64_tokens_.find(static_cast<int64_t>(item));
+      return hit == int64_tokens_.end() ? NgramTrie::kUnknownToken : hit->second;
+    }
+  }
 };
 
 TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), impl_(std::make_unique<Impl>()) {
@@ -223,6 +243,7 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
   // Iterator via the pool. Insert 1 item for 1-grams, 2 items for 2-grams, etc.
   const auto total_items = (pool_strings.empty()) ? pool_int64s.size() : pool_strings.size();
+  impl_->pool_is_string_ = !pool_strings.empty();
   size_t ngram_id = 1;  // start with 1, 0 - means no n-gram
   // Load into dictionary only required gram sizes
   const size_t min_gram_length = onnxruntime::narrow<size_t>(impl_->min_gram_length_);
@@ -241,9 +262,19 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
       // Skip loading into hash_set ngrams that are not in the range of [min_gram_length-max_gram_length]
       if (ngram_size >= min_gram_length && ngram_size <= max_gram_length) {
         if (pool_strings.empty()) {
-          ngram_id = PopulateGrams<int64_t>(pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->int64_map_);
+          auto& tokens = impl_->int64_tokens_;
+          ngram_id = PopulateGrams(
+              pool_int64s.begin() + start_idx, ngrams, ngram_size, ngram_id,
+              [&tokens](int64_t item) { return tokens.emplace(item, static_cast<int32_t>(tokens.size())).first->second; },
+              impl_->trie_);
         } else {
-          ngram_id = PopulateGrams<std::string>(pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id, impl_->str_map_);
+          auto& tokens = impl_->str_tokens_;
+          ngram_id = PopulateGrams(
+              pool_strings.begin() + start_idx, ngrams, ngram_size, ngram_id,
+              [&tokens](const std::string& item) {
+                return tokens.emplace(std::string_view(item), static_cast<int32_t>(tokens.size())).first->second;
+              },
+              impl_->trie_);
         }
       } else {
         ngram_id += ngrams;
@@ -255,69 +286,40 @@ TfIdfVectorizer::TfIdfVectorizer(const OpKernelInfo& info) : OpKernel(info), imp
 
 TfIdfVectorizer::~TfIdfVectorizer() = default;
 
-void TfIdfVectorizer::ComputeImpl(const void* x_data_raw, size_t elem_size, ptrdiff_t row_num, size_t row_size,
-                                  bool is_input_string, gsl::span<float> output_data,
+void TfIdfVectorizer::ComputeImpl(gsl::span<const int32_t> row_tokens, size_t start_begin, size_t start_end,
+                                  gsl::span<float> output_data,
                                   std::function<void(size_t, gsl::span<float>&)>& fn_weight) const {
-  const void* const row_begin = AdvanceElementPtr(x_data_raw, row_num * row_size, elem_size);
-  const void* const row_end = AdvanceElementPtr(row_begin, row_size, elem_size);
-
   const auto& impl = *impl_;
-  const auto max_gram_length = impl.max_gram_length_;
-  const auto max_skip_distance = impl.max_skip_count_ + 1;  // Convert to distance
-  auto start_ngram_size = impl.min_gram_length_;
-  size_t output_idx;
-
-  for (auto skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
-    auto ngram_start = row_begin;
-    auto const ngram_row_end = row_end;
-
-    while (ngram_start < ngram_row_end) {
+  const auto& trie = impl.trie_;
+  const size_t row_size = row_tokens.size();
+  const size_t max_gram_length = onnxruntime::narrow<size_t>(impl.max_gram_length_);
+  const size_t max_skip_distance = onnxruntime::narrow<size_t>(impl.max_skip_count_) + 1;  // Convert to distance
+  size_t start_ngram_size = onnxruntime::narrow<size_t>(impl.min_gram_length_);
+
+  for (size_t skip_distance = 1; skip_distance <= max_skip_distance; ++skip_distance) {
+    for (size_t ngram_start = start_begin; ngram_start < start_end; ++ngram_start) {
       // We went far enough so no n-grams of any size can be gathered
-      auto at_least_this = AdvanceElementPtr(ngram_start, SafeInt<size_t>(skip_distance) * (start_ngram_size - 1), elem_size);
-      if (at_least_this >= ngram_row_end) {
+      if (SafeInt<size_t>(skip_distance) * (start_ngram_size - 1) + ngram_start >= row_size) {
         break;
       }
 
-      auto ngram_item = ngram_start;
-      if (is_input_string) {
-        const std::string* str_item = reinterpret_cast<const std::string*>(ngram_item);
-        const StrMap* str_map = &impl.str_map_;
-        for (auto ngram_size = 1;
-             !str_map->empty() &&
-             ngram_size <= max_gram_length &&
-             str_item < ngram_row_end;
-             ++ngram_size, str_item += skip_distance) {
-          auto hit = str_map->find(*str_item);
-          if (hit == str_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          str_map = &hit->second->leafs_;
+      uint32_t node = 0;
+      for (size_t ngram_size = 1, item = ngram_start;
+           ngram_size <= max_gram_length && item < row_size;
+           ++ngram_size, item += skip_distance) {
+        const int32_t token = row_tokens[item];
+        if (token == NgramTrie::kUnknownToken) {
+          break;
         }
-      } else {
-        const IntMap* int_map = &impl.int64_map_;
-        for (auto ngram_size = 1;
-             !int_map->empty() &&
-             ngram_size <= max_gram_length &&
-             ngram_item < ngram_row_end;
-             ++ngram_size, ngram_item = AdvanceElementPtr(ngram_item, skip_distance, elem_size)) {
-          int64_t val = (elem_size == 4) ? int64_t{*reinterpret_cast<const int32_t*>(ngram_item)} : *reinterpret_cast<const int64_t*>(ngram_item);
-          auto hit = int_map->find(val);
-          if (hit == int_map->end()) {
-            break;
-          }
-          if (ngram_size >= start_ngram_size && hit->second->id_ != 0) {
-            output_idx = impl.OutputIdToIncrement(hit->second->id_);
-            fn_weight(output_idx, output_data);
-          }
-          int_map = &hit->second->leafs_;
+        node = trie.Child(node, token);
+        if (node == 0) {
+          break;
+        }
+        const size_t ngram_id = trie.NgramId(node);
+        if (ngram_size >= start_ngram_size && ngram_id != 0) {
+          fn_weight(impl.OutputIdToIncrement(ngram_id), output_data);
         }
       }
-      // Sliding window shift
-      ngram_start = AdvanceElementPtr(ngram_start, 1, elem_size);
     }
     // We count UniGrams only once since they are not affected
     // by skip distance
@@ -372,9 +374,7 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
   auto output_data = Y->MutableData<float>();
   const bool is_input_string = X->IsDataTypeString();
 
-  if (total_items == 0 ||
-      (is_input_string && impl_->str_map_.empty()) ||
-      ((X->IsDataType<int32_t>() || X->IsDataType<int64_t>()) && impl_->int64_map_.empty())) {
+  if (total_items == 0 || impl.trie_.Empty() || is_input_string != impl.pool_is_string_) {
     // TfidfVectorizer may receive an empty input when it follows a Tokenizer
     // (for example for a string containing only stopwords).
     // TfidfVectorizer returns a zero tensor of shape
@@ -384,9 +384,30 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
-  auto x_data_raw = ctx->Input<Tensor>(0)->DataRaw();
-  const auto elem_size = X->DataType()->Size();
-  int32_t num_batches = std::min<int32_t>(concurrency::ThreadPool::DegreeOfParallelism(ctx->GetOperatorThreadPool()) * 2, num_rows);
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+
+  // Map every input item to its token id once, all the n-gram matching below works on token ids.
+  auto tokens_buffer = IAllocator::MakeUniquePtr<int32_t>(alloc, total_items);
+  gsl::span<int32_t> tokens(tokens_buffer.get(), total_items);
+  auto map_tokens = [&impl, tp, tokens](auto input, double cost) {
+    concurrency::ThreadPool::TryParallelFor(
+        tp, static_cast<std::ptrdiff_t>(input.size()),
+        TensorOpCost{static_cast<double>(sizeof(input[0])), static_cast<double>(sizeof(int32_t)), cost},
+        [&impl, input, tokens](std::ptrdiff_t begin, std::ptrdiff_t end) {
+          for (std::ptrdiff_t i = begin; i < end; ++i) {
+            tokens[i] = impl.TokenOf(input[i]);
+          }
+        });
+  };
+  if (is_input_string) {
+    map_tokens(X->DataAsSpan<std::string>(), 32.0);
+  } else if (X->IsDataType<int32_t>()) {
+    map_tokens(X->DataAsSpan<int32_t>(), 8.0);
+  } else {
+    map_tokens(X->DataAsSpan<int64_t>(), 8.0);
+  }
 
   const auto& w = impl.weights_;
   std::function<void(size_t, gsl::span<float>&)> fn_weight;
@@ -414,18 +435,66 @@ Status TfIdfVectorizer::Compute(OpKernelContext* ctx) const {
       assert(false);
   }
 
-  std::function<void(ptrdiff_t)> fn = [this, C, output_data, x_data_raw, elem_size,
-                                       is_input_string, num_batches, num_rows, &fn_weight](ptrdiff_t batch_num) {
-    // Frequency holder allocate [B..output_size_] and init all to zero.
-    auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<size_t>(num_rows));
-    for (auto row_num = work.start; row_num < work.end; ++row_num) {
-      auto out = gsl::span<float>(output_data + row_num * this->impl_->output_size_, this->impl_->output_size_);
-      std::fill(out.begin(), out.end(), 0.0f);
-      ComputeImpl(x_data_raw, elem_size, row_num, C, is_input_string, out, fn_weight);
+  const size_t output_size = impl.output_size_;
+  const int32_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(tp);
+
+  // With fewer rows than threads, long rows are split by n-gram start position as well. Every shard but the
+  // first counts into its own zeroed buffer which is merged into the row afterwards, so this is only done
+  // when the row is long compared to the output.
+  constexpr size_t kMinItemsPerShard = 1024;
+  size_t row_shards = 1;
+  if (num_rows < degree_of_parallelism && C >= 2 * kMinItemsPerShard && output_size <= C) {
+    row_shards = std::min<size_t>(static_cast<size_t>(degree_of_parallelism), C / kMinItemsPerShard);
+  }
+
+  if (row_shards == 1) {
+    int32_t num_batches = std::min<int32_t>(degree_of_parallelism * 2, num_rows);
+    std::function<void(ptrdiff_t)> fn = [this, C, output_data, output_size, tokens,
+                                         num_batches, num_rows, &fn_weight](ptrdiff_t batch_num) {
+      // Frequency holder allocate [B..output_size_] and init all to zero.
+      auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_batches, static_cast<size_t>(num_rows));
+      for (auto row_num = work.start; row_num < work.end; ++row_num) {
+        auto out = gsl::span<float>(output_data + row_num * output_size, output_size);
+        std::fill(out.begin(), out.end(), 0.0f);
+        ComputeImpl(tokens.subspan(row_num * C, C), 0, C, out, fn_weight);
+      }
+    };
+
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_batches, std::move(fn));
+    return Status::OK();
+  }
+
+  auto partial_buffer = IAllocator::MakeUniquePtr<float>(alloc, SafeInt<size_t>(row_shards - 1) * output_size);
+  for (int32_t row_num = 0; row_num < num_rows; ++row_num) {
+    auto out = gsl::span<float>(output_data + row_num * output_size, output_size);
+    auto row_tokens = tokens.subspan(row_num * C, C);
+    std::function<void(ptrdiff_t)> fn = [this, C, out, output_size, row_tokens, row_shards,
+                                         &partial_buffer, &fn_weight](ptrdiff_t shard) {
+      auto work = concurrency::ThreadPool::PartitionWork(shard, static_cast<std::ptrdiff_t>(row_shards),
+                                                         static_cast<std::ptrdiff_t>(C));
+      auto shard_out = shard == 0 ? out : gsl::span<float>(partial_buffer.get() + (shard - 1) * output_size, output_size);
+      std::fill(shard_out.begin(), shard_out.end(), 0.0f);
+      ComputeImpl(row_tokens, static_cast<size_t>(work.start), static_cast<size_t>(work.end), shard_out, fn_weight);
+    };
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(row_shards), std::move(fn));
+
+    for (size_t shard = 1; shard < row_shards; ++shard) {
+      const float* partial = partial_buffer.get() + (shard - 1) * output_size;
+      if (impl.weighting_criteria_ == kIDF) {
+        // IDF sets rather than accumulates
+        for (size_t i = 0; i < output_size; ++i) {
+          if (partial[i] != 0.0f) {
+            out[i] = partial[i];
+          }
+        }
+      } else {
+        for (size_t i = 0; i < output_size; ++i) {
+          out[i] += partial[i];
+        }
+      }
     }
-  };
+  }
 
-  concurrency::ThreadPool::TrySimpleParallelFor(ctx->GetOperatorThreadPool(), num_batches, std::move(fn));
   return Status::OK();
 }
 
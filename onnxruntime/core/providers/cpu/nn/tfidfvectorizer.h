@@ -19,7 +19,8 @@ class TfIdfVectorizer final : public OpKernel {
   Status Compute(OpKernelContext* ctx) const override;
 
  private:
-  void ComputeImpl(const void* x_data_raw, size_t elem_size, ptrdiff_t row_num, size_t row_size, bool is_input_string,
+  // Counts the n-grams of row_tokens that start in [start_begin, start_end) into output_data.
+  void ComputeImpl(gsl::span<const int32_t> row_tokens, size_t start_begin, size_t start_end,
                    gsl::span<float> output_data, std::function<void(size_t, gsl::span<float>&)>& fn_weight) const;
 
   struct Impl;
@@ -13,10 +13,13 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 
-#include <queue>
+#include <algorithm>
+#include <cmath>
 #include <utility>
+#include <vector>
 
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 #include "non_max_suppression_helper.h"
 
 // TODO:fix the warnings
@@ -118,6 +121,90 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+struct BoxInfoPtr {
+  float score_{};
+  int64_t index_{};
+
+  BoxInfoPtr() = default;
+  explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
+  inline bool operator<(const BoxInfoPtr& rhs) const {
+    return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
+  }
+};
+
+// Boxes in corner form with their areas, one array per coordinate so a box can be compared against many others
+// in a single vectorizable loop. The coordinates and areas are computed with the same operations as
+// nms_helpers::SuppressByIOU so the results match it exactly.
+struct CornerBoxes {
+  explicit CornerBoxes(size_t num_boxes)
+      : x_min(num_boxes), y_min(num_boxes), x_max(num_boxes), y_max(num_boxes), area(num_boxes) {}
+
+  void Set(size_t i, const float* box, int64_t center_point_box) {
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2]
+      MaxMin(box[1], box[3], x_min[i], x_max[i]);
+      MaxMin(box[0], box[2], y_min[i], y_max[i]);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min[i] = box[0] - width_half;
+      x_max[i] = box[0] + width_half;
+      y_min[i] = box[1] - height_half;
+      y_max[i] = box[1] + height_half;
+    }
+
+    area[i] = (x_max[i] - x_min[i]) * (y_max[i] - y_min[i]);
+  }
+
+  void Copy(size_t dst, const CornerBoxes& src_boxes, size_t src) {
+    x_min[dst] = src_boxes.x_min[src];
+    y_min[dst] = src_boxes.y_min[src];
+    x_max[dst] = src_boxes.x_max[src];
+    y_max[dst] = src_boxes.y_max[src];
+    area[dst] = src_boxes.area[src];
+  }
+
+  std::vector<float> x_min, y_min, x_max, y_max, area;
+};
+
+// Returns true if box `index` of `boxes` overlaps any of the first `num_selected` entries of `selected` by more
+// than iou_threshold. No early exit so the loop can be vectorized.
+bool SuppressedBySelected(const CornerBoxes& boxes, size_t index, const CornerBoxes& selected, size_t num_selected,
+                          float iou_threshold) {
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+
+  const float* sel_x_min = selected.x_min.data();
+  const float* sel_y_min = selected.y_min.data();
+  const float* sel_x_max = selected.x_max.data();
+  const float* sel_y_max = selected.y_max.data();
+  const float* sel_area = selected.area.data();
+
+  bool suppressed = false;
+  for (size_t i = 0; i < num_selected; ++i) {
+    const float intersection_width = std::min(x_max, sel_x_max[i]) - std::max(x_min, sel_x_min[i]);
+    const float intersection_height = std::min(y_max, sel_y_max[i]) - std::max(y_min, sel_y_min[i]);
+    const float intersection_area = intersection_width * intersection_height;
+    const float union_area = area + sel_area[i] - intersection_area;
+
+    const bool overlaps = intersection_width > .0f && intersection_height > .0f && intersection_area > .0f &&
+                          area > .0f && sel_area[i] > .0f && union_area > .0f &&
+                          intersection_area / union_area > iou_threshold;
+    suppressed |= overlaps;
+  }
+
+  return suppressed;
+}
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -135,75 +222,105 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto* const boxes_data = pc.boxes_data_;
   const auto* const scores_data = pc.scores_data_;
-
-  struct BoxInfoPtr {
-    float score_{};
-    int64_t index_{};
-
-    BoxInfoPtr() = default;
-    explicit BoxInfoPtr(float score, int64_t idx) : score_(score), index_(idx) {}
-    inline bool operator<(const BoxInfoPtr& rhs) const {
-      return score_ < rhs.score_ || (score_ == rhs.score_ && index_ > rhs.index_);
-    }
-  };
-
   const auto center_point_box = GetCenterPointBox();
+  const size_t num_boxes = static_cast<size_t>(pc.num_boxes_);
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
+  concurrency::ThreadPool* tp = ctx->GetOperatorThreadPool();
 
+  // Convert the boxes of each batch once, rather than for every box pair of every class.
+  std::vector<CornerBoxes> batch_boxes;
+  batch_boxes.reserve(narrow<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
+    batch_boxes.emplace_back(num_boxes);
+  }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, pc.num_batches_ * pc.num_boxes_,
+      TensorOpCost{static_cast<double>(4 * sizeof(float)), static_cast<double>(5 * sizeof(float)), 8.0},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const auto batch_index = narrow<size_t>(i / pc.num_boxes_);
+          const auto box_index = narrow<size_t>(i % pc.num_boxes_);
+          batch_boxes[batch_index].Set(box_index, boxes_data + 4 * i, center_point_box);
         }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+      });
+
+  // Each (batch, class) pair is independent. Selections are collected per pair and concatenated afterwards so the
+  // output order doesn't depend on the sharding.
+  const std::ptrdiff_t num_batch_classes = narrow<std::ptrdiff_t>(pc.num_batches_ * pc.num_classes_);
+  std::vector<std::vector<int64_t>> selected_per_batch_class(narrow<size_t>(num_batch_classes));
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), num_boxes);
+
+  const double per_class_cost = static_cast<double>(num_boxes) * (std::log2(static_cast<double>(num_boxes) + 1) + 4);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_batch_classes,
+      TensorOpCost{static_cast<double>(num_boxes * sizeof(float)), static_cast<double>(max_selected * sizeof(int64_t)),
+                   per_class_cost},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        candidate_boxes.reserve(num_boxes);
+        CornerBoxes selected_boxes(max_selected);
+
+        for (std::ptrdiff_t batch_class = first; batch_class < last; ++batch_class) {
+          const auto batch_index = narrow<size_t>(batch_class / pc.num_classes_);
+          const CornerBoxes& boxes = batch_boxes[batch_index];
+
+          // Filter by score_threshold_
+          candidate_boxes.clear();
+          const auto* class_scores = scores_data + batch_class * pc.num_boxes_;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
-        }
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+          // Pop the candidates in score order from a heap, as usually only a few of them are needed.
+          std::make_heap(candidate_boxes.begin(), candidate_boxes.end());
+          auto heap_end = candidate_boxes.end();
+
+          auto& selected_indices = selected_per_batch_class[batch_class];
+          size_t num_selected = 0;
+
+          // Get the next box with top score, filter by iou_threshold
+          while (heap_end != candidate_boxes.begin() && num_selected < max_selected) {
+            std::pop_heap(candidate_boxes.begin(), heap_end);
+            --heap_end;
+            const auto next_top_index = narrow<size_t>(heap_end->index_);
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union)
+            // threshold
+            if (!SuppressedBySelected(boxes, next_top_index, selected_boxes, num_selected, iou_threshold)) {
+              selected_boxes.Copy(num_selected++, boxes, next_top_index);
+              selected_indices.push_back(heap_end->index_);
+            }
+          }
         }
-        sorted_boxes.pop();
-      }  // while
-    }  // for class_index
-  }  // for batch_index
+      });
+
+  size_t num_selected = 0;
+  for (const auto& selected_indices : selected_per_batch_class) {
+    num_selected += selected_indices.size();
+  }
 
   constexpr auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+
+  for (std::ptrdiff_t batch_class = 0; batch_class < num_batch_classes; ++batch_class) {
+    const int64_t batch_index = batch_class / pc.num_classes_;
+    const int64_t class_index = batch_class % pc.num_classes_;
+    for (int64_t box_index : selected_per_batch_class[batch_class]) {
+      *output_data++ = SelectedIndex(batch_index, class_index, box_index);
+    }
+  }
 
   return Status::OK();
 }
@@ -4,6 +4,7 @@
 #include "lstm_base.h"
 #include "uni_directional_lstm.h"
 #include "core/common/narrow.h"
+#include "core/platform/threadpool.h"
 // TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(disable : 26451)
@@ -153,10 +154,30 @@ Status LSTMBase::ComputeImpl(OpKernelContext& context,
                                         initial_cell_2, activation_funcs_.Entries()[3], activation_funcs_.Entries()[4],
                                         activation_funcs_.Entries()[5], clip_, thread_pool);
 
-    fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
-               hidden_output_1, last_cell_1);
-    bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
-               hidden_output_2, last_cell_2);
+    // The time steps are a chain of small GEMMs and gate computations that a single direction can't spread over
+    // the thread pool unless it's batch parallel. In that case run the input projections for both directions on
+    // the whole pool, and then the two recurrences side by side as they write to disjoint parts of the outputs.
+    const bool run_directions_concurrently =
+        concurrency::ThreadPool::DegreeOfParallelism(thread_pool) > 1 && !fw.IsBatchParallel() &&
+        static_cast<double>(batch_size) * 4 * hidden_size_ * hidden_size_ <= kMaxStepComplexityForConcurrentDirections;
+
+    if (run_directions_concurrently) {
+      fw.ComputeInputProjection(input, sequence_lens_span, W_1);
+      bw.ComputeInputProjection(input, sequence_lens_span, W_2);
+
+      concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, 2, [&](std::ptrdiff_t direction) {
+        if (direction == 0) {
+          fw.ComputeRecurrence(num_directions_, R_1, output_1, hidden_output_1, last_cell_1, nullptr);
+        } else {
+          bw.ComputeRecurrence(num_directions_, R_2, output_2, hidden_output_2, last_cell_2, nullptr);
+        }
+      });
+    } else {
+      fw.Compute(input, sequence_lens_span, num_directions_, W_1, R_1, output_1,
+                 hidden_output_1, last_cell_1);
+      bw.Compute(input, sequence_lens_span, num_directions_, W_2, R_2, output_2,
+                 hidden_output_2, last_cell_2);
+    }
   } else {
     lstm::UniDirectionalLstm<InputT> fw(alloc, logger, seq_length, batch_size, input_size, hidden_size_, direction_,
                                         input_forget_, bias_1, peephole_weights_1, initial_hidden_1, initial_cell_1,
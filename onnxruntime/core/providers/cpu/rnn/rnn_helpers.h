@@ -44,6 +44,11 @@ inline Direction MakeDirection(const std::string& direction) {
             "'. Must be one of 'forward', 'reverse', or 'bidirectional'.");
 }
 
+// Upper bound on the per-step recurrent GEMM work (batch_size * number of gates * hidden_size * hidden_size) for
+// running the forward and reverse directions of a bidirectional LSTM or GRU concurrently. Above this a single
+// direction's step is large enough for MLAS to spread it over the thread pool.
+constexpr double kMaxStepComplexityForConcurrentDirections = 256 * 1024;
+
 /** Allocate a unique_ptr using allocator_, and return a span to the allocated memory so usage is safe
 @param allocator IAllocator to use for the allocation.
 @param size Allocation size. Number of elements of type TAlloc, or total size if TAlloc is 'void'.
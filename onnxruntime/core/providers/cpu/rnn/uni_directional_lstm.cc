@@ -62,6 +62,7 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
       clip_(clip),
       use_bias_(!bias.empty()),
       use_peepholes_(!peephole_weights.empty()),
+      fuse_iof_gates_(!use_peepholes_ && !input_forget),
       thread_pool_(thread_pool),
       training_mode_(training_mode) {
   activation_f_ = {deepcpu::ActivationFuncByName(activation_func_f.name), activation_func_f.alpha,
@@ -103,10 +104,12 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   }
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    bias_WR_ = Allocate(allocator_, 4 * hidden_size_, bias_WR_ptr_);
+    int i = 0;
+    bias_WRi_ = bias_WR_.subspan((i++) * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan((i++) * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan((i++) * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan((i++) * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -228,6 +231,17 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
                                         gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
                                         gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                                         gsl::span<T>& output_iofc) {
+  ComputeInputProjectionImpl(inputs_arg, sequence_lengths_arg, input_weights, output_iofc);
+  ComputeRecurrenceImpl(num_directions, recurrent_weights, outputs, final_hidden_state, final_cell_state,
+                        all_cell_states, output_iofc, thread_pool_);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeInputProjectionImpl(const gsl::span<const T>& inputs_arg,
+                                                       const gsl::span<const int>& sequence_lengths_arg,
+                                                       const GemmWeights<WeightT>& input_weights,
+                                                       gsl::span<T>& output_iofc) {
   // copy spans (just T* and size, not data in span) as we may change them
   gsl::span<const T> inputs = inputs_arg;
   gsl::span<const int> sequence_lengths = sequence_lengths_arg;
@@ -238,6 +252,49 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
     sequence_lengths = sequence_lengths_;
   }
 
+  step_sequence_lengths_ = sequence_lengths;
+
+  if (direction_ == kReverse) {
+    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool_);
+    inputs = inputs_reverse_;
+  }
+
+  // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
+
+  // Calculate the max and min length
+  const auto min_max_pair = std::minmax_element(sequence_lengths.begin(), sequence_lengths.end());
+  max_sequence_length_ = *min_max_pair.second;
+  min_sequence_length_ = std::min(seq_length_, *min_max_pair.first);
+
+  const int hidden_size_x4 = 4 * hidden_size_;
+  const int total_rows = max_sequence_length_ * batch_size_;
+
+  AllocateQuantizeBuffers<WeightT>(max_sequence_length_);
+
+  // apply the weights to all the inputs and save to output_IOFC
+  // first call to ComputeGemm zeros out any existing data
+  ComputeGemm(total_rows, hidden_size_x4, input_size_, 1.0f, inputs,
+              input_weights,
+              0.0f, output_iofc, hidden_size_x4,
+              quantized_input_or_a_.data(),
+              nullptr,
+              thread_pool_);
+
+  DumpMatrix("Xt*(W[iofc]^T)", output_iofc.data(), total_rows, hidden_size_x4);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeRecurrenceImpl(const int num_directions,
+                                                  const GemmWeights<WeightT>& recurrent_weights,
+                                                  gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
+                                                  gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
+                                                  gsl::span<T>& output_iofc,
+                                                  concurrency::ThreadPool* thread_pool) {
+  const gsl::span<const int> sequence_lengths = step_sequence_lengths_;
+  const int max_sequence_length = max_sequence_length_;
+  const int min_sequence_length = min_sequence_length_;
+
   // LSTM Layer
   gsl::span<const T> batched_hidden_state_one_step = batched_hidden0_;
   gsl::span<T> batched_internal_state_prev_one_step = batched_internal_memory_prev_;
@@ -258,41 +315,15 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   gsl::span<T> original_outputs = outputs;
   const bool output_sequence = !outputs.empty();
 
-  if (direction_ == kReverse) {
-    ReverseSequence(inputs, inputs_reverse_, sequence_lengths, seq_length_, batch_size_, input_size_, 1, thread_pool_);
-    inputs = inputs_reverse_;
-
-    if (output_sequence)
-      outputs = outputs_reverse_;
+  if (direction_ == kReverse && output_sequence) {
+    outputs = outputs_reverse_;
   }
 
-  // DumpMatrix("Input", inputs.data(), seq_length_, batch_size_ * input_size_);
-
-  // Calculate the max and min length
-  const auto min_max_pair = std::minmax_element(sequence_lengths.begin(), sequence_lengths.end());
-  int max_sequence_length = *min_max_pair.second;
-  int min_sequence_length = std::min(seq_length_, *min_max_pair.first);
-
   ///**************************LSTM Calculations****************************/
-  float alpha = 1.0f;
-  float beta = 0.0f;  // first call to ComputeGemm zeros out any existing data
+  const float alpha = 1.0f;
+  const float beta = 1.0f;  // calls to ComputeGemm add to the Xt*(W[iofc]^T) values
 
   const int hidden_size_x4 = 4 * hidden_size_;
-  const int total_rows = max_sequence_length * batch_size_;
-
-  AllocateQuantizeBuffers<WeightT>(max_sequence_length);
-
-  // apply the weights to all the inputs and save to output_IOFC
-  ComputeGemm(total_rows, hidden_size_x4, input_size_, alpha, inputs,
-              input_weights,
-              beta, output_iofc, hidden_size_x4,
-              quantized_input_or_a_.data(),
-              nullptr,
-              thread_pool_);
-
-  DumpMatrix("Xt*(W[iofc]^T)", output_iofc.data(), total_rows, hidden_size_x4);
-
-  beta = 1.0f;  // calls to ComputeGemm now add to existing data
 
   // NOTE: we could refine the bounds checking in the calls below that use these values to instead
   // explicitly check just the range for each iteration, however if it's going to run over
@@ -301,8 +332,11 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
   const span_T_iter C_prev_end = batched_internal_state_prev_one_step.end();
   const span_T_iter C_prev_clipped_end = batched_internal_state_clipped_one_step.end();
 
+  // without a thread pool there's nothing to gain from splitting the batch
+  const bool batch_parallel = batch_parallel_ && thread_pool != nullptr;
+
   int num_seq_to_compute = batch_size_;
-  if (batch_parallel_) {
+  if (batch_parallel) {
     num_seq_to_compute = batch_size_ / num_threads_;
     if (batch_size_ % num_threads_ != 0)
       num_seq_to_compute++;
@@ -325,6 +359,11 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
     // after the first step this will switch to the output from the previous step
     auto previous_state = batched_hidden_state_one_step.begin() + seq_start * hidden_size_;
 
+    // rows past their sequence length are skipped by GateComputations, so the recurrent GEMM for a step only
+    // needs to cover rows up to the last one still active. with lengths sorted in decreasing order (packed
+    // batches) this shrinks the GEMM as sequences finish.
+    int num_active_rows = num_seq_to_compute_adjusted;
+
     // run through steps sequentially
     for (int step = 0; step < max_sequence_length; step++) {
 #if defined(DUMP_MATRIXES)
@@ -333,16 +372,23 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
       span_T_iter step_out_IOFC = output_iofc.begin() + (step * batch_size_ + seq_start) * hidden_size_x4;
 
+      if (step >= min_sequence_length) {
+        while (num_active_rows > 0 && step >= sequence_lengths[seq_start + num_active_rows - 1])
+          --num_active_rows;
+      }
+
       // calculate Xt*(W[iofc]^T) + Ht-t*R[iofc]
       // Do it sequentially to avoid nested parallelism
-      ComputeGemm(num_seq_to_compute_adjusted, hidden_size_x4, hidden_size_, alpha,
-                  gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
-                  recurrent_weights,                                                          // R[iofc]
-                  beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
-                  hidden_size_x4,
-                  quantized_input_or_a_.data() + (seq_start * hidden_size_),
-                  quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
-                  ttp);
+      if (num_active_rows > 0) {
+        ComputeGemm(num_active_rows, hidden_size_x4, hidden_size_, alpha,
+                    gsl::span<const T>(&*previous_state, previous_state_end - previous_state),  // Ht-1
+                    recurrent_weights,                                                          // R[iofc]
+                    beta, gsl::span<T>(&*step_out_IOFC, output_iofc.end() - step_out_IOFC),     // input contains Xt*(W[iofc]^T)
+                    hidden_size_x4,
+                    quantized_input_or_a_.data() + (seq_start * hidden_size_),
+                    quantized_C_buffer_.data() + (seq_start * hidden_size_x4),
+                    ttp);
+      }
 
       DumpMatrix("Xt*(W[iofc]^T) + Ht-t*R[iofc]" + row_str, &*step_out_IOFC, num_seq_to_compute_adjusted, hidden_size_x4);
 
@@ -400,12 +446,12 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
     }
   };
 
-  if (batch_parallel_) {
+  if (batch_parallel) {
     double gemm_cost = num_seq_to_compute * hidden_size_x4 * hidden_size_;
     double cost = max_sequence_length * (gemm_cost + num_seq_to_compute);
-    ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool_);
+    ExecuteLambdaInParallel(sequences_calculator, batch_size_, num_seq_to_compute, cost, thread_pool);
   } else {
-    sequences_calculator(0, thread_pool_);
+    sequences_calculator(0, thread_pool);
   }
 
   for (int i = 0; i < batch_size_; i++) {
@@ -449,7 +495,7 @@ void UniDirectionalLstm<T>::ComputeImpl(const gsl::span<const T>& inputs_arg,
 
   if (output_sequence && direction_ == Direction::kReverse)
     ReverseSequence<T>(outputs, original_outputs, sequence_lengths, seq_length_, batch_size_, hidden_size_,
-                       num_directions, thread_pool_);
+                       num_directions, thread_pool);
 }
 
 // #define PREVIOUS_BROKEN_VERSION
@@ -497,29 +543,36 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // DumpMatrix("C_prev" + row_str, pCprev_hidden_size, 1, hidden_size_);
 
-    // Input Gate
-    if (use_peepholes_) {
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
-                                   hidden_size_);
-    }
-
-    const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
-    activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
-    // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
-
-    // Forget Gate
-    if (input_forget_) {
-      for (int i = 0; i < hidden_size_; i++) pf[i] = 1.0f - pi[i];
+    if (fuse_iof_gates_) {
+      // i, o and f in one pass. o doesn't depend on Ct without peepholes so it can be computed before Ct.
+      const float* pBiof = use_bias_ ? SafeRawConstPointer<T>(bias_WR_, 0, 3 * hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBiof, pi, 3 * hidden_size_);
+      activation_f_.func(pi, 3 * hidden_size_, activation_f_.alpha, activation_f_.beta);
     } else {
+      // Input Gate
       if (use_peepholes_) {
-        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_), pf,
+        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_i_, 0, hidden_size_), pi,
                                      hidden_size_);
       }
 
-      const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
-      clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
-      activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      const float* pBi = use_bias_ ? SafeRawConstPointer<T>(bias_WRi_, 0, hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBi, pi, hidden_size_);  // post: pi has input to f() to calculate i
+      activation_f_.func(pi, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      // DumpMatrix("i" + row_str, pi, 1, hidden_size_);
+
+      // Forget Gate
+      if (input_forget_) {
+        for (int i = 0; i < hidden_size_; i++) pf[i] = 1.0f - pi[i];
+      } else {
+        if (use_peepholes_) {
+          deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_f_, 0, hidden_size_),
+                                       pf, hidden_size_);
+        }
+
+        const float* pBf = use_bias_ ? SafeRawConstPointer<T>(bias_WRf_, 0, hidden_size_) : nullptr;
+        clip_with_bias_ptr_(clip_, pBf, pf, hidden_size_);
+        activation_f_.func(pf, hidden_size_, activation_f_.alpha, activation_f_.beta);
+      }
     }
 
     // DumpMatrix("f" + row_str, pf, 1, hidden_size_);
@@ -554,14 +607,16 @@ void UniDirectionalLstm<T>::GateComputations(
     }
 
     // Output Gate
-    if (use_peepholes_)
-      deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_), po,
-                                   hidden_size_);
-
-    // calculate 'ot'
-    const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
-    clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
-    activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    if (!fuse_iof_gates_) {
+      if (use_peepholes_)
+        deepcpu::elementwise_product(pCprev_hidden_size, SafeRawConstPointer<const T>(peephole_o_, 0, hidden_size_), po,
+                                     hidden_size_);
+
+      // calculate 'ot'
+      const float* pBo = use_bias_ ? SafeRawConstPointer<T>(bias_WRo_, 0, hidden_size_) : nullptr;
+      clip_with_bias_ptr_(clip_, pBo, po, hidden_size_);
+      activation_f_.func(po, hidden_size_, activation_f_.alpha, activation_f_.beta);
+    }
     // DumpMatrix("o" + row_str, po, 1, hidden_size_);
 
     // calculate 'Ht'
@@ -639,6 +694,24 @@ void UniDirectionalLstm<T>::Compute(const gsl::span<const T>& inputs, const gsl:
               final_hidden_state, final_cell_state, all_cell_states, iofc);
 }
 
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeInputProjection(const gsl::span<const T>& inputs,
+                                                   const gsl::span<const int>& sequence_lengths,
+                                                   const GemmWeights<WeightT>& input_weights) {
+  ComputeInputProjectionImpl(inputs, sequence_lengths, input_weights, output_iofc_);
+}
+
+template <typename T>
+template <typename WeightT>
+void UniDirectionalLstm<T>::ComputeRecurrence(int num_directions, const GemmWeights<WeightT>& recurrent_weights,
+                                              gsl::span<T>& outputs, gsl::span<T>& final_hidden_state,
+                                              gsl::span<T>& final_cell_state, concurrency::ThreadPool* thread_pool) {
+  gsl::span<T> dummy_all_cell_states = gsl::span<T>();
+  ComputeRecurrenceImpl(num_directions, recurrent_weights, outputs, final_hidden_state, final_cell_state,
+                        dummy_all_cell_states, output_iofc_, thread_pool);
+}
+
 template class UniDirectionalLstm<float>;
 template void UniDirectionalLstm<float>::Compute<float>(
     const gsl::span<const float>& inputs_arg,
@@ -654,5 +727,21 @@ template void UniDirectionalLstm<float>::Compute<uint8_t>(
     gsl::span<float>& outputs,
     gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state);
 
+template void UniDirectionalLstm<float>::ComputeInputProjection<float>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths,
+    const GemmWeights<float>& input_weights);
+
+template void UniDirectionalLstm<float>::ComputeInputProjection<uint8_t>(
+    const gsl::span<const float>& inputs, const gsl::span<const int>& sequence_lengths,
+    const GemmWeights<uint8_t>& input_weights);
+
+template void UniDirectionalLstm<float>::ComputeRecurrence<float>(
+    int num_directions, const GemmWeights<float>& recurrent_weights, gsl::span<float>& outputs,
+    gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state, concurrency::ThreadPool* thread_pool);
+
+template void UniDirectionalLstm<float>::ComputeRecurrence<uint8_t>(
+    int num_directions, const GemmWeights<uint8_t>& recurrent_weights, gsl::span<float>& outputs,
+    gsl::span<float>& final_hidden_state, gsl::span<float>& final_cell_state, concurrency::ThreadPool* thread_pool);
+
 }  // namespace lstm
 }  // namespace onnxruntime
@@ -47,6 +47,22 @@ class UniDirectionalLstm {
                gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                gsl::span<T>& iofc);
 
+  // Compute split in two so the directions of a bidirectional LSTM can run side by side.
+  // ComputeInputProjection reverses the inputs if needed and applies W[iofc] to all steps using the thread pool
+  // provided at construction. ComputeRecurrence then runs the time steps using `thread_pool`, which must be
+  // nullptr when called from inside a parallel loop.
+  template <typename WeightT>
+  void ComputeInputProjection(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                              const GemmWeights<WeightT>& input_weights);
+
+  template <typename WeightT>
+  void ComputeRecurrence(int num_directions, const GemmWeights<WeightT>& recurrent_weights, gsl::span<T>& outputs,
+                         gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state,
+                         concurrency::ThreadPool* thread_pool);
+
+  // true if the time steps are run by partitioning the batch rows across the thread pool
+  bool IsBatchParallel() const { return batch_parallel_; }
+
   ~UniDirectionalLstm() = default;
 
  private:
@@ -74,6 +90,16 @@ class UniDirectionalLstm {
                    gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state, gsl::span<T>& all_cell_states,
                    gsl::span<T>& output_iofc);
 
+  template <typename WeightT>
+  void ComputeInputProjectionImpl(const gsl::span<const T>& inputs, const gsl::span<const int>& sequence_lengths,
+                                  const GemmWeights<WeightT>& input_weights, gsl::span<T>& output_iofc);
+
+  template <typename WeightT>
+  void ComputeRecurrenceImpl(int num_directions, const GemmWeights<WeightT>& recurrent_weights,
+                             gsl::span<T>& outputs, gsl::span<T>& final_hidden_state, gsl::span<T>& final_cell_state,
+                             gsl::span<T>& all_cell_states, gsl::span<T>& output_iofc,
+                             concurrency::ThreadPool* thread_pool);
+
   AllocatorPtr allocator_;
   const logging::Logger& logger_;
 
@@ -91,6 +117,10 @@ class UniDirectionalLstm {
   bool use_bias_;
   bool use_peepholes_;
 
+  // i, o and f share f() and are adjacent in the IOFC layout, so without peepholes or coupled input-forget
+  // they are clipped and activated as one 3 * hidden_size block
+  bool fuse_iof_gates_;
+
   int num_threads_ = -1;
 
   // output_iofc_ptr_ and output_iofc_ are not used when training_mode_ is true.
@@ -106,9 +136,11 @@ class UniDirectionalLstm {
   gsl::span<T> internal_memory_prev_, batched_internal_memory_prev_;
   gsl::span<T> batched_internal_memory_clipped_;
 
-  IAllocatorUniquePtr<T> bias_WRi_ptr_, bias_WRf_ptr_, bias_WRo_ptr_, bias_WRc_ptr_;
+  // fused Wb + Rb in IOFC order. bias_WRi_ etc. are views into bias_WR_
+  IAllocatorUniquePtr<T> bias_WR_ptr_;
   IAllocatorUniquePtr<T> peephole_i_ptr_, peephole_f_ptr_, peephole_o_ptr_;
   IAllocatorUniquePtr<T> inputs_reverse_ptr_, outputs_reverse_ptr_;
+  gsl::span<T> bias_WR_;
   gsl::span<T> bias_WRi_, bias_WRf_, bias_WRo_, bias_WRc_;
   gsl::span<T> inputs_reverse_, outputs_reverse_;
 
@@ -121,6 +153,11 @@ class UniDirectionalLstm {
   IAllocatorUniquePtr<int> sequence_lengths_ptr_;
   gsl::span<int> sequence_lengths_;
 
+  // set by ComputeInputProjectionImpl for use by ComputeRecurrenceImpl
+  gsl::span<const int> step_sequence_lengths_;
+  int max_sequence_length_ = 0;
+  int min_sequence_length_ = 0;
+
   deepcpu::ClipWithBiasFuncPtr clip_with_bias_ptr_;
 
   ActivationInfo<deepcpu::ActivationFuncPtr> activation_f_;
@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/upsample.h"
 
+#include <algorithm>
 #include <limits>
 
 #include "core/common/inlined_containers.h"
@@ -15,6 +16,9 @@ using namespace std;
 using onnxruntime::narrow;
 namespace onnxruntime {
 
+// Below this many output elements dispatching to the intra-op thread pool costs more than the work itself.
+constexpr int64_t kMinParallelResizeOutputSize = 64;
+
 #define REGISTER_VERSIONED_TYPED_KERNEL(T, start, end)                          \
   ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                     \
       Upsample,                                                                 \
@@ -854,54 +858,56 @@ void UpsampleTrilinear(int64_t batch_size,
                                              depth_scale, height_scale, width_scale, roi,
                                              alloc, get_original_coordinate);
 
-  for (int64_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, static_cast<std::ptrdiff_t>(num_channels),
-        [&](std::ptrdiff_t c) {
-          const T* Xdata = XdataBase + (n * num_channels + c) * (input_depth * input_height * input_width);
-          T* Ydata = YdataBase + (n * num_channels + c) * (output_depth * output_height * output_width);
-          for (int64_t z = 0; z < output_depth; ++z) {
-            for (int64_t y = 0; y < output_height; ++y) {
-              for (int64_t x = 0; x < output_width; ++x) {
-                // when use_extrapolation is set and original index of x or y is out of the dim range
-                // then use extrapolation_value as the output value.
-                if (use_extrapolation &&
-                    ((p.z_original[narrow<size_t>(z)] < 0 || p.z_original[narrow<size_t>(z)] > static_cast<float>(input_depth - 1)) ||
-                     (p.y_original[narrow<size_t>(y)] < 0 || p.y_original[narrow<size_t>(y)] > static_cast<float>(input_height - 1)) ||
-                     (p.x_original[narrow<size_t>(x)] < 0 || p.x_original[narrow<size_t>(x)] > static_cast<float>(input_width - 1)))) {
-                  Ydata[output_width * output_height * z + output_width * y + x] =
-                      static_cast<T>(extrapolation_value);
-                  continue;
-                }
-
-                // subscript ordering in the variable - (xyz)
-                T X111 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X211 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-                T X121 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X221 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-
-                T X112 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X212 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-                T X122 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
-                T X222 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
-
+  // shard over all (n, c, z) output slices so small batch/channel counts still use the whole pool
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(batch_size * num_channels * output_depth),
+      TensorOpCost{static_cast<double>(output_height * output_width * 8 * sizeof(T)),
+                   static_cast<double>(output_height * output_width * sizeof(T)),
+                   static_cast<double>(output_height * output_width * 24)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t slice = first; slice < last; ++slice) {
+          const std::ptrdiff_t nc = slice / output_depth;
+          const int64_t z = slice % output_depth;
+          const T* Xdata = XdataBase + nc * (input_depth * input_height * input_width);
+          T* Ydata = YdataBase + nc * (output_depth * output_height * output_width);
+          for (int64_t y = 0; y < output_height; ++y) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              // when use_extrapolation is set and original index of x or y is out of the dim range
+              // then use extrapolation_value as the output value.
+              if (use_extrapolation &&
+                  ((p.z_original[narrow<size_t>(z)] < 0 || p.z_original[narrow<size_t>(z)] > static_cast<float>(input_depth - 1)) ||
+                   (p.y_original[narrow<size_t>(y)] < 0 || p.y_original[narrow<size_t>(y)] > static_cast<float>(input_height - 1)) ||
+                   (p.x_original[narrow<size_t>(x)] < 0 || p.x_original[narrow<size_t>(x)] > static_cast<float>(input_width - 1)))) {
                 Ydata[output_width * output_height * z + output_width * y + x] =
-                    static_cast<T>(p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X111 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X211 +
-                                   p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X121 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X221 +
-
-                                   p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X112 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X212 +
-                                   p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X122 +
-                                   p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X222);
+                    static_cast<T>(extrapolation_value);
+                continue;
               }
+
+              // subscript ordering in the variable - (xyz)
+              T X111 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X211 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+              T X121 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X221 = Xdata[p.input_height_width_mul_z1[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+
+              T X112 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X212 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y1[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+              T X122 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x1[narrow<size_t>(x)]];
+              T X222 = Xdata[p.input_height_width_mul_z2[narrow<size_t>(z)] + p.input_width_mul_y2[narrow<size_t>(y)] + p.in_x2[narrow<size_t>(x)]];
+
+              Ydata[output_width * output_height * z + output_width * y + x] =
+                  static_cast<T>(p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X111 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X211 +
+                                 p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X121 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz2[narrow<size_t>(z)] * X221 +
+
+                                 p.dx2[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X112 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy2[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X212 +
+                                 p.dx2[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X122 +
+                                 p.dx1[narrow<size_t>(x)] * p.dy1[narrow<size_t>(y)] * p.dz1[narrow<size_t>(z)] * X222);
             }
           }
-          Xdata += input_depth * input_height * input_width;
-          Ydata += output_depth * output_width * output_height;
-        });
-  }
+        }
+      });
 }
 
 // Calculates cubic coeff based on Robert Keys approach
@@ -918,49 +924,94 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Per-axis sampling table for 'Cubic' mode. For every output coordinate it holds the clamped input
+// indices of the 4-tap window and the matching weights, already renormalized when exclude_outside is set,
+// so the interpolation itself is a plain weighted sum that can be evaluated separably along each axis.
+struct CubicAxisParams {
+  std::vector<int64_t> index;          // output_size * CubicModeGridLength
+  std::vector<float> weight;           // output_size * CubicModeGridLength
+  std::vector<int64_t> out_of_bound;   // output coordinates that take extrapolation_value
+  std::vector<uint8_t> is_out_of_bound;
+};
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+static CubicAxisParams SetupResizeCubicAxis(int64_t input_size,
+                                            int64_t output_size,
+                                            float scale,
+                                            float roi_start,
+                                            float roi_end,
+                                            float cubic_coeff_a,
+                                            bool use_extrapolation,
+                                            bool exclude_outside,
+                                            const GetOriginalCoordinateFunc& get_original_coordinate) {
+  CubicAxisParams p;
+  p.index.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+  p.weight.resize(narrow<size_t>(output_size) * CubicModeGridLength);
+  p.is_out_of_bound.resize(narrow<size_t>(output_size));
+
+  for (int64_t i = 0; i < output_size; ++i) {
+    float in_x = scale == 1 ? static_cast<float>(i)
+                            : get_original_coordinate(static_cast<float>(i), scale,
+                                                      static_cast<float>(output_size),
+                                                      static_cast<float>(input_size),
+                                                      roi_start, roi_end);
+    int64_t* index = &p.index[narrow<size_t>(i) * CubicModeGridLength];
+    float* weight = &p.weight[narrow<size_t>(i) * CubicModeGridLength];
+
+    // when use_extrapolation is set and original index is out of the dim range
+    // then use extrapolation_value as the output value.
+    if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_size - 1))) {
+      p.out_of_bound.push_back(i);
+      p.is_out_of_bound[narrow<size_t>(i)] = 1;
+      std::fill_n(index, CubicModeGridLength, int64_t{0});
+      std::fill_n(weight, CubicModeGridLength, 0.0f);
+      continue;
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    const auto x_int = static_cast<int64_t>(std::floor(in_x));
+    const auto coeffs = GetCubicCoeffs(in_x - static_cast<float>(x_int), cubic_coeff_a);
+    float coeff_sum = 1.0f;
+    if (exclude_outside) {
+      // When true, the weight of sampling locations outside the grid will be set to 0
+      // and the weight will be renormalized so that their sum is 1.0
+      coeff_sum = 0.0f;
+      for (size_t k = 0; k < CubicModeGridLength; ++k) {
+        const int64_t x_val = x_int - 1 + static_cast<int64_t>(k);
+        weight[k] = (x_val < 0 || x_val >= input_size) ? 0.0f : coeffs[k];
+        coeff_sum += weight[k];
+      }
+    } else {
+      std::copy(coeffs.begin(), coeffs.end(), weight);
+    }
+
+    for (size_t k = 0; k < CubicModeGridLength; ++k) {
+      const int64_t x_val = x_int - 1 + static_cast<int64_t>(k);
+      index[k] = std::max<int64_t>(0, std::min<int64_t>(x_val, input_size - 1));
+      weight[k] = coeff_sum == 0.0f ? 0.0f : weight[k] / coeff_sum;
+    }
   }
-  cache[grid_start_pos] = result;
 
-  return result;
+  return p;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
+
+template <typename T>
+inline T CubicResultCast(float value) {
+  if constexpr (std::is_integral_v<T>) {
+    // cubic weights may over/undershoot the input range, so saturate instead of wrapping around.
+    // clamp in double: the int32 maximum rounds up to 2^31 as a float, which is out of range for the cast back.
+    static_assert(sizeof(T) <= sizeof(int32_t), "the limits of T must be exactly representable as double");
+    double result = std::round(static_cast<double>(value));
+    result = std::clamp(result, static_cast<double>(std::numeric_limits<T>::lowest()),
+                        static_cast<double>(std::numeric_limits<T>::max()));
+    return static_cast<T>(result);
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
+// The following method supports a 4-D input in 'Cubic mode' with the outermost 2 scale values being 1
+// (or a 2-D input). The bicubic kernel is separable, so the input is first interpolated along the width
+// into a [N * C * input_height, output_width] scratch buffer and then along the height, each pass
+// sharded by rows across the thread pool.
 template <typename T>
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
@@ -977,138 +1028,96 @@ void ResizeBiCubic(int64_t batch_size,
                    gsl::span<const float> roi,
                    const T* Xdata,
                    T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
-  std::vector<float> y_original;
-  y_original.reserve(narrow<size_t>(output_height));
-
-  std::vector<float> x_original;
-  x_original.reserve(narrow<size_t>(output_width));
-
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
-  auto roi_y_start = roi.size() / 2 - 2;
-  auto roi_y_end = roi.size() - 2;
-  auto roi_x_start = roi.size() / 2 - 1;
-  auto roi_x_end = roi.size() - 1;
-
-  // generate coefficients in y direction
+                   AllocatorPtr& alloc,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
+  const auto roi_y_start = roi.size() / 2 - 2;
+  const auto roi_y_end = roi.size() - 2;
+  const auto roi_x_start = roi.size() / 2 - 1;
+  const auto roi_x_end = roi.size() - 1;
+
+  const CubicAxisParams py = SetupResizeCubicAxis(input_height, output_height, height_scale,
+                                                  roi[roi_y_start], roi[roi_y_end], cubic_coeff_a,
+                                                  use_extrapolation, exclude_outside, get_original_coordinate);
+  const CubicAxisParams px = SetupResizeCubicAxis(input_width, output_width, width_scale,
+                                                  roi[roi_x_start], roi[roi_x_end], cubic_coeff_a,
+                                                  use_extrapolation, exclude_outside, get_original_coordinate);
+
+  // only the input rows referenced by some output row need the horizontal pass
+  std::vector<uint8_t> row_used(narrow<size_t>(input_height), 0);
   for (int64_t y = 0; y < output_height; ++y) {
-    float in_y = height_scale == 1 ? static_cast<float>(y)
-                                   : get_original_coordinate(static_cast<float>(y), height_scale,
-                                                             static_cast<float>(output_height),
-                                                             static_cast<float>(input_height),
-                                                             roi[roi_y_start], roi[roi_y_end]);
-    y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    if (py.is_out_of_bound[narrow<size_t>(y)]) {
+      continue;
     }
-  }
-
-  // generate coefficients in x direction
-  for (int64_t x = 0; x < output_width; ++x) {
-    float in_x = width_scale == 1 ? static_cast<float>(x)
-                                  : get_original_coordinate(static_cast<float>(x),
-                                                            width_scale,
-                                                            static_cast<float>(output_width),
-                                                            static_cast<float>(input_width),
-                                                            roi[roi_x_start], roi[roi_x_end]);
-    x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
+    for (size_t k = 0; k < CubicModeGridLength; ++k) {
+      row_used[narrow<size_t>(py.index[narrow<size_t>(y) * CubicModeGridLength + k])] = 1;
     }
   }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
-
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
+  const int64_t num_planes = batch_size * num_channels;
+  auto row_buffer = IAllocator::MakeUniquePtr<float>(
+      alloc, SafeInt<size_t>(num_planes) * input_height * output_width);
+  float* const Bdata = row_buffer.get();
+
+  // horizontal pass
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_planes * input_height),
+      TensorOpCost{static_cast<double>(input_width * sizeof(T)),
+                   static_cast<double>(output_width * sizeof(float)),
+                   static_cast<double>(output_width * CubicModeGridLength * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          if (!row_used[narrow<size_t>(row % input_height)]) {
+            continue;
           }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
+          const T* Xrow = Xdata + row * input_width;
+          float* Brow = Bdata + row * output_width;
+          const int64_t* index = px.index.data();
+          const float* weight = px.weight.data();
+          for (int64_t x = 0; x < output_width; ++x) {
+            Brow[x] = weight[0] * static_cast<float>(Xrow[index[0]]) +
+                      weight[1] * static_cast<float>(Xrow[index[1]]) +
+                      weight[2] * static_cast<float>(Xrow[index[2]]) +
+                      weight[3] * static_cast<float>(Xrow[index[3]]);
+            index += CubicModeGridLength;
+            weight += CubicModeGridLength;
           }
         }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
+      });
+
+  // vertical pass
+  const T extrapolation = static_cast<T>(extrapolation_value);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_planes * output_height),
+      TensorOpCost{static_cast<double>(output_width * CubicModeGridLength * sizeof(float)),
+                   static_cast<double>(output_width * sizeof(T)),
+                   static_cast<double>(output_width * CubicModeGridLength * 2)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const auto y = narrow<size_t>(row % output_height);
+          T* Yrow = Ydata + row * output_width;
+          if (py.is_out_of_bound[y]) {
+            std::fill_n(Yrow, narrow<size_t>(output_width), extrapolation);
             continue;
           }
 
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
-            }
+          const float* Bplane = Bdata + (row / output_height) * input_height * output_width;
+          const int64_t* index = &py.index[y * CubicModeGridLength];
+          const float* weight = &py.weight[y * CubicModeGridLength];
+          const float* B0 = Bplane + index[0] * output_width;
+          const float* B1 = Bplane + index[1] * output_width;
+          const float* B2 = Bplane + index[2] * output_width;
+          const float* B3 = Bplane + index[3] * output_width;
+          const float w0 = weight[0], w1 = weight[1], w2 = weight[2], w3 = weight[3];
+          for (int64_t x = 0; x < output_width; ++x) {
+            Yrow[x] = CubicResultCast<T>(w0 * B0[x] + w1 * B1[x] + w2 * B2[x] + w3 * B3[x]);
           }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
+          for (int64_t x : px.out_of_bound) {
+            Yrow[x] = extrapolation;
           }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
         }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+      });
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1146,6 +1155,12 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
   }
   AllocatorPtr alloc;
   ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // The kernels below shard over all of N * C (and the spatial rows where they can), so gate threading
+  // on the total amount of output rather than on a single plane.
+  concurrency::ThreadPool* tp = Y->Shape().Size() > kMinParallelResizeOutputSize
+                                    ? context->GetOperatorThreadPool()
+                                    : nullptr;
   switch (mode_) {
     case UpsampleMode::NN:
       return UpsampleNearest<T>(X->Data<T>(), Y->MutableData<T>(), X->Shape(), Y->Shape(),
@@ -1216,13 +1231,13 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
             UpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
                                       height_scale, width_scale, roi, use_extrapolation_, extrapolation_value_, exclude_outside_,
                                       X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                      output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                                      tp);
           } else {
             UpsampleBilinear(batch_size, num_channels, input_height, input_width, output_height, output_width,
                              height_scale, width_scale, roi,
                              use_extrapolation_, extrapolation_value_, X->Data<T>(),
                              Y->MutableData<T>(), alloc, get_original_coordinate_,
-                             output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                             tp);
           }
         } else {
           if (use_extrapolation_) {
@@ -1230,7 +1245,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
               NhwcUpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
                                             height_scale, width_scale, roi, use_extrapolation_, extrapolation_value_, exclude_outside_,
                                             X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                                            tp);
             } else {
               if (!is_2D &&
                   (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
@@ -1239,13 +1254,13 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
                     height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+                    tp);
               } else {
                 NhwcUpsampleBilinear<T, true>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
                     height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+                    tp);
               }
             }
           } else {
@@ -1253,7 +1268,7 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
               NhwcUpsampleBilinearAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
                                             height_scale, width_scale, roi, use_extrapolation_, extrapolation_value_, exclude_outside_,
                                             X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                                            tp);
             } else {
               if (!is_2D &&
                   (Y->GetElementType() == ONNX_NAMESPACE::TensorProto_DataType_UINT8 ||
@@ -1262,13 +1277,13 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
                     height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+                    tp);
               } else {
                 NhwcUpsampleBilinear<T, false>(
                     batch_size, num_channels, input_height, input_width, output_height, output_width,
                     height_scale, width_scale, roi, extrapolation_value_, X->Data<T>(), Y->MutableData<T>(),
                     alloc, get_original_coordinate_,
-                    output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+                    tp);
               }
             }
           }
@@ -1294,14 +1309,14 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                      is_3D ? scales[0] : scales[2], is_3D ? scales[1] : scales[3],
                                      is_3D ? scales[2] : scales[4], roi, use_extrapolation_, extrapolation_value_,
                                      exclude_outside_, X, Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                     output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                                     tp);
         } else {
           UpsampleTrilinear(batch_size, num_channels, input_depth, input_height, input_width,
                             output_depth, output_height, output_width,
                             is_3D ? scales[0] : scales[2], is_3D ? scales[1] : scales[3],
                             is_3D ? scales[2] : scales[4], roi, use_extrapolation_, extrapolation_value_,
                             X->Data<T>(), Y->MutableData<T>(), alloc, get_original_coordinate_,
-                            output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
+                            tp);
         }
         return Status::OK();
       } else {
@@ -1340,19 +1355,19 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
                                      height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                                      extrapolation_value_, exclude_outside_, roi, X,
                                      Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                     output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+                                     tp);
         } else {
           ResizeBiCubicAntiAlias(batch_size, num_channels, input_height, input_width, output_height, output_width,
                                  height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
                                  extrapolation_value_, exclude_outside_, roi, X,
                                  Y->MutableData<T>(), alloc, get_original_coordinate_,
-                                 output_height * output_width * num_channels > 64 ? context->GetOperatorThreadPool() : nullptr);
+                                 tp);
         }
       } else {
         ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                       height_scale, width_scale, cubic_coeff_a_, use_extrapolation_,
-                      extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                      Y->MutableData<float>(), get_original_coordinate_);
+                      extrapolation_value_, exclude_outside_, roi, X->Data<T>(),
+                      Y->MutableData<T>(), alloc, get_original_coordinate_, tp);
       }
       return Status::OK();
     }
@@ -101,38 +101,41 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
-  for (int32_t n = 0; n < batch_size; ++n) {
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, num_channels,
-        [&](std::ptrdiff_t c) {
-          const T* const Xdata =
-              XdataBase + (n * num_channels + static_cast<int32_t>(c)) * (input_height * input_width);
-          T* const Ydata = YdataBase + (n * num_channels + static_cast<int32_t>(c)) * (output_height * output_width);
-          for (int32_t y = 0; y < output_height; ++y) {
-            for (int32_t x = 0; x < output_width; ++x) {
-              const int32_t output_offset = output_width * y + x;
-              // when use_extrapolation is set and original index of x or y is out of the dim range
-              // then use extrapolation_value as the output value.
-              if (use_extrapolation &&
-                  ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
-                   (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
-                Ydata[output_offset] = static_cast<T>(extrapolation_value);
-                continue;
-              }
+  // shard over all (n, c, y) output rows so small batch/channel counts still use the whole pool
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size) * num_channels * output_height,
+      TensorOpCost{static_cast<double>(output_width * 4 * sizeof(T)),
+                   static_cast<double>(output_width * sizeof(T)),
+                   static_cast<double>(output_width * 8)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; ++row) {
+          const std::ptrdiff_t nc = row / output_height;
+          const int32_t y = static_cast<int32_t>(row % output_height);
+          const T* const Xdata = XdataBase + nc * (input_height * input_width);
+          T* const Ydata = YdataBase + nc * (output_height * output_width);
+          for (int32_t x = 0; x < output_width; ++x) {
+            const int32_t output_offset = output_width * y + x;
+            // when use_extrapolation is set and original index of x or y is out of the dim range
+            // then use extrapolation_value as the output value.
+            if (use_extrapolation &&
+                ((p.y_original[y] < 0 || p.y_original[y] > static_cast<float>(input_height - 1)) ||
+                 (p.x_original[x] < 0 || p.x_original[x] > static_cast<float>(input_width - 1)))) {
+              Ydata[output_offset] = static_cast<T>(extrapolation_value);
+              continue;
+            }
 
-              T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
-              T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
-              T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
-              T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
+            T X11 = Xdata[p.input_width_mul_y1[y] + p.in_x1[x]];
+            T X21 = Xdata[p.input_width_mul_y1[y] + p.in_x2[x]];
+            T X12 = Xdata[p.input_width_mul_y2[y] + p.in_x1[x]];
+            T X22 = Xdata[p.input_width_mul_y2[y] + p.in_x2[x]];
 
-              Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
-                                                    p.dx1[x] * p.dy2[y] * X21 +
-                                                    p.dx2[x] * p.dy1[y] * X12 +
-                                                    p.dx1[x] * p.dy1[y] * X22);
-            }
+            Ydata[output_offset] = static_cast<T>(p.dx2[x] * p.dy2[y] * X11 +
+                                                  p.dx1[x] * p.dy2[y] * X21 +
+                                                  p.dx2[x] * p.dy1[y] * X12 +
+                                                  p.dx1[x] * p.dy1[y] * X22);
           }
-        });
-  }
+        }
+      });
 }
 
 template <typename T, bool UseExtrapolation>
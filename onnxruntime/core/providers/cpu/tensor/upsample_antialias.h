@@ -291,6 +291,46 @@ void ComputeInterpolationAtLevel1(int64_t num_channels, int64_t input_height, in
       });
 }
 
+/**
+ * @brief To interpolate one output row along the penultimate axis.
+ * The taps are accumulated a whole input row at a time, so the innermost loop walks contiguous memory
+ * with a single broadcast weight and can be vectorized by the compiler.
+ * @param Xdata The input plane, rows of row_width elements.
+ * @param Ydata_offset The output row.
+ * @param row_width The number of elements in a row.
+ * @param ymin The first input row of the filter window.
+ * @param ymax One past the last input row of the filter window.
+ * @param weight_coeff The filter weights of the window.
+ * @param accumulator Scratch space of row_width elements.
+ * @param clip8_lookups The clip table used to convert 8-bit results.
+ */
+template <typename InputType, typename AccumulateType>
+inline void InterpolateRowAtLevel2(const InputType* Xdata, InputType* Ydata_offset, int64_t row_width,
+                                   int64_t ymin, int64_t ymax, const AccumulateType* weight_coeff,
+                                   AccumulateType* accumulator, const uint8_t* clip8_lookups) {
+  const auto width = narrow<size_t>(row_width);
+  std::fill_n(accumulator, width,
+              static_cast<AccumulateType>(is_8bit_v<InputType> ? ConstValue::mag_factor : 0));
+
+  for (auto idx = ymin; idx < ymax; ++idx) {
+    const AccumulateType weight = *weight_coeff++;
+    const InputType* Xdata_offset = Xdata + idx * row_width;
+    for (size_t x = 0; x < width; ++x) {
+      accumulator[x] += Xdata_offset[x] * weight;
+    }
+  }
+
+  for (size_t x = 0; x < width; ++x) {
+    if constexpr (is_8bit_v<InputType>) {
+      Ydata_offset[x] = static_cast<InputType>(clip8_lookups[accumulator[x] >> 22]);
+    } else if constexpr (std::is_same<InputType, int32_t>::value) {
+      Ydata_offset[x] = narrow<int32_t>(std::round(accumulator[x]));
+    } else {  // float double
+      Ydata_offset[x] = accumulator[x];
+    }
+  }
+}
+
 /**
  * @brief To calculate interpolation along with penultimate axis.
  * For brief, we assume the input tensor has 3 dimensions and we all it CHW for each character represent a dim.
@@ -335,30 +375,14 @@ void ComputeInterpolationAtLevel2(int64_t num_channels, int64_t input_height, in
             return;
           }
 
+          std::vector<AccumulateType> accumulator(narrow<size_t>(output_width));
           const auto* y_bound = p_dim.bound.data();
           for (size_t y = 0; y < narrow<size_t>(output_height); ++y) {
             const auto* weight_coeff = p_dim.weight_coefficients.get() + p_dim.window_size * y;
             int64_t ymin = *y_bound++;
             int64_t ymax = *y_bound++;
-            auto* Ydata_offset = Ydata + output_width * y;
-            for (size_t x = 0; x < narrow<size_t>(output_width); ++x) {
-              AccumulateType output = is_8bit_v<InputType> ? ConstValue::mag_factor : 0;
-              auto* weight_coeff_start = weight_coeff;
-
-              const auto* Xdata_offset = Xdata + ymin * output_width + x;
-              for (auto idx = ymin; idx < ymax; ++idx) {
-                output += *Xdata_offset * (*weight_coeff_start++);
-                Xdata_offset += output_width;
-              }
-
-              if constexpr (is_8bit_v<InputType>) {
-                *Ydata_offset++ = static_cast<InputType>(clip8_lookups[output >> 22]);
-              } else if constexpr (std::is_same<InputType, int32_t>::value) {
-                *Ydata_offset++ = narrow<int32_t>(std::round(output));
-              } else {  // float double
-                *Ydata_offset++ = output;
-              }
-            }
+            InterpolateRowAtLevel2(Xdata, Ydata + output_width * y, output_width, ymin, ymax,
+                                   weight_coeff, accumulator.data(), clip8_lookups);
           }
         });
   } else {
@@ -373,6 +397,7 @@ void ComputeInterpolationAtLevel2(int64_t num_channels, int64_t input_height, in
             return;
           }
 
+          std::vector<AccumulateType> accumulator(narrow<size_t>(output_width));
           for (auto start = first; start != last; start++) {
             auto c = start / output_height;
             auto y = start % output_height;
@@ -387,25 +412,8 @@ void ComputeInterpolationAtLevel2(int64_t num_channels, int64_t input_height, in
             const auto* weight_coeff = p_dim.weight_coefficients.get() + p_dim.window_size * y;
             int64_t ymin = y_bound[2 * narrow<size_t>(y)];
             int64_t ymax = y_bound[2 * narrow<size_t>(y) + 1];
-            auto* Ydata_offset = Ydata + output_width * y;
-            for (size_t x = 0; x < narrow<size_t>(output_width); ++x) {
-              AccumulateType output = is_8bit_v<InputType> ? ConstValue::mag_factor : 0;
-              auto* weight_coeff_start = weight_coeff;
-
-              const auto* Xdata_offset = Xdata + ymin * output_width + x;
-              for (auto idx = ymin; idx < ymax; ++idx) {
-                output += *Xdata_offset * (*weight_coeff_start++);
-                Xdata_offset += output_width;
-              }
-
-              if constexpr (is_8bit_v<InputType>) {
-                *Ydata_offset++ = static_cast<InputType>(clip8_lookups[output >> 22]);
-              } else if constexpr (std::is_same<InputType, int32_t>::value) {
-                *Ydata_offset++ = narrow<int32_t>(std::round(output));
-              } else {  // float double
-                *Ydata_offset++ = output;
-              }
-            }
+            InterpolateRowAtLevel2(Xdata, Ydata + output_width * y, output_width, ymin, ymax,
+                                   weight_coeff, accumulator.data(), clip8_lookups);
           }
         });
   }
@@ -445,6 +453,36 @@ void HandleExtrapolation(int64_t num_channels,
       });
 }
 
+template <typename InputType, typename AccumulateType>
+void NhwcHandleExtrapolation(int64_t batch_size, int64_t num_channels,
+                             int64_t output_height, int64_t output_width,
+                             const float extrapolation_value, gsl::span<InputType> Ydata_span,
+                             const FilterParamsAntiAlias<AccumulateType>& p,
+                             concurrency::ThreadPool* tp) {
+  if (p.dim_x.out_of_bound_idx.empty() && p.dim_y.out_of_bound_idx.empty()) {
+    return;
+  }
+
+  // In NHWC an out-of-bound column covers num_channels consecutive elements of every row.
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      tp, static_cast<std::ptrdiff_t>(batch_size * output_height),
+      [&](std::ptrdiff_t ny) {
+        const int64_t y = ny % output_height;
+        InputType* Ydata_offset = Ydata_span.data() + ny * (output_width * num_channels);
+        const auto& y_out_of_bound = p.dim_y.out_of_bound_idx;
+        if (std::find(y_out_of_bound.begin(), y_out_of_bound.end(), y) != y_out_of_bound.end()) {
+          std::fill_n(Ydata_offset, narrow<size_t>(output_width * num_channels),
+                      static_cast<InputType>(extrapolation_value));
+          return;
+        }
+
+        for (int64_t idx_x : p.dim_x.out_of_bound_idx) {
+          std::fill_n(Ydata_offset + idx_x * num_channels, narrow<size_t>(num_channels),
+                      static_cast<InputType>(extrapolation_value));
+        }
+      });
+}
+
 template <typename T, typename T1>
 void UpsampleBaseAntiAlias(FilterParamsAntiAlias<T1>& p,
                            const int64_t batch_size,
@@ -625,8 +663,8 @@ void NhwcUpsampleBasicAntiAlias(FilterParamsAntiAlias<T1>& p,
   if (use_extrapolation) {
     auto ydata_span = gsl::make_span<T>(Ydata_base,
                                         narrow<size_t>(batch_size * output_height * num_channels * output_width));
-    HandleExtrapolation(batch_size * num_channels, output_height, output_width, 1,
-                        extrapolation_value, ydata_span, p, tp);
+    NhwcHandleExtrapolation(batch_size, num_channels, output_height, output_width,
+                            extrapolation_value, ydata_span, p, tp);
   }
 }
 
@@ -3,6 +3,7 @@
 
 #include "regex_full_match.h"
 #include "core/common/common.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 ONNX_CPU_OPERATOR_KERNEL(
@@ -22,13 +23,16 @@ Status RegexFullMatch::Compute(OpKernelContext* context) const {
   const auto input_data = input_tensor->template DataAsSpan<std::string>();
   auto* output_tensor = context->Output(0, input_tensor->Shape());
   auto output_data = output_tensor->template MutableDataAsSpan<bool>();
-  auto output_iter = output_data.begin();
-  auto input_iter = input_data.begin();
-  while (input_iter != input_data.end()) {
-    *output_iter = RE2::FullMatch(*input_iter, re_);
-    input_iter++;
-    output_iter++;
-  }
+  // RE2 objects are safe to use from several threads and share their cached DFA states.
+  // Assume a matching cost of a couple of cycles per byte for a short line.
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(input_data.size()),
+      TensorOpCost{static_cast<double>(sizeof(std::string)), static_cast<double>(sizeof(bool)), 128.0},
+      [this, input_data, output_data](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i < end; ++i) {
+          output_data[i] = RE2::FullMatch(input_data[i], re_);
+        }
+      });
   return Status::OK();
 }
 
@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <string_view>
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/allocator.h"
+
+namespace onnxruntime {
+
+/// <summary>
+/// Rows of string slices kept in one contiguous buffer with per row offsets.
+///
+/// Text kernels that split their input into a variable number of pieces per element used to keep
+/// a vector of slices for every element, which costs one heap allocation per input string.
+/// This class stores all the slices of all the rows back to back in a single buffer that comes from
+/// the kernel's allocator (normally the session arena), so the whole batch needs a handful of allocations.
+/// The slices are views into the input strings; the caller must keep the input alive while they are in use.
+/// </summary>
+class StringSlices {
+ public:
+  /// <param name="allocator">allocator for the slice buffer, usually from OpKernelContext::GetTempSpaceAllocator</param>
+  /// <param name="num_rows">expected number of rows</param>
+  /// <param name="estimated_slices">expected total number of slices. The buffer grows if it is exceeded.</param>
+  StringSlices(AllocatorPtr allocator, size_t num_rows, size_t estimated_slices)
+      : allocator_(std::move(allocator)) {
+    row_ends_.reserve(num_rows);
+    Reserve(std::max<size_t>(estimated_slices, 1));
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(StringSlices);
+
+  /// Appends a slice to the current row.
+  void Append(std::string_view slice) {
+    if (size_ == capacity_) {
+      Reserve(capacity_ * 2);
+    }
+    data_.get()[size_++] = slice;
+  }
+
+  /// Closes the current row. The next Append() starts a new row.
+  void EndRow() {
+    row_ends_.push_back(size_);
+  }
+
+  /// Number of slices in the row that has not been closed yet.
+  size_t CurrentRowSize() const {
+    return size_ - (row_ends_.empty() ? 0 : row_ends_.back());
+  }
+
+  size_t NumRows() const { return row_ends_.size(); }
+
+  gsl::span<const std::string_view> Row(size_t row) const {
+    const size_t begin = row == 0 ? 0 : row_ends_[row - 1];
+    return gsl::make_span(data_.get() + begin, row_ends_[row] - begin);
+  }
+
+  /// Largest number of slices in a closed row.
+  size_t MaxRowSize() const {
+    size_t max_size = 0;
+    size_t begin = 0;
+    for (size_t end : row_ends_) {
+      max_size = std::max(max_size, end - begin);
+      begin = end;
+    }
+    return max_size;
+  }
+
+ private:
+  void Reserve(size_t capacity) {
+    auto data = IAllocator::MakeUniquePtr<std::string_view>(allocator_, capacity);
+    if (size_ > 0) {
+      std::copy(data_.get(), data_.get() + size_, data.get());
+    }
+    data_ = std::move(data);
+    capacity_ = capacity;
+  }
+
+  AllocatorPtr allocator_;
+  // std::string_view is trivially copyable and destructible, so raw allocator memory is fine here.
+  IAllocatorUniquePtr<std::string_view> data_;
+  size_t size_ = 0;
+  size_t capacity_ = 0;
+  // End offset of each closed row in data_.
+  InlinedVector<size_t> row_ends_;
+};
+
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include <limits>
 #include <string>
 #include "core/common/common.h"
+#include "core/providers/cpu/text/string_slices.h"
 namespace onnxruntime {
 
 ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
@@ -16,9 +17,9 @@ ONNX_CPU_OPERATOR_KERNEL(StringSplit, 20,
                          StringSplit);
 
 /// Calculate substrings in ``str`` delimited by ``delimiter``. A maximum of ``max_splits`` splits are permitted.
-/// Returns a vector of string slices into ``str`` representing the substrings as string views. The user must ensure
-/// the returned views' lifetime does not exceed ``str``'s.
-void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t max_splits, InlinedVector<std::string_view>& out) {
+/// Appends the substrings to the current row of ``out`` as string views into ``str``. The user must ensure
+/// the views' lifetime does not exceed ``str``'s.
+void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t max_splits, StringSlices& out) {
   if (str.empty()) {
     return;
   }
@@ -33,11 +34,11 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
         while (str[next_pos] == ' ') {
           next_pos--;
         }
-        out.push_back(str.substr(pos, next_pos - pos + 1));
+        out.Append(str.substr(pos, next_pos - pos + 1));
         break;
       } else {
         auto next_pos = str.find_first_of(" ", pos);
-        out.push_back(str.substr(pos, next_pos - pos));
+        out.Append(str.substr(pos, next_pos - pos));
         pos = str.find_first_not_of(" ", next_pos);
       }
     }
@@ -47,10 +48,10 @@ void ComputeSubstrings(std::string_view str, std::string_view delimiter, int64_t
     while (pos != std::string::npos) {
       auto next_pos = str.find(delimiter, pos);
       if (token_count++ == max_splits || next_pos == std::string::npos) {
-        out.push_back(str.substr(pos));
+        out.Append(str.substr(pos));
         break;
       }
-      out.push_back(str.substr(pos, next_pos - pos));
+      out.Append(str.substr(pos, next_pos - pos));
       pos = next_pos + delimiter.size();
     }
   }
@@ -69,14 +70,17 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   auto num_tokens_data = context->Output(1, input->Shape())->template MutableDataAsSpan<int64_t>();
   auto num_tokens_iter = num_tokens_data.begin();
 
-  InlinedVector<InlinedVector<std::string_view>> input_slices;
-  input_slices.reserve(input_data.size());
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // All the substrings of all the inputs share one buffer. Assume a couple of tokens per input to start with.
+  StringSlices input_slices(alloc, input_data.size(), input_data.size() * 2);
   size_t last_dim = 0;
 
   for (const auto& s : input_data) {
-    auto& substrs = input_slices.emplace_back();
-    ComputeSubstrings(s, delimiter_, maxsplit_, substrs);
-    auto substr_count = substrs.size();
+    ComputeSubstrings(s, delimiter_, maxsplit_, input_slices);
+    auto substr_count = input_slices.CurrentRowSize();
+    input_slices.EndRow();
     last_dim = std::max(last_dim, substr_count);
     *num_tokens_iter = static_cast<int64_t>(substr_count);
     ++num_tokens_iter;
@@ -87,9 +91,10 @@ Status StringSplit::Compute(OpKernelContext* context) const {
   splits_shape.push_back(last_dim);
 
   auto splits_data = context->Output(0, splits_shape)->template MutableDataAsSpan<std::string>();
-  auto slices_iter = input_slices.begin();
-  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++slices_iter) {
-    std::copy(slices_iter->begin(), slices_iter->end(), output_splits_iter);
+  size_t row = 0;
+  for (auto output_splits_iter = splits_data.begin(); output_splits_iter != splits_data.end(); output_splits_iter += last_dim, ++row) {
+    const auto slices = input_slices.Row(row);
+    std::copy(slices.begin(), slices.end(), output_splits_iter);
   }
 
   return Status::OK();
@@ -0,0 +1,42 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+
+#include "core/framework/tunable.h"
+#include "core/providers/cpu/tunable/cpu_tuning_context.h"
+
+namespace onnxruntime {
+
+// CPU kernels run synchronously, so the timer measures wall clock time and there is no stream.
+class CpuTimer : public ITimer<void*> {
+ public:
+  using TimerBase = ITimer<void*>;
+
+  explicit CpuTimer(void* stream) : TimerBase(stream) {}
+
+  void Start() override {
+    start_ = std::chrono::steady_clock::now();
+  }
+
+  void End() override {
+    end_ = std::chrono::steady_clock::now();
+  }
+
+  float Duration() override {
+    return std::chrono::duration<float, std::milli>(end_ - start_).count();
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  std::chrono::steady_clock::time_point end_;
+};
+
+using CpuOpParams = OpParams<CpuTuningContext, void*>;
+
+template <typename ParamsT>
+using CpuTunableOp = TunableOp<ParamsT, CpuTimer>;
+
+}  // namespace onnxruntime
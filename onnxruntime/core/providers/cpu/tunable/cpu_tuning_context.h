@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/framework/tuning_context.h"
+
+namespace onnxruntime {
+
+class CPUExecutionProvider;
+
+// TunableOp settings of the CPU execution provider. These are set from the session options.
+struct CPUTunableOpInfo {
+  bool enable{false};
+  bool tuning_enable{false};
+  int max_tuning_duration_ms{};
+};
+
+class CpuTuningResultsValidator : public TuningResultsValidator {
+ public:
+  CpuTuningResultsValidator();
+
+ protected:
+  // the fastest kernel depends on the instruction sets MLAS dispatches to
+  std::string GetCpuFeatures() const;
+  Status ValidateCpuFeatures(const std::string& value) const;
+};
+
+class CpuTuningContext : public ITuningContext {
+ public:
+  explicit CpuTuningContext(CPUExecutionProvider* ep, CPUTunableOpInfo* info);
+
+  void EnableTunableOp() override;
+  void DisableTunableOp() override;
+  bool IsTunableOpEnabled() const override;
+
+  void EnableTuning() override;
+  void DisableTuning() override;
+  bool IsTuningEnabled() const override;
+
+  void SetMaxTuningDurationMs(int max_duration_ms) override;
+  int GetMaxTuningDurationMs() const override;
+
+  TuningResultsManager& GetTuningResultsManager() override;
+  const TuningResultsManager& GetTuningResultsManager() const override;
+
+  const TuningResultsValidator& GetTuningResultsValidator() const override;
+
+ private:
+  CPUTunableOpInfo* info_;  // non-owning handle
+  TuningResultsManager manager_;
+  CpuTuningResultsValidator validator_;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/tunable/sgemm_tunable.h"
+
+#include "core/common/common.h"
+
+namespace onnxruntime {
+
+std::string SgemmParams::Signature() const {
+  // the fastest partitioning depends on the number of threads available as well as the shape
+  return MakeString(trans_a == CblasTrans ? "T" : "N", trans_b == CblasTrans ? "T" : "N", "_",
+                    m, "_", n, "_", k, "_", data.size(), "_",
+                    !data.empty() && data[0].BIsPacked ? "packed" : "unpacked", "_",
+                    concurrency::ThreadPool::DegreeOfParallelism(thread_pool));
+}
+
+namespace {
+
+Status SgemmPartitioned(const SgemmParams* params) {
+  MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                params->data.data(), params->data.size(), params->thread_pool);
+  return Status::OK();
+}
+
+Status SgemmSingleThreaded(const SgemmParams* params) {
+  MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                params->data.data(), params->data.size(), nullptr);
+  return Status::OK();
+}
+
+Status SgemmBatchParallel(const SgemmParams* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+      params->data.size() < 2 || concurrency::ThreadPool::DegreeOfParallelism(params->thread_pool) < 2,
+      "batch parallel GEMM needs more than one GEMM and more than one thread");
+
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      params->thread_pool, static_cast<std::ptrdiff_t>(params->data.size()), [params](std::ptrdiff_t i) {
+        MlasGemmBatch(params->trans_a, params->trans_b, params->m, params->n, params->k,
+                      &params->data[static_cast<size_t>(i)], 1, nullptr);
+      });
+  return Status::OK();
+}
+
+}  // namespace
+
+SgemmTunableOp::SgemmTunableOp() {
+  this->RegisterOp(SgemmPartitioned);
+  this->RegisterOp(SgemmSingleThreaded);
+  this->RegisterOp(SgemmBatchParallel);
+  this->SetDefaultId(0);
+}
+
+}  // namespace onnxruntime
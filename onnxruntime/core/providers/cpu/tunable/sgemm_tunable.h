@@ -0,0 +1,50 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include <gsl/gsl>
+
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/tunable/cpu_tunable.h"
+
+namespace onnxruntime {
+
+// A batch of single precision GEMMs that share their shape, as passed to MlasGemmBatch.
+struct SgemmParams : CpuOpParams {
+  SgemmParams(CpuTuningContext* tuning_ctx, CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
+              size_t m, size_t n, size_t k, gsl::span<const MLAS_SGEMM_DATA_PARAMS> data,
+              concurrency::ThreadPool* thread_pool)
+      : CpuOpParams(tuning_ctx, nullptr),
+        trans_a(trans_a),
+        trans_b(trans_b),
+        m(m),
+        n(n),
+        k(k),
+        data(data),
+        thread_pool(thread_pool) {}
+
+  std::string Signature() const override;
+
+  CBLAS_TRANSPOSE trans_a;
+  CBLAS_TRANSPOSE trans_b;
+  size_t m;
+  size_t n;
+  size_t k;
+  gsl::span<const MLAS_SGEMM_DATA_PARAMS> data;
+  concurrency::ThreadPool* thread_pool;
+};
+
+// Chooses how a batch of GEMMs is spread over the intra-op thread pool:
+//   0: MLAS partitions each GEMM over the thread pool (the default when tuning is disabled),
+//   1: all GEMMs run on the calling thread, which avoids the partitioning overhead for small problems,
+//   2: one GEMM per thread pool task, for batches of small GEMMs.
+class SgemmTunableOp : public CpuTunableOp<SgemmParams> {
+ public:
+  SgemmTunableOp();
+};
+
+}  // namespace onnxruntime
@@ -50,6 +50,7 @@
 #include "core/optimizer/selectors_actions/selector_action_transformer_apply_contexts.h"
 #include "core/optimizer/transformer_memcpy.h"
 #include "core/optimizer/transpose_optimization/ort_optimizer_utils.h"
+#include "core/optimizer/zipmap_elimination.h"
 #include "core/platform/Barrier.h"
 #include "core/platform/threadpool.h"
 #ifdef _WIN32
@@ -1285,6 +1286,11 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
                                                                            session_logger_);
   GraphPartitioner partitioner(kernel_registry_manager_, execution_providers_, std::move(graph_optimizer_registry));
 
+  // limit the type and shape inference of the Resolve calls between transformers to the parts of the graph they changed
+  const std::string incremental_graph_resolve =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsIncrementalGraphResolve, "0");
+  graph.SetIncrementalResolve(incremental_graph_resolve != "0", incremental_graph_resolve == "2");
+
   // Run Ahead Of time function inlining
   if (const bool disable_aot_function_inlining =
           session_options_.config_options.GetConfigOrDefault(
@@ -1302,6 +1308,13 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph, bool
     return transformer.Apply(graph, modified, logger);
   };
 
+  // return ZipMap outputs as dense tensors if requested. this changes the model outputs so it does not depend on the
+  // optimization level.
+  if (session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsZipMapOutputAsTensor, "0") == "1") {
+    ZipMapElimination zipmap_elimination{};
+    ORT_RETURN_IF_ERROR_SESSIONID_(apply_transformer_once(zipmap_elimination, *session_logger_, graph));
+  }
+
   // ensure potential QDQ node units have unique DQ nodes
   if (const bool disable_quant_qdq =
           session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableQuantQDQ, "0") == "1";
@@ -1889,6 +1902,24 @@ common::Status InferenceSession::Initialize() {
       }
     }
 
+    // the CPU EP has no provider options, so its TunableOp settings come from the session options
+    if (const auto* cpu_ep = execution_providers_.Get(kCpuExecutionProvider); cpu_ep != nullptr) {
+      ITuningContext* cpu_tuning_ctx = cpu_ep->GetTuningContext();
+      const auto& config_options = session_options_.config_options;
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpEnable, "0") == "1") {
+        cpu_tuning_ctx->EnableTunableOp();
+      }
+
+      if (config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpTuningEnable, "0") == "1") {
+        ORT_RETURN_IF_NOT(cpu_tuning_ctx->IsTunableOpEnabled(), kOrtSessionOptionsCpuTunableOpTuningEnable,
+                          " requires ", kOrtSessionOptionsCpuTunableOpEnable, " to be set to 1");
+        cpu_tuning_ctx->EnableTuning();
+      }
+
+      cpu_tuning_ctx->SetMaxTuningDurationMs(ParseStringWithClassicLocale<int>(
+          config_options.GetConfigOrDefault(kOrtSessionOptionsCpuTunableOpMaxTuningDurationMs, "0")));
+    }
+
 #if !defined(ORT_MINIMAL_BUILD)
     const std::string node_stats_file = session_options_.config_options.GetConfigOrDefault(
         kOrtSessionOptionsCollectNodeMemoryStatsToFile, "");
@@ -1915,6 +1946,15 @@ common::Status InferenceSession::Initialize() {
     // Register 2nd registries into KernelRegistryManager.
     ORT_RETURN_IF_ERROR_SESSIONID_(kernel_registry_manager_.RegisterKernels(execution_providers_));
 
+    // the stages below are logged with their duration and recorded as session events when profiling
+    auto record_initialization_stage = [this](const std::string& stage, const TimePoint& start_time) {
+      LOGS(*session_logger_, INFO) << "Initialization stage " << stage << " took "
+                                   << TimeDiffMicroSeconds(start_time) << " us";
+      if (session_profiler_.IsEnabled()) {
+        session_profiler_.EndTimeAndRecordEvent(profiling::SESSION_EVENT, stage, start_time);
+      }
+    };
+
     const bool loading_ort_format = !ort_format_model_bytes_.empty();
     const bool saving_model = !session_options_.optimized_model_filepath.empty();
     const bool saving_ort_format = [&]() {
@@ -2005,7 +2045,9 @@ common::Status InferenceSession::Initialize() {
 #endif
 
       // apply any transformations to the main graph and any subgraphs
+      TimePoint transform_start_time = std::chrono::high_resolution_clock::now();
       ORT_RETURN_IF_ERROR_SESSIONID_(TransformGraph(graph, saving_ort_format));
+      record_initialization_stage("graph_transformation_and_partitioning", transform_start_time);
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
@@ -2169,11 +2211,13 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+    TimePoint finalize_start_time = std::chrono::high_resolution_clock::now();
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              // need to keep the initializers if saving the optimized model
                                              !saving_model,
                                              saving_ort_format));
+    record_initialization_stage("session_state_finalization", finalize_start_time);
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
@@ -3213,6 +3257,9 @@ common::Status InferenceSession::ValidateAndParseShrinkArenaString(const std::st
 }
 
 void InferenceSession::ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink) {
+  // the pooled memory pattern buffers of subgraphs are arena allocations that would keep their chunks in use
+  session_state_->ReleaseMemoryPatternBuffers();
+
   for (auto& alloc : arenas_to_shrink) {
     auto status = static_cast<BFCArena*>(alloc.get())->Shrink();
 
@@ -0,0 +1,331 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cctype>
+#include <memory>
+#include <string>
+#include <vector>
+#include "gtest/gtest.h"
+#include "core/graph/constants.h"
+#include "core/graph/onnx_protobuf.h"
+#include "core/session/onnxruntime_cxx_api.h"
+#include "test/common/random_generator.h"
+
+extern std::unique_ptr<Ort::Env> ort_env;
+
+namespace onnxruntime {
+namespace test {
+
+// A tiny single layer GPT-2 style model is generated in two variants that compute the same function:
+//  - the past state is concatenated by the Attention op and copied for each beam after every step
+//  - the past and present state share a buffer of max_length tokens, and DecoderMaskedMultiHeadAttention reads the
+//    past state of each beam through the cache indirection
+// GreedySearch and BeamSearch shall generate the same sequences with both.
+namespace {
+
+constexpr int64_t kVocabSize = 16;
+constexpr int64_t kHiddenSize = 8;
+constexpr int64_t kNumHeads = 2;
+constexpr int64_t kHeadSize = kHiddenSize / kNumHeads;
+constexpr int64_t kMaxPositions = 32;
+
+using ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+using ONNX_NAMESPACE::TensorProto_DataType_INT32;
+using ONNX_NAMESPACE::TensorProto_DataType_INT64;
+
+// dims that are not a number are symbolic
+void AddValueInfo(google::protobuf::RepeatedPtrField<ONNX_NAMESPACE::ValueInfoProto>& value_infos,
+                  const std::string& name, int32_t elem_type, const std::vector<std::string>& dims) {
+  auto* value_info = value_infos.Add();
+  value_info->set_name(name);
+  auto* tensor_type = value_info->mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(elem_type);
+  auto* shape = tensor_type->mutable_shape();
+  for (const auto& dim : dims) {
+    if (std::isdigit(static_cast<unsigned char>(dim[0]))) {
+      shape->add_dim()->set_dim_value(std::stoll(dim));
+    } else {
+      shape->add_dim()->set_dim_param(dim);
+    }
+  }
+}
+
+void AddFloatInitializer(ONNX_NAMESPACE::GraphProto& graph, const std::string& name,
+                         const std::vector<int64_t>& dims, const std::vector<float>& values) {
+  auto* initializer = graph.add_initializer();
+  initializer->set_name(name);
+  initializer->set_data_type(TensorProto_DataType_FLOAT);
+  for (auto dim : dims) {
+    initializer->add_dims(dim);
+  }
+  for (auto value : values) {
+    initializer->add_float_data(value);
+  }
+}
+
+void AddInt64Initializer(ONNX_NAMESPACE::GraphProto& graph, const std::string& name,
+                         const std::vector<int64_t>& dims, const std::vector<int64_t>& values) {
+  auto* initializer = graph.add_initializer();
+  initializer->set_name(name);
+  initializer->set_data_type(TensorProto_DataType_INT64);
+  for (auto dim : dims) {
+    initializer->add_dims(dim);
+  }
+  for (auto value : values) {
+    initializer->add_int64_data(value);
+  }
+}
+
+ONNX_NAMESPACE::NodeProto& AddNode(ONNX_NAMESPACE::GraphProto& graph, const std::string& op_type,
+                                   const std::vector<std::string>& inputs, const std::vector<std::string>& outputs,
+                                   const std::string& domain = "") {
+  auto* node = graph.add_node();
+  node->set_name(outputs[0] + "_" + op_type);
+  node->set_op_type(op_type);
+  node->set_domain(domain);
+  for (const auto& input : inputs) {
+    node->add_input(input);
+  }
+  for (const auto& output : outputs) {
+    node->add_output(output);
+  }
+  return *node;
+}
+
+void AddIntAttribute(ONNX_NAMESPACE::NodeProto& node, const std::string& name, int64_t value) {
+  auto* attr = node.add_attribute();
+  attr->set_name(name);
+  attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attr->set_i(value);
+}
+
+// Create the decoder subgraph. Both variants use the same weights, and the Q, K and V projections of
+// DecoderMaskedMultiHeadAttention are the slices of the packed Attention weights.
+ONNX_NAMESPACE::GraphProto CreateDecoder(bool use_decoder_masked_attention, bool is_beam_search) {
+  RandomValueGenerator random{1234};
+  const auto wte = random.Uniform<float>(std::vector<int64_t>{kVocabSize, kHiddenSize}, -1.0f, 1.0f);
+  const auto wpe = random.Uniform<float>(std::vector<int64_t>{kMaxPositions, kHiddenSize}, -0.5f, 0.5f);
+  const auto qkv_weights = random.Uniform<float>(std::vector<int64_t>{kHiddenSize, 3 * kHiddenSize}, -1.0f, 1.0f);
+  const auto lm_head = random.Uniform<float>(std::vector<int64_t>{kHiddenSize, kVocabSize}, -1.0f, 1.0f);
+
+  ONNX_NAMESPACE::GraphProto graph;
+  graph.set_name("decoder");
+
+  const std::string past_length = use_decoder_masked_attention ? "max_sequence_length" : "past_sequence_length";
+  const std::string present_length = use_decoder_masked_attention ? "max_sequence_length" : "total_sequence_length";
+  const std::string num_heads = std::to_string(kNumHeads);
+  const std::string head_size = std::to_string(kHeadSize);
+
+  AddValueInfo(*graph.mutable_input(), "input_ids", TensorProto_DataType_INT32, {"batch_size", "sequence_length"});
+  AddValueInfo(*graph.mutable_input(), "position_ids", TensorProto_DataType_INT32, {"batch_size", "sequence_length"});
+  AddValueInfo(*graph.mutable_input(), "attention_mask", TensorProto_DataType_INT32,
+               {"batch_size", "total_sequence_length"});
+  AddValueInfo(*graph.mutable_input(), "past_0", TensorProto_DataType_FLOAT,
+               {"2", "batch_size", num_heads, past_length, head_size});
+  if (use_decoder_masked_attention) {
+    AddValueInfo(*graph.mutable_input(), "past_sequence_length", TensorProto_DataType_INT32, {"1"});
+    if (is_beam_search) {
+      AddValueInfo(*graph.mutable_input(), "beam_width", TensorProto_DataType_INT32, {"1"});
+      AddValueInfo(*graph.mutable_input(), "cache_indirection", TensorProto_DataType_INT32,
+                   {"batch", "beam_width", "max_sequence_length"});
+    }
+  }
+
+  AddValueInfo(*graph.mutable_output(), "logits", TensorProto_DataType_FLOAT,
+               {"batch_size", "sequence_length", std::to_string(kVocabSize)});
+  AddValueInfo(*graph.mutable_output(), "present_0", TensorProto_DataType_FLOAT,
+               {"2", "batch_size", num_heads, present_length, head_size});
+
+  AddFloatInitializer(graph, "wte", {kVocabSize, kHiddenSize}, wte);
+  AddFloatInitializer(graph, "wpe", {kMaxPositions, kHiddenSize}, wpe);
+  AddFloatInitializer(graph, "lm_head", {kHiddenSize, kVocabSize}, lm_head);
+
+  AddNode(graph, "Gather", {"wte", "input_ids"}, {"token_embeddings"});
+  AddNode(graph, "Gather", {"wpe", "position_ids"}, {"position_embeddings"});
+  AddNode(graph, "Add", {"token_embeddings", "position_embeddings"}, {"hidden_states"});
+
+  if (use_decoder_masked_attention) {
+    for (int64_t i = 0; i < 3; ++i) {
+      const std::string name = std::string(1, "qkv"[i]);
+      std::vector<float> weights;
+      weights.reserve(kHiddenSize * kHiddenSize);
+      for (int64_t row = 0; row < kHiddenSize; ++row) {
+        const auto* row_begin = qkv_weights.data() + row * 3 * kHiddenSize + i * kHiddenSize;
+        weights.insert(weights.end(), row_begin, row_begin + kHiddenSize);
+      }
+      AddFloatInitializer(graph, name + "_weights", {kHiddenSize, kHiddenSize}, weights);
+      AddNode(graph, "MatMul", {"hidden_states", name + "_weights"}, {name});
+    }
+
+    AddInt64Initializer(graph, "key_index", {}, {0});
+    AddInt64Initializer(graph, "value_index", {}, {1});
+    AddInt64Initializer(graph, "axes_0", {1}, {0});
+    AddNode(graph, "Gather", {"past_0", "key_index"}, {"past_key"});
+    AddNode(graph, "Gather", {"past_0", "value_index"}, {"past_value"});
+
+    std::vector<std::string> attention_inputs{"q", "k", "v", "", "", "past_key", "past_value", "past_sequence_length"};
+    if (is_beam_search) {
+      attention_inputs.push_back("beam_width");
+      attention_inputs.push_back("cache_indirection");
+    }
+    auto& attention = AddNode(graph, "DecoderMaskedMultiHeadAttention", attention_inputs,
+                              {"attention_output", "present_key", "present_value"}, kMSDomain);
+    AddIntAttribute(attention, "num_heads", kNumHeads);
+    AddIntAttribute(attention, "past_present_share_buffer", 1);
+
+    AddNode(graph, "Unsqueeze", {"present_key", "axes_0"}, {"present_key_5d"});
+    AddNode(graph, "Unsqueeze", {"present_value", "axes_0"}, {"present_value_5d"});
+    auto& concat = AddNode(graph, "Concat", {"present_key_5d", "present_value_5d"}, {"present_0"});
+    AddIntAttribute(concat, "axis", 0);
+  } else {
+    AddFloatInitializer(graph, "qkv_weights", {kHiddenSize, 3 * kHiddenSize}, qkv_weights);
+    AddFloatInitializer(graph, "qkv_bias", {3 * kHiddenSize}, std::vector<float>(3 * kHiddenSize, 0.0f));
+    auto& attention = AddNode(graph, "Attention", {"hidden_states", "qkv_weights", "qkv_bias", "", "past_0"},
+                              {"attention_output", "present_0"}, kMSDomain);
+    AddIntAttribute(attention, "num_heads", kNumHeads);
+    AddIntAttribute(attention, "unidirectional", 1);
+  }
+
+  AddNode(graph, "MatMul", {"attention_output", "lm_head"}, {"logits"});
+  return graph;
+}
+
+std::string CreateGenerationModel(bool use_decoder_masked_attention, bool is_beam_search) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  auto* onnx_opset = model.add_opset_import();
+  onnx_opset->set_domain("");
+  onnx_opset->set_version(17);
+  auto* ms_opset = model.add_opset_import();
+  ms_opset->set_domain(kMSDomain);
+  ms_opset->set_version(1);
+
+  auto& graph = *model.mutable_graph();
+  graph.set_name("generation");
+
+  std::vector<std::string> inputs{"input_ids", "max_length", "min_length"};
+  AddValueInfo(*graph.mutable_input(), "input_ids", TensorProto_DataType_INT32, {"batch_size", "sequence_length"});
+  AddValueInfo(*graph.mutable_input(), "max_length", TensorProto_DataType_INT32, {"1"});
+  AddValueInfo(*graph.mutable_input(), "min_length", TensorProto_DataType_INT32, {"1"});
+  if (is_beam_search) {
+    inputs.insert(inputs.end(), {"num_beams", "num_return_sequences", "length_penalty"});
+    AddValueInfo(*graph.mutable_input(), "num_beams", TensorProto_DataType_INT32, {"1"});
+    AddValueInfo(*graph.mutable_input(), "num_return_sequences", TensorProto_DataType_INT32, {"1"});
+    AddValueInfo(*graph.mutable_input(), "length_penalty", TensorProto_DataType_FLOAT, {"1"});
+  }
+  inputs.push_back("repetition_penalty");
+  AddValueInfo(*graph.mutable_input(), "repetition_penalty", TensorProto_DataType_FLOAT, {"1"});
+
+  std::vector<std::string> outputs{"sequences"};
+  if (is_beam_search) {
+    outputs.push_back("sequences_scores");
+    AddValueInfo(*graph.mutable_output(), "sequences", TensorProto_DataType_INT32,
+                 {"batch_size", "num_return_sequences", "max_length"});
+    AddValueInfo(*graph.mutable_output(), "sequences_scores", TensorProto_DataType_FLOAT,
+                 {"batch_size", "num_return_sequences"});
+  } else {
+    AddValueInfo(*graph.mutable_output(), "sequences", TensorProto_DataType_INT32, {"batch_size", "max_length"});
+  }
+
+  auto& node = AddNode(graph, is_beam_search ? "BeamSearch" : "GreedySearch", inputs, outputs, kMSDomain);
+  AddIntAttribute(node, "eos_token_id", kVocabSize - 1);
+  AddIntAttribute(node, "pad_token_id", 0);
+  AddIntAttribute(node, "model_type", 0);
+  auto* decoder = node.add_attribute();
+  decoder->set_name("decoder");
+  decoder->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_GRAPH);
+  *decoder->mutable_g() = CreateDecoder(use_decoder_masked_attention, is_beam_search);
+
+  std::string model_data;
+  model.SerializeToString(&model_data);
+  return model_data;
+}
+
+struct GenerationResult {
+  std::vector<int32_t> sequences;
+  std::vector<float> scores;
+};
+
+GenerationResult RunGeneration(bool use_decoder_masked_attention, bool is_beam_search) {
+  std::vector<int64_t> input_ids_shape{2, 1};
+  std::vector<int32_t> input_ids{3, 7};
+
+  std::vector<int64_t> parameter_shape{1};
+  std::vector<int32_t> max_length{12};
+  std::vector<int32_t> min_length{1};
+  std::vector<int32_t> num_beams{3};
+  std::vector<int32_t> num_return_sequences{2};
+  std::vector<float> length_penalty{1.0f};
+  std::vector<float> repetition_penalty{1.0f};
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<Ort::Value> ort_inputs;
+  std::vector<const char*> input_names{"input_ids", "max_length", "min_length"};
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, input_ids.data(), input_ids.size(), input_ids_shape.data(), input_ids_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, max_length.data(), max_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, min_length.data(), min_length.size(), parameter_shape.data(), parameter_shape.size()));
+  if (is_beam_search) {
+    input_names.insert(input_names.end(), {"num_beams", "num_return_sequences", "length_penalty"});
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, num_beams.data(), num_beams.size(), parameter_shape.data(), parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, num_return_sequences.data(), num_return_sequences.size(), parameter_shape.data(),
+        parameter_shape.size()));
+    ort_inputs.push_back(Ort::Value::CreateTensor(
+        info, length_penalty.data(), length_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+  }
+  input_names.push_back("repetition_penalty");
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, repetition_penalty.data(), repetition_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+
+  std::vector<const char*> output_names{"sequences"};
+  if (is_beam_search) {
+    output_names.push_back("sequences_scores");
+  }
+
+  const std::string model_data = CreateGenerationModel(use_decoder_masked_attention, is_beam_search);
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, model_data.data(), model_data.size(), session_options);
+  auto ort_outputs = session.Run(Ort::RunOptions{}, input_names.data(), ort_inputs.data(), ort_inputs.size(),
+                                 output_names.data(), output_names.size());
+
+  GenerationResult result;
+  const auto& sequences = ort_outputs[0];
+  const auto* sequences_data = sequences.GetTensorData<int32_t>();
+  result.sequences.assign(sequences_data,
+                          sequences_data + sequences.GetTensorTypeAndShapeInfo().GetElementCount());
+  if (is_beam_search) {
+    const auto& scores = ort_outputs[1];
+    const auto* scores_data = scores.GetTensorData<float>();
+    result.scores.assign(scores_data, scores_data + scores.GetTensorTypeAndShapeInfo().GetElementCount());
+  }
+
+  return result;
+}
+
+}  // namespace
+
+TEST(GptDecoderMaskedAttentionTest, GreedySearchParity) {
+  const auto expected = RunGeneration(/*use_decoder_masked_attention*/ false, /*is_beam_search*/ false);
+  const auto actual = RunGeneration(/*use_decoder_masked_attention*/ true, /*is_beam_search*/ false);
+  ASSERT_EQ(expected.sequences.size(), static_cast<size_t>(2 * 12));
+  EXPECT_EQ(expected.sequences, actual.sequences);
+}
+
+TEST(GptDecoderMaskedAttentionTest, BeamSearchParity) {
+  const auto expected = RunGeneration(/*use_decoder_masked_attention*/ false, /*is_beam_search*/ true);
+  const auto actual = RunGeneration(/*use_decoder_masked_attention*/ true, /*is_beam_search*/ true);
+  ASSERT_EQ(expected.sequences.size(), static_cast<size_t>(2 * 2 * 12));
+  EXPECT_EQ(expected.sequences, actual.sequences);
+
+  ASSERT_EQ(expected.scores.size(), actual.scores.size());
+  for (size_t i = 0; i < expected.scores.size(); ++i) {
+    EXPECT_NEAR(expected.scores[i], actual.scores[i], 1e-4f) << "score " << i;
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
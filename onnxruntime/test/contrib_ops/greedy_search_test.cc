@@ -1,11 +1,15 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
 #include <memory>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 #include <gsl/gsl>
+#include "core/graph/onnx_protobuf.h"
 #include "core/session/onnxruntime_cxx_api.h"
+#include "contrib_ops/cpu/transformers/greedy_search_impl_gpt.h"
 #include "test/common/cuda_op_test_utils.h"
 
 #ifdef USE_CUDA
@@ -183,5 +187,117 @@ TEST(GreedySearchTest, GptGreedySearchFp32) {
   }
 }
 
+namespace {
+// Serialize the tiny GPT-2 greedy search model with the num_speculative_tokens attribute set.
+std::string GetSpeculativeGreedySearchModel(int64_t num_speculative_tokens) {
+  ONNX_NAMESPACE::ModelProto model_proto;
+  std::ifstream model_file(ORT_TSTR("testdata/transformers/tiny_gpt2_greedysearch_with_init_decoder.onnx"),
+                           std::ios::binary);
+  ORT_ENFORCE(model_proto.ParseFromIstream(&model_file), "Failed to load the GreedySearch test model");
+
+  for (auto& node : *model_proto.mutable_graph()->mutable_node()) {
+    if (node.op_type() == "GreedySearch") {
+      auto* attr = node.add_attribute();
+      attr->set_name("num_speculative_tokens");
+      attr->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+      attr->set_i(num_speculative_tokens);
+    }
+  }
+
+  std::string model_data;
+  model_proto.SerializeToString(&model_data);
+  return model_data;
+}
+}  // namespace
+
+namespace {
+// Run the speculative GreedySearch test model on CPU and return the generated sequences.
+std::vector<int32_t> RunSpeculativeGreedySearch(int64_t num_speculative_tokens,
+                                                std::vector<int64_t> input_ids_shape,
+                                                std::vector<int32_t> input_ids,
+                                                int32_t max_length) {
+  const std::string model_data = GetSpeculativeGreedySearchModel(num_speculative_tokens);
+
+  std::vector<int64_t> parameter_shape{1};
+  std::vector<int32_t> max_length_value{max_length};
+  std::vector<int32_t> min_length{1};
+  std::vector<float> repetition_penalty{1.0f};
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<Ort::Value> ort_inputs;
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, input_ids.data(), input_ids.size(), input_ids_shape.data(), input_ids_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, max_length_value.data(), max_length_value.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, min_length.data(), min_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, repetition_penalty.data(), repetition_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+  const char* input_names[] = {"input_ids", "max_length", "min_length", "repetition_penalty"};
+  const char* const output_names[] = {"sequences"};
+
+  Ort::SessionOptions session_options;
+  Ort::Session session(*ort_env, model_data.data(), model_data.size(), session_options);
+  auto ort_outputs = session.Run(Ort::RunOptions{}, input_names, ort_inputs.data(), ort_inputs.size(),
+                                 output_names, 1);
+  const auto* result_vals = ort_outputs[0].GetTensorData<int32_t>();
+  return std::vector<int32_t>(result_vals, result_vals + input_ids_shape[0] * max_length);
+}
+}  // namespace
+
+TEST(GreedySearchTest, LookupDraftTokens) {
+  std::vector<int32_t> draft_tokens;
+
+  // The longest matching n-gram wins: [5, 6] matches at the start, not the later [6].
+  const std::vector<int32_t> sequence{5, 6, 7, 8, 6, 9, 5, 6};
+  contrib::transformers::LookupDraftTokens(sequence, 2, draft_tokens);
+  EXPECT_EQ(draft_tokens, (std::vector<int32_t>{7, 8}));
+
+  // The number of draft tokens is limited by max_tokens and by the tokens after the match.
+  const std::vector<int32_t> repeated{1, 2, 2};
+  contrib::transformers::LookupDraftTokens(repeated, 4, draft_tokens);
+  EXPECT_EQ(draft_tokens, (std::vector<int32_t>{2}));
+
+  const std::vector<int32_t> no_match{1, 2, 3};
+  contrib::transformers::LookupDraftTokens(no_match, 4, draft_tokens);
+  EXPECT_TRUE(draft_tokens.empty());
+}
+
+// Speculative decoding (prompt lookup + batched verification) shall generate the same sequence as plain greedy search.
+TEST(GreedySearchTest, GptGreedySearchSpeculativeCpu) {
+  const std::vector<int64_t> input_ids_shape{1, 4};
+  const std::vector<int32_t> input_ids{0, 0, 195, 731};
+
+  auto expected_output = RunSpeculativeGreedySearch(0, input_ids_shape, input_ids, 16);
+  auto speculative_output = RunSpeculativeGreedySearch(4, input_ids_shape, input_ids, 16);
+  ASSERT_EQ(expected_output, speculative_output);
+}
+
+// The generated sequence repeats token 114, so prompt lookup drafts it and the verification run accepts it.
+// Accepted drafts append several tokens per decoder run, which shall not change the generated sequence.
+TEST(GreedySearchTest, GptGreedySearchSpeculativeAcceptsDrafts) {
+  const std::vector<int64_t> input_ids_shape{1, 4};
+  const std::vector<int32_t> input_ids{0, 0, 195, 731};
+  const std::vector<int32_t> expected_output{0, 0, 195, 731, 731, 114, 114, 114, 114, 114};
+
+  for (int64_t num_speculative_tokens : {1, 2, 4}) {
+    SCOPED_TRACE(num_speculative_tokens);
+    EXPECT_EQ(expected_output, RunSpeculativeGreedySearch(num_speculative_tokens, input_ids_shape, input_ids, 10));
+  }
+}
+
+// Rolling back rejected draft tokens is only implemented for a single sequence.
+TEST(GreedySearchTest, GptGreedySearchSpeculativeBatchNotImplemented) {
+  const std::vector<int64_t> input_ids_shape{2, 4};
+  const std::vector<int32_t> input_ids{0, 0, 0, 52, 0, 0, 195, 731};
+
+  try {
+    RunSpeculativeGreedySearch(4, input_ids_shape, input_ids, 10);
+    FAIL() << "Expected speculative decoding with batch_size 2 to fail";
+  } catch (const Ort::Exception& e) {
+    EXPECT_EQ(e.GetOrtErrorCode(), ORT_NOT_IMPLEMENTED);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <random>
+#include <vector>
+#include "gtest/gtest.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
+#include "contrib_ops/cpu/transformers/logits_processor.h"
+#include "contrib_ops/cpu/transformers/sequences.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace test {
+
+using namespace onnxruntime::contrib::transformers;
+
+// The fused processing in LogitsProcessorList shall give the same scores as applying each processor in order.
+TEST(LogitsProcessorTest, FusedProcessorsMatchSequentialProcessors) {
+  constexpr int batch_size = 2;
+  constexpr int num_beams = 3;
+  constexpr int batch_beam_size = batch_size * num_beams;
+  constexpr int vocab_size = 37;
+  constexpr int sequence_length = 9;
+  constexpr int max_length = 12;
+
+  std::default_random_engine generator(17);
+  std::uniform_int_distribution<int32_t> token_distribution(0, vocab_size - 1);
+  std::uniform_int_distribution<int32_t> mask_distribution(0, 3);
+  std::uniform_real_distribution<float> score_distribution(-5.0f, 5.0f);
+
+  std::vector<int32_t> sequences_buffer(2 * batch_beam_size * max_length);
+  for (int i = 0; i < batch_beam_size; i++) {
+    for (int j = 0; j < sequence_length; j++) {
+      // A small range of tokens so that repeated tokens and ngrams exist.
+      sequences_buffer[i * max_length + j] = token_distribution(generator) % 5;
+    }
+  }
+  Sequences sequences;
+  sequences.Init(sequences_buffer, batch_beam_size, sequence_length, max_length);
+
+  std::vector<int32_t> vocab_mask(vocab_size);
+  for (auto& value : vocab_mask) {
+    value = mask_distribution(generator) == 0 ? 0 : 1;
+  }
+  std::vector<int32_t> prefix_vocab_mask(batch_size * vocab_size);
+  for (auto& value : prefix_vocab_mask) {
+    value = mask_distribution(generator) == 0 ? 0 : 1;
+  }
+
+  BeamSearchParameters parameters{};
+  parameters.batch_size = batch_size;
+  parameters.num_beams = num_beams;
+  parameters.vocab_size = vocab_size;
+  parameters.eos_token_id = 2;
+  parameters.min_length = max_length;
+  parameters.repetition_penalty = 1.3f;
+  parameters.no_repeat_ngram_size = 2;
+  parameters.temperature = 0.7f;
+  parameters.vocab_mask = vocab_mask;
+  parameters.prefix_vocab_mask = prefix_vocab_mask;
+
+  std::vector<float> scores(batch_beam_size * vocab_size);
+  for (auto& score : scores) {
+    score = score_distribution(generator);
+  }
+  std::vector<float> expected_scores = scores;
+
+  gsl::span<float> expected_span(expected_scores);
+  NextTokenScores<float> next_token_scores{expected_span, batch_beam_size, vocab_size};
+  RepetitionPenaltyLogitsProcessor<float>(parameters.repetition_penalty).Process(&sequences, next_token_scores);
+  NoRepeatNGramLogitsProcessor<float>(parameters.no_repeat_ngram_size).Process(&sequences, next_token_scores);
+  VocabMaskLogitsProcessor<float>(parameters.vocab_mask).Process(&sequences, next_token_scores);
+  PrefixVocabMaskLogitsProcessor<float>(parameters.prefix_vocab_mask, batch_size).Process(&sequences, next_token_scores);
+  MinLengthLogitsProcessor<float>(parameters.min_length, parameters.eos_token_id).Process(&sequences, next_token_scores);
+  TemperatureLogitsProcessor<float>(parameters.temperature).Process(&sequences, next_token_scores);
+
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 3;
+  auto thread_pool = concurrency::CreateThreadPool(&onnxruntime::Env::Default(), tp_params,
+                                                   concurrency::ThreadPoolType::INTRA_OP);
+
+  LogitsProcessorList processors;
+  processors.Init(parameters);
+  gsl::span<float> scores_span(scores);
+  processors.Process(&sequences, scores_span, 1, thread_pool.get());
+
+  ASSERT_EQ(scores, expected_scores);
+}
+
+}  // namespace test
+}  // namespace contrib
+}  // namespace onnxruntime
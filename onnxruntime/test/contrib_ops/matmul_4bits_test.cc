@@ -468,6 +468,119 @@ TEST(MatMulNBits, Float16_Accuracy4) {
 #endif
 #endif
 
+namespace {
+// Pack values of 'bits' width from the least significant bit with no padding, as described in the MatMulNBits spec.
+void PackBits(gsl::span<const uint8_t> values, int bits, gsl::span<uint8_t> packed) {
+  std::fill(packed.begin(), packed.end(), uint8_t{0});
+  for (size_t i = 0; i < values.size(); ++i) {
+    const size_t bit_offset = i * bits;
+    const uint32_t shifted = static_cast<uint32_t>(values[i]) << (bit_offset % 8);
+    packed[bit_offset / 8] |= static_cast<uint8_t>(shifted & 0xFF);
+    if ((bit_offset % 8) + bits > 8) {
+      packed[bit_offset / 8 + 1] |= static_cast<uint8_t>(shifted >> 8);
+    }
+  }
+}
+
+// Test bit widths other than 4 on the CPU EP, which dequantizes B a tile of columns at a time and runs SGEMM for these.
+void RunNonFourBitTest(int bits, int64_t M, int64_t N, int64_t K, int64_t block_size, bool has_zero_point,
+                       bool b_is_initializer = true) {
+  SCOPED_TRACE(::testing::Message() << "bits:" << bits << ", M:" << M << ", N:" << N << ", K:" << K
+                                    << ", block_size:" << block_size << ", has_zero_point:" << has_zero_point
+                                    << ", b_is_initializer:" << b_is_initializer);
+
+  const int64_t blocks_per_K = (K + block_size - 1) / block_size;
+  const int64_t blob_size = (block_size * bits + 7) / 8;
+  const int64_t zp_bytes_per_row = (blocks_per_K * bits + 7) / 8;
+  const int max_value = (1 << bits) - 1;
+
+  RandomValueGenerator random{1234};
+  std::vector<float> a_vals(random.Gaussian<float>(AsSpan({M, K}), 0.0f, 0.25f));
+
+  std::vector<uint8_t> b_vals(static_cast<size_t>(N * blocks_per_K * blob_size));
+  std::vector<float> scales(static_cast<size_t>(N * blocks_per_K));
+  std::vector<uint8_t> zero_points(static_cast<size_t>(N * zp_bytes_per_row));
+  std::vector<float> dequantized_b(static_cast<size_t>(N * K));
+
+  for (int64_t n = 0; n < N; ++n) {
+    std::vector<uint8_t> row_zero_points(static_cast<size_t>(blocks_per_K));
+    for (int64_t b = 0; b < blocks_per_K; ++b) {
+      const size_t scale_idx = static_cast<size_t>(n * blocks_per_K + b);
+      scales[scale_idx] = 0.01f * static_cast<float>(1 + (n + b) % 5);
+      row_zero_points[b] = has_zero_point ? static_cast<uint8_t>((n + 3 * b) % (max_value + 1))
+                                          : static_cast<uint8_t>(1 << (bits - 1));
+
+      std::vector<uint8_t> block_values(static_cast<size_t>(block_size), 0);
+      for (int64_t i = 0; i < block_size && b * block_size + i < K; ++i) {
+        const int64_t k = b * block_size + i;
+        block_values[i] = static_cast<uint8_t>((n * 7 + k * 3) % (max_value + 1));
+        dequantized_b[n * K + k] = (static_cast<float>(block_values[i]) - row_zero_points[b]) * scales[scale_idx];
+      }
+
+      PackBits(block_values, bits,
+               gsl::make_span(b_vals).subspan(static_cast<size_t>((n * blocks_per_K + b) * blob_size),
+                                              static_cast<size_t>(blob_size)));
+    }
+
+    PackBits(row_zero_points, bits,
+             gsl::make_span(zero_points).subspan(static_cast<size_t>(n * zp_bytes_per_row),
+                                                 static_cast<size_t>(zp_bytes_per_row)));
+  }
+
+  std::vector<float> expected_vals(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += a_vals[m * K + k] * dequantized_b[n * K + k];
+      }
+      expected_vals[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", bits);
+  test.AddAttribute<int64_t>("accuracy_level", 0);
+
+  test.AddInput<float>("A", {M, K}, a_vals, false);
+  test.AddInput<uint8_t>("B", {N, blocks_per_K, blob_size}, b_vals, b_is_initializer);
+  test.AddInput<float>("scales", {N * blocks_per_K}, scales, true);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * zp_bytes_per_row}, zero_points, true);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+
+  test.AddOutput<float>("Y", {M, N}, expected_vals);
+  // the float accumulation error grows with K
+  test.SetOutputAbsErr("Y", 1e-4f * static_cast<float>(std::max<int64_t>(1, K / 256)));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> explicit_eps;
+  explicit_eps.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(explicit_eps));
+  test.RunWithConfig();
+}
+}  // namespace
+
+TEST(MatMulNBits, Float32_NonFourBits) {
+  for (int bits : {2, 3, 8}) {
+    for (bool has_zero_point : {false, true}) {
+      RunNonFourBitTest(bits, 1, 1, 16, 16, has_zero_point);
+      RunNonFourBitTest(bits, 3, 5, 32, 16, has_zero_point);
+      RunNonFourBitTest(bits, 4, 17, 93, 32, has_zero_point);
+      RunNonFourBitTest(bits, 2, 8, 256, 128, has_zero_point);
+
+      // large K makes the tiles 16 columns wide, so N is split into three tiles with a partial last one
+      RunNonFourBitTest(bits, 2, 40, 8192, 128, has_zero_point);
+
+      RunNonFourBitTest(bits, 3, 5, 32, 16, has_zero_point, /*b_is_initializer*/ false);
+    }
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DML) || defined(USE_WEBGPU)
 
 namespace {
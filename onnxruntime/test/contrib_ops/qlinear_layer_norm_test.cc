@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <optional>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+const std::vector<int64_t> kXDims = {3, 8};
+const std::vector<int64_t> kNormDims = {8};
+const std::vector<float> kScale = {1.0f, 0.5f, 1.5f, -1.0f, 0.75f, 1.25f, -0.5f, 2.0f};
+const std::vector<float> kBias = {0.1f, -0.2f, 0.3f, 0.0f, -0.4f, 0.25f, 0.05f, -0.15f};
+
+template <typename T>
+void RunQLinearLayerNormalization(const std::vector<T>& x, const std::optional<T>& x_zero_point,
+                                  T y_zero_point, bool with_bias, const std::vector<T>& expected_y) {
+  OpTester test("QLinearLayerNormalization", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("axis", -1);
+  test.AddAttribute<float>("epsilon", 1e-5f);
+  test.AddInput<T>("X", kXDims, x);
+  test.AddInput<float>("X_scale", {}, {0.1f});
+  if (x_zero_point.has_value()) {
+    test.AddInput<T>("X_zero_point", {}, {*x_zero_point});
+  } else {
+    test.AddOptionalInputEdge<T>();  // optional "X_zero_point" using default value here
+  }
+  test.AddInput<float>("Y_scale", {}, {0.05f});
+  test.AddInput<T>("Y_zero_point", {}, {y_zero_point});
+  test.AddInput<float>("Scale", kNormDims, kScale);
+  if (with_bias) {
+    test.AddInput<float>("B", kNormDims, kBias);
+  }
+  test.AddOutput<T>("Y", kXDims, expected_y);
+  test.Run();
+}
+
+}  // namespace
+
+TEST(QLinearLayerNormalizationTest, Int8) {
+  RunQLinearLayerNormalization<int8_t>(
+      {-100, -50, -10, 0, 10, 50, 100, 127,
+       3, 7, -1, -8, 12, -20, 25, -5,
+       -128, 64, -64, 32, -32, 16, -16, 0},
+      std::nullopt, -5, false,
+      {-38, -14, -16, 0, -6, 7, -17, 58,
+       -3, -1, -11, 10, 7, -47, -23, -26,
+       -45, 9, -31, -22, -9, 9, -5, 6});
+}
+
+TEST(QLinearLayerNormalizationTest, Int8_Bias) {
+  RunQLinearLayerNormalization<int8_t>(
+      {-100, -50, -10, 0, 10, 50, 100, 127,
+       3, 7, -1, -8, 12, -20, 25, -5,
+       -128, 64, -64, 32, -32, 16, -16, 0},
+      std::nullopt, -5, true,
+      {-36, -18, -10, 0, -14, 12, -16, 55,
+       -1, -5, -5, 10, -1, -42, -22, -29,
+       -43, 5, -25, -22, -17, 14, -4, 3});
+}
+
+TEST(QLinearLayerNormalizationTest, UInt8) {
+  RunQLinearLayerNormalization<uint8_t>(
+      {28, 78, 118, 128, 138, 178, 228, 255,
+       131, 135, 127, 120, 140, 108, 153, 123,
+       0, 192, 64, 160, 96, 144, 112, 128},
+      uint8_t{128}, 128, false,
+      {95, 119, 117, 133, 127, 140, 116, 191,
+       130, 132, 122, 143, 140, 86, 110, 107,
+       88, 142, 102, 111, 124, 142, 128, 139});
+}
+
+TEST(QLinearLayerNormalizationTest, UInt8_Bias) {
+  RunQLinearLayerNormalization<uint8_t>(
+      {28, 78, 118, 128, 138, 178, 228, 255,
+       131, 135, 127, 120, 140, 108, 153, 123,
+       0, 192, 64, 160, 96, 144, 112, 128},
+      uint8_t{128}, 128, true,
+      {97, 115, 123, 133, 119, 145, 117, 188,
+       132, 128, 128, 143, 132, 91, 111, 104,
+       90, 138, 108, 111, 116, 147, 129, 136});
+}
+
+}  // namespace test
+}  // namespace onnxruntime
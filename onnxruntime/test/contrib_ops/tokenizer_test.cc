@@ -677,6 +677,43 @@ TEST(ContribOpTest, TokenizerWithSeparators_MixCharCommonPrefixC) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }  // namespace test
 
+TEST(ContribOpTest, TokenizerWithSeparators_ManyRowsNC) {
+  // Strings where the first separator does not occur, no separator
+  // occurs, or the whole string is too short to be a token.
+  // [N][C] dimensions
+  // Output [N][C][D]
+  std::vector<std::string> separators = {
+      "#",
+      ";"};
+
+  OpTester test("Tokenizer", opset_ver, domain);
+  InitTestAttr(test, false, separators, 2);
+
+  const std::vector<std::string> strings{"ab;cd", "x", "ab#c;de", "abc"};
+  const std::vector<std::vector<std::string>> tokens{{"ab", "cd"}, {}, {"ab", "de"}, {"abc"}};
+
+  constexpr int64_t N = 100;
+  constexpr int64_t C = 4;
+  std::vector<int64_t> dims{N, C};
+  std::vector<std::string> input;
+  std::vector<std::string> output;
+  for (int64_t i = 0; i < N * C; ++i) {
+    const size_t k = static_cast<size_t>(i % C);
+    input.push_back(strings[k]);
+    output.insert(output.end(), tokens[k].begin(), tokens[k].end());
+    output.insert(output.end(), 2 - tokens[k].size(), padval);
+  }
+  test.AddInput<std::string>("T", dims, input);
+
+  std::vector<int64_t> output_dims(dims);
+  output_dims.push_back(int64_t(2));
+  test.AddOutput<std::string>("Y", output_dims, output);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess);
+}
+
 TEST(ContribOpTest, TokenizerExpression_RegEx) {
   OpTester test("Tokenizer", opset_ver, domain);
   const std::string tokenexp("a.");
@@ -8,6 +8,7 @@
 #include "core/graph/model.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test_utils.h"
 #include "test/test_environment.h"
 #include "test/framework/TestAllocatorManager.h"
@@ -370,6 +371,168 @@ TEST_F(ExecutionFrameTest, MemPatternTest) {
   ASSERT_EQ(p->GetBlock(4)->offset_, kAllocAlignment);
 }
 
+TEST_F(ExecutionFrameTest, SymbolicMemPatternTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 7;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = tensor_float.mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_param("batch");
+  shape->add_dim()->set_dim_value(4);
+  onnxruntime::NodeArg input_def("X", &tensor_float),
+      relu_out_def("T1", &tensor_float),
+      neg_out_def("T2", &tensor_float),
+      output_def("Y", &tensor_float);
+
+  graph.AddNode("node1", "Relu", "relu1", ArgMap{&input_def}, ArgMap{&relu_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "Neg", "neg1", ArgMap{&relu_out_def}, ArgMap{&neg_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node3", "Relu", "relu2", ArgMap{&neg_out_def}, ArgMap{&output_def})
+      .SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  // no buffer reuse, so T1 and T2 are both planned
+  sess_options.enable_mem_reuse = false;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsSymbolicMemoryPattern, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  state.ResolveMemoryPatternFlag();
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int x_idx = -1, t1_idx = -1, t2_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X", x_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T2", t2_idx));
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+
+  // the pattern of each batch size comes from the symbolic sizes, without a Run tracing the allocations
+  for (int64_t batch : {16, 48}) {
+    OrtValue x;
+    CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{batch, 4},
+                         std::vector<float>(static_cast<size_t>(batch * 4), 1.0f), &x);
+
+    const InlinedHashMap<int, TensorShape>* inferred_shapes = nullptr;
+    const auto* pattern_group = state.GetMemoryPatternGroup(AsSpan({x}), AsSpan({x_idx}), inferred_shapes);
+    ASSERT_NE(pattern_group, nullptr);
+
+    const size_t tensor_size = static_cast<size_t>(batch) * 4 * sizeof(float);
+    auto p = pattern_group->GetPatterns(cpu_allocator->Info().device);
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(p->PeakSize(), 2 * tensor_size);
+    ASSERT_EQ(p->GetBlock(t1_idx)->offset_, 0u);
+    ASSERT_EQ(p->GetBlock(t1_idx)->size_, tensor_size);
+    ASSERT_EQ(p->GetBlock(t2_idx)->offset_, tensor_size);
+    ASSERT_EQ(p->GetBlock(t2_idx)->size_, tensor_size);
+  }
+}
+
+TEST_F(ExecutionFrameTest, SymbolicMemPatternSkipsUnresolvedShapeTest) {
+  auto cpu_xp = CreateCPUExecutionProvider();
+  auto xp_type = cpu_xp->Type();
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[onnxruntime::kOnnxDomain] = 9;
+  onnxruntime::Model model("test", true, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           domain_to_version, {}, DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model.MainGraph();
+  TypeProto tensor_float;
+  tensor_float.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto* shape = tensor_float.mutable_tensor_type()->mutable_shape();
+  shape->add_dim()->set_dim_param("batch");
+  shape->add_dim()->set_dim_value(4);
+  TypeProto tensor_int64;
+  tensor_int64.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  TypeProto tensor_float_unknown_shape;
+  tensor_float_unknown_shape.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg input_def("X", &tensor_float),
+      relu_out_def("T1", &tensor_float),
+      nonzero_out_def("T2", &tensor_int64),
+      output_def("Y", &tensor_float_unknown_shape);
+
+  // the number of non-zero values is not known from the input shapes, so T2 can't be planned
+  graph.AddNode("node1", "Relu", "relu1", ArgMap{&input_def}, ArgMap{&relu_out_def})
+      .SetExecutionProviderType(xp_type);
+  graph.AddNode("node2", "NonZero", "nonzero1", ArgMap{&relu_out_def}, ArgMap{&nonzero_out_def})
+      .SetExecutionProviderType(xp_type);
+  auto& cast_node = graph.AddNode("node3", "Cast", "cast1", ArgMap{&nonzero_out_def}, ArgMap{&output_def});
+  cast_node.AddAttribute("to", int64_t{TensorProto_DataType_FLOAT});
+  cast_node.SetExecutionProviderType(xp_type);
+
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  KernelRegistryManager kernel_registry_manager;
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(xp_type, std::move(cpu_xp)));
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+
+  SessionOptions sess_options;
+  sess_options.enable_mem_pattern = true;
+  sess_options.execution_mode = ExecutionMode::ORT_SEQUENTIAL;
+  sess_options.use_deterministic_compute = false;
+  sess_options.enable_mem_reuse = false;
+  ASSERT_STATUS_OK(sess_options.config_options.AddConfigEntry(kOrtSessionOptionsSymbolicMemoryPattern, "1"));
+
+  SessionState state(graph, execution_providers, &tp_, nullptr, dtm, edlm,
+                     DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  ASSERT_STATUS_OK(state.FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager));
+  state.ResolveMemoryPatternFlag();
+
+  const OrtValueNameIdxMap& mlvalue_name_idx_map(state.GetOrtValueNameIdxMap());
+  int x_idx = -1, t1_idx = -1, t2_idx = -1;
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("X", x_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T1", t1_idx));
+  ASSERT_STATUS_OK(mlvalue_name_idx_map.GetIdx("T2", t2_idx));
+
+  auto cpu_allocator = execution_providers.Get(xp_type)->CreatePreferredAllocators()[0];
+
+  constexpr int64_t batch = 16;
+  OrtValue x;
+  CreateMLValue<float>(cpu_allocator, std::vector<int64_t>{batch, 4},
+                       std::vector<float>(static_cast<size_t>(batch * 4), 1.0f), &x);
+
+  const InlinedHashMap<int, TensorShape>* inferred_shapes = nullptr;
+  const auto* pattern_group = state.GetMemoryPatternGroup(AsSpan({x}), AsSpan({x_idx}), inferred_shapes);
+  ASSERT_NE(pattern_group, nullptr);
+
+  // T1 is planned, T2 is left to the execution frame to allocate
+  auto p = pattern_group->GetPatterns(cpu_allocator->Info().device);
+  ASSERT_NE(p, nullptr);
+  ASSERT_EQ(p->PeakSize(), static_cast<size_t>(batch) * 4 * sizeof(float));
+  ASSERT_NE(p->GetBlock(t1_idx), nullptr);
+  ASSERT_EQ(p->GetBlock(t1_idx)->offset_, 0u);
+  ASSERT_EQ(p->GetBlock(t2_idx), nullptr);
+}
+
 #ifdef ENABLE_TRAINING
 TEST_F(ExecutionFrameTest, MemPatternWithExternalOutputsTest) {
   auto cpu_xp = CreateCPUExecutionProvider();
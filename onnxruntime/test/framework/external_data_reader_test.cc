@@ -0,0 +1,90 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <fstream>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/framework/external_data_reader.h"
+#include "core/platform/threadpool.h"
+#include "test/util/include/asserts.h"
+#include "test/util/include/temp_dir.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<char> WriteDataFile(const PathString& path, size_t size, int seed) {
+  std::vector<char> data(size);
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = static_cast<char>((i * 31 + seed) % 251);
+  }
+
+  std::ofstream file(path, std::ios::binary);
+  file.write(data.data(), static_cast<std::streamsize>(data.size()));
+  return data;
+}
+
+}  // namespace
+
+// Ranges of two files are added out of order and read by several tasks in parallel.
+TEST(ExternalDataReaderTest, ReadRangesOfSeveralFiles) {
+  TemporaryDirectory temp_dir(ORT_TSTR("external_data_reader_test"));
+  const PathString file_a = temp_dir.Path() + ORT_TSTR("/a.bin");
+  const PathString file_b = temp_dir.Path() + ORT_TSTR("/b.bin");
+  const auto data_a = WriteDataFile(file_a, 4096, 1);
+  const auto data_b = WriteDataFile(file_b, 1000, 7);
+
+  struct Range {
+    const PathString* file;
+    const std::vector<char>* data;
+    FileOffsetType offset;
+    size_t length;
+  };
+  const std::vector<Range> ranges{{&file_a, &data_a, 2048, 2048},
+                                  {&file_b, &data_b, 500, 500},
+                                  {&file_a, &data_a, 0, 1000},
+                                  {&file_b, &data_b, 0, 100},
+                                  {&file_a, &data_a, 1000, 1048},
+                                  {&file_b, &data_b, 100, 0}};
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = 4;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tpo, concurrency::ThreadPoolType::INTRA_OP);
+
+  // a small task size splits the ranges of a file across tasks
+  ExternalDataReader reader(Env::Default(), 1024);
+  std::vector<std::vector<char>> buffers;
+  buffers.reserve(ranges.size());
+  for (const auto& range : ranges) {
+    buffers.emplace_back(range.length);
+    reader.Add(*range.file, range.offset, range.length, buffers.back().data());
+  }
+  EXPECT_EQ(reader.NumRequests(), ranges.size() - 1);
+
+  ASSERT_STATUS_OK(reader.Read(thread_pool.get()));
+  EXPECT_EQ(reader.NumRequests(), 0u);
+
+  for (size_t i = 0; i < ranges.size(); ++i) {
+    const auto& range = ranges[i];
+    const std::vector<char> expected(range.data->begin() + range.offset,
+                                     range.data->begin() + range.offset + range.length);
+    EXPECT_EQ(buffers[i], expected) << "range " << i;
+  }
+}
+
+TEST(ExternalDataReaderTest, ReadPastEndOfFileFails) {
+  TemporaryDirectory temp_dir(ORT_TSTR("external_data_reader_test"));
+  const PathString file = temp_dir.Path() + ORT_TSTR("/a.bin");
+  WriteDataFile(file, 100, 3);
+
+  ExternalDataReader reader(Env::Default());
+  std::vector<char> buffer(64);
+  reader.Add(file, 64, buffer.size(), buffer.data());
+  EXPECT_FALSE(reader.Read(nullptr).IsOK());
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -17,6 +17,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/profiler.h"
+#include "core/framework/allocator_utils.h"
 #include "core/framework/compute_capability.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_provider.h"
@@ -27,6 +28,7 @@
 #include "core/framework/bfc_arena.h"
 #include "core/graph/graph_viewer.h"
 #include "core/graph/model.h"
+#include "core/graph/model_saving_options.h"
 #include "core/graph/op.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/platform/env.h"
@@ -56,6 +58,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -1836,6 +1839,141 @@ TEST(InferenceSessionTests, Test2LayerNestedSubgraph) {
   VerifyOutputs(fetches, expected_dims, expected_values);
 }
 
+// Create a model with an If node. Both branches compute 'x * (x + x) - x' from the outer scope value 'x', so the
+// subgraph has intermediate values that are allocated from its memory pattern.
+static void CreateIfModelWithIntermediateValues(const PathString& model_file_name) {
+  ONNX_NAMESPACE::TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+  ONNX_NAMESPACE::TypeProto bool_tensor;
+  bool_tensor.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_BOOL);
+  bool_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  ONNX_NAMESPACE::GraphProto if_branch;
+  {
+    onnxruntime::Model model("if_branch", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                             {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+    graph.AddOuterScopeNodeArg("x");
+
+    auto& x_plus_x = graph.GetOrCreateNodeArg("x_plus_x", &float_tensor);
+    auto& product = graph.GetOrCreateNodeArg("product", &float_tensor);
+    auto& output = graph.GetOrCreateNodeArg("if_branch_output", &float_tensor);
+
+    graph.AddNode("add", "Add", "", {&x, &x}, {&x_plus_x});
+    graph.AddNode("mul", "Mul", "", {&x_plus_x, &x}, {&product});
+    graph.AddNode("sub", "Sub", "", {&product, &x}, {&output});
+
+    ASSERT_STATUS_OK(graph.Resolve());
+    if_branch = graph.ToGraphProto();
+  }
+
+  onnxruntime::Model model("if_model", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", &float_tensor);
+
+  auto& if_node = graph.AddNode("if", "If", "", {&cond}, {&y});
+  if_node.AddAttribute("then_branch", if_branch);
+  if_node.AddAttribute("else_branch", if_branch);
+
+  graph.SetInputs({&x, &cond});
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::Save(model, model_file_name));
+}
+
+static void RunIfModelWithIntermediateValues(InferenceSession& session_object, const RunOptions& run_options) {
+  OrtValue ml_value_x;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, 3},
+                       {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &ml_value_x);
+  const int64_t dim_cond[] = {1};
+  const bool data_cond[] = {true};
+  OrtValue ml_value_cond;
+  CreateMLValue<bool>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], dim_cond, data_cond,
+                      &ml_value_cond);
+
+  NameMLValMap feeds;
+  feeds.insert(std::make_pair("x", ml_value_x));
+  feeds.insert(std::make_pair("cond", ml_value_cond));
+
+  std::vector<std::string> output_names{"y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session_object.Run(run_options, feeds, output_names, &fetches));
+  VerifyOutputs(fetches, {2, 3}, {1.0f, 6.0f, 15.0f, 28.0f, 45.0f, 66.0f});
+}
+
+static const SessionState* GetIfThenBranchSessionState(const InferenceSessionWrapper& session_object) {
+  const SessionState& session_state = session_object.GetSessionState();
+  for (const auto& node : session_state.GetGraphViewer().Nodes()) {
+    if (node.OpType() == "If") {
+      return session_state.GetSubgraphSessionState(node.Index(), "then_branch");
+    }
+  }
+
+  return nullptr;
+}
+
+TEST(InferenceSessionTests, SubgraphMemoryPatternBufferReuse) {
+  PathString model_file_name = ORT_TSTR("if-model-with-intermediate-values.onnx");
+  CreateIfModelWithIntermediateValues(model_file_name);
+
+  {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.SubgraphMemoryPatternBufferReuse";
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_file_name));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    const SessionState* then_branch_session_state = GetIfThenBranchSessionState(session_object);
+    ASSERT_NE(then_branch_session_state, nullptr);
+    ASSERT_TRUE(then_branch_session_state->GetEnableMemoryPattern());
+
+    // the first Run records the memory pattern of the subgraph, so it has no memory pattern buffer to return
+    RunOptions run_options;
+    RunIfModelWithIntermediateValues(session_object, run_options);
+    ASSERT_EQ(then_branch_session_state->GetNumberOfPooledMemoryPatternBuffers(), 0u);
+
+    // every later Run takes the buffer returned by the previous one, so the pool does not grow
+    for (int i = 0; i < 4; ++i) {
+      RunIfModelWithIntermediateValues(session_object, run_options);
+      ASSERT_EQ(then_branch_session_state->GetNumberOfPooledMemoryPatternBuffers(), 1u);
+    }
+
+    // shrinking the arena releases the pooled buffer
+    if (DoesCpuAllocatorSupportArenaUsage()) {
+      RunOptions shrink_run_options;
+      ASSERT_STATUS_OK(shrink_run_options.config_options.AddConfigEntry(
+          kOrtRunOptionsConfigEnableMemoryArenaShrinkage, "cpu:0"));
+      RunIfModelWithIntermediateValues(session_object, shrink_run_options);
+      ASSERT_EQ(then_branch_session_state->GetNumberOfPooledMemoryPatternBuffers(), 0u);
+    }
+  }
+
+  {
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.SubgraphMemoryPatternBufferReuse";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsDisableSubgraphMemoryPatternBufferPool, "1"));
+    InferenceSessionWrapper session_object{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session_object.Load(model_file_name));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    const SessionState* then_branch_session_state = GetIfThenBranchSessionState(session_object);
+    ASSERT_NE(then_branch_session_state, nullptr);
+
+    RunOptions run_options;
+    for (int i = 0; i < 3; ++i) {
+      RunIfModelWithIntermediateValues(session_object, run_options);
+      ASSERT_EQ(then_branch_session_state->GetNumberOfPooledMemoryPatternBuffers(), 0u);
+    }
+  }
+}
+
 TEST(InferenceSessionTests, TestTruncatedSequence) {
   // model/data generated by <repo>/onnxruntime/test/testdata/CNTK/gen.py GenScan()
   // Manually updated to have IR version of 4.
@@ -3059,5 +3197,174 @@ TEST(InferenceSessionTests, InterThreadPoolWithDenormalAsZero) {
 }
 #endif
 
+// Saves Y = Relu(X * W1 + B1) * W2 to <dir>/model.onnx with the initializers of at least external_data_threshold bytes
+// in <dir>/weights.bin. Both MatMul nodes have a constant B, so the CPU kernels pre-pack their weights.
+static void CreateExternalDataModel(const PathString& dir, size_t external_data_threshold = 0) {
+  onnxruntime::Model model("external_data", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                           {{kOnnxDomain, 12}}, {}, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  auto float_tensor = [](std::initializer_list<int64_t> dims) {
+    ONNX_NAMESPACE::TypeProto type;
+    type.mutable_tensor_type()->set_elem_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    for (int64_t dim : dims) {
+      type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(dim);
+    }
+    return type;
+  };
+  auto add_initializer = [&graph](const std::string& name, std::initializer_list<int64_t> dims, float scale) {
+    ONNX_NAMESPACE::TensorProto tensor;
+    tensor.set_name(name);
+    tensor.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    int64_t size = 1;
+    for (int64_t dim : dims) {
+      tensor.add_dims(dim);
+      size *= dim;
+    }
+    for (int64_t i = 0; i < size; ++i) {
+      tensor.add_float_data(scale * static_cast<float>(i % 7 - 3));
+    }
+    graph.AddInitializedTensor(tensor);
+  };
+
+  add_initializer("W1", {8, 16}, 0.25f);
+  add_initializer("B1", {16}, 0.5f);
+  add_initializer("W2", {16, 4}, 0.125f);
+
+  const auto x_type = float_tensor({4, 8});
+  const auto hidden_type = float_tensor({4, 16});
+  const auto w1_type = float_tensor({8, 16});
+  const auto b1_type = float_tensor({16});
+  const auto w2_type = float_tensor({16, 4});
+  const auto y_type = float_tensor({4, 4});
+  auto& x = graph.GetOrCreateNodeArg("X", &x_type);
+  auto& w1 = graph.GetOrCreateNodeArg("W1", &w1_type);
+  auto& b1 = graph.GetOrCreateNodeArg("B1", &b1_type);
+  auto& w2 = graph.GetOrCreateNodeArg("W2", &w2_type);
+  auto& matmul_out = graph.GetOrCreateNodeArg("matmul_out", &hidden_type);
+  auto& add_out = graph.GetOrCreateNodeArg("add_out", &hidden_type);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", &hidden_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &y_type);
+  graph.AddNode("matmul_1", "MatMul", "", {&x, &w1}, {&matmul_out});
+  graph.AddNode("add", "Add", "", {&matmul_out, &b1}, {&add_out});
+  graph.AddNode("relu", "Relu", "", {&add_out}, {&relu_out});
+  graph.AddNode("matmul_2", "MatMul", "", {&relu_out, &w2}, {&y});
+
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_STATUS_OK(onnxruntime::Model::SaveWithExternalInitializers(model, dir + ORT_TSTR("/model.onnx"),
+                                                                    ORT_TSTR("weights.bin"),
+                                                                    ModelSavingOptions{external_data_threshold}));
+}
+
+// Runs <dir>/model.onnx from CreateExternalDataModel and checks Y against a reference computed here.
+static void RunExternalDataModel(const PathString& dir, const SessionOptions& so, size_t* num_prepacks) {
+  InferenceSessionWrapper session{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(dir + ORT_TSTR("/model.onnx")));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  std::vector<float> x(4 * 8);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i] = 0.1f * static_cast<float>(static_cast<int>(i % 11) - 5);
+  }
+  auto weight = [](size_t i, float scale) { return scale * static_cast<float>(static_cast<int>(i % 7) - 3); };
+  std::vector<float> expected(4 * 4, 0.f);
+  for (size_t row = 0; row < 4; ++row) {
+    for (size_t k = 0; k < 16; ++k) {
+      float hidden = weight(k, 0.5f);
+      for (size_t j = 0; j < 8; ++j) {
+        hidden += x[row * 8 + j] * weight(j * 16 + k, 0.25f);
+      }
+      hidden = std::max(hidden, 0.f);
+      for (size_t col = 0; col < 4; ++col) {
+        expected[row * 4 + col] += hidden * weight(k * 4 + col, 0.125f);
+      }
+    }
+  }
+
+  OrtValue ml_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {4, 8}, x, &ml_value);
+  NameMLValMap feeds{{"X", ml_value}};
+  std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, output_names, &fetches));
+  ASSERT_EQ(fetches.size(), 1u);
+  auto y = fetches[0].Get<Tensor>().DataAsSpan<float>();
+  ASSERT_EQ(y.size(), expected.size());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    EXPECT_NEAR(y[i], expected[i], 1e-4f) << "i=" << i;
+  }
+
+  *num_prepacks = session.GetSessionState().GetNumberOfPrepacksCounter();
+}
+
+// The external initializers are read by the ExternalDataReader when session.parallel_external_data_read is set,
+// and through DeserializeTensorProto otherwise. Both must give the same outputs and pre-pack the MatMul weights.
+TEST(InferenceSessionTests, ParallelExternalDataRead) {
+  TemporaryDirectory temp_dir(ORT_TSTR("parallel_external_data_read_test"));
+  CreateExternalDataModel(temp_dir.Path());
+
+  for (const char* parallel_read : {"0", "1"}) {
+    SCOPED_TRACE(parallel_read);
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.ParallelExternalDataRead";
+    so.intra_op_param.thread_pool_size = 4;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigParallelInitialization, "1"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsParallelExternalDataRead, parallel_read));
+
+    size_t num_prepacks = 0;
+    RunExternalDataModel(temp_dir.Path(), so, &num_prepacks);
+    EXPECT_GT(num_prepacks, 0u);
+  }
+}
+
+// External initializers used on CPU are memory mapped with or without session.lazy_initializers. Without it they are
+// still traced by the initializer planner, so the initializer memory pattern reserves arena memory for them that is
+// never used. Lazy mode skips that trace and allocates the initializers stored in the model with the device allocator.
+// The outputs and the pre-packing must not change.
+TEST(InferenceSessionTests, LazyInitializersWithExternalData) {
+  TemporaryDirectory temp_dir(ORT_TSTR("lazy_initializers_test"));
+  // W1 and W2 go to weights.bin, the 64 byte B1 stays in the model
+  CreateExternalDataModel(temp_dir.Path(), 128);
+
+  size_t num_prepacks[2] = {};
+  for (int lazy = 0; lazy < 2; ++lazy) {
+    SCOPED_TRACE(lazy);
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.LazyInitializersWithExternalData";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyInitializers, lazy ? "1" : "0"));
+    RunExternalDataModel(temp_dir.Path(), so, &num_prepacks[lazy]);
+  }
+
+  EXPECT_GT(num_prepacks[0], 0u);
+  EXPECT_EQ(num_prepacks[1], num_prepacks[0]);
+
+  // the initializer memory pattern is only used when pre-packing is disabled
+  AllocatorStats alloc_stats[2];
+  for (int lazy = 0; lazy < 2; ++lazy) {
+    SCOPED_TRACE(lazy);
+    SessionOptions so;
+    so.session_logid = "InferenceSessionTests.LazyInitializersWithExternalData";
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigDisablePrepacking, "1"));
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsLazyInitializers, lazy ? "1" : "0"));
+    InferenceSessionWrapper session{so, GetEnvironment()};
+    ASSERT_STATUS_OK(session.Load(temp_dir.Path() + ORT_TSTR("/model.onnx")));
+    ASSERT_STATUS_OK(session.Initialize());
+
+    auto cpu_alloc = session.GetSessionState().GetAllocator(OrtDevice());
+    ASSERT_NE(cpu_alloc, nullptr);
+    if (cpu_alloc->Info().alloc_type != OrtArenaAllocator) {
+      GTEST_SKIP() << "CPU allocator is not an arena";
+    }
+    cpu_alloc->GetStats(&alloc_stats[lazy]);
+  }
+
+  // one planned buffer that covers W1, W2 and B1
+  EXPECT_EQ(alloc_stats[0].num_reserves, 1);
+  EXPECT_GE(alloc_stats[0].bytes_in_use, static_cast<int64_t>((8 * 16 + 16 + 16 * 4) * sizeof(float)));
+  // B1 only, allocated on its own
+  EXPECT_EQ(alloc_stats[1].num_reserves, 1);
+  EXPECT_EQ(alloc_stats[1].bytes_in_use, static_cast<int64_t>(16 * sizeof(float)));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
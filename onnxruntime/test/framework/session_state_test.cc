@@ -311,6 +311,49 @@ TEST_P(SessionStateTestP, TestInitializerProcessing) {
   }
 }
 
+// Test that memory pattern buffers returned to the SessionState are handed out again to requests they can satisfy
+TEST(SessionStateTest, MemoryPatternBufferPool) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false))));
+
+  DataTransferManager dtm;
+  ExternalDataLoaderManager edlm;
+  profiling::Profiler profiler;
+  SessionOptions sess_options;
+
+  SessionState s(graph, execution_providers, nullptr, nullptr, dtm, edlm,
+                 DefaultLoggingManager().DefaultLogger(), profiler, sess_options);
+
+  AllocatorPtr cpu_allocator = std::make_shared<CPUAllocator>();
+  const OrtDevice& cpu_device = cpu_allocator->Info().device;
+
+  ASSERT_EQ(s.AcquireMemoryPatternBuffer(cpu_device, 64), nullptr);
+
+  void* small_buffer = cpu_allocator->Alloc(64);
+  void* large_buffer = cpu_allocator->Alloc(256);
+  s.RecycleMemoryPatternBuffer(cpu_device, 256, BufferUniquePtr(large_buffer, BufferDeleter(cpu_allocator)));
+  s.RecycleMemoryPatternBuffer(cpu_device, 64, BufferUniquePtr(small_buffer, BufferDeleter(cpu_allocator)));
+
+  // no buffer is large enough
+  ASSERT_EQ(s.AcquireMemoryPatternBuffer(cpu_device, 512), nullptr);
+
+  // smallest buffer that fits is used
+  void* buffer = s.AcquireMemoryPatternBuffer(cpu_device, 32);
+  ASSERT_EQ(buffer, small_buffer);
+  BufferUniquePtr small_buffer_owner(buffer, BufferDeleter(cpu_allocator));
+
+  buffer = s.AcquireMemoryPatternBuffer(cpu_device, 100);
+  ASSERT_EQ(buffer, large_buffer);
+  BufferUniquePtr large_buffer_owner(buffer, BufferDeleter(cpu_allocator));
+
+  ASSERT_EQ(s.AcquireMemoryPatternBuffer(cpu_device, 32), nullptr);
+}
+
 // Test that we allocate memory for an initializer from non-arena memory even if we provide an arena-based allocator
 // if the relevant session option config flag is set
 TEST(SessionStateTest, TestInitializerMemoryAllocatedUsingNonArenaMemory) {
@@ -758,6 +801,8 @@ static void PlaceAllNodesToCPUEP(Graph& graph) {
 struct PrepackingTestParam {
   bool test_subgraph;
   bool test_prepacking;
+  bool test_parallel_initialization = false;
+  bool test_lazy_initializers = false;
 };
 
 class SessionStatePrepackingTest : public testing::TestWithParam<PrepackingTestParam> {};
@@ -800,6 +845,10 @@ TEST_P(SessionStatePrepackingTest, PrePackingTest) {
   sess_options.enable_mem_reuse = true;
   sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] =
       test_param.test_prepacking ? "0" : "1";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigParallelInitialization] =
+      test_param.test_parallel_initialization ? "1" : "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsLazyInitializers] =
+      test_param.test_lazy_initializers ? "1" : "0";
 
   SessionState session_state(model.MainGraph(),
                              execution_providers,
@@ -1424,7 +1473,12 @@ INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          testing::Values(PrepackingTestParam{false, false},
                                          PrepackingTestParam{false, true},
                                          PrepackingTestParam{true, false},
-                                         PrepackingTestParam{true, true}));
+                                         PrepackingTestParam{true, true},
+                                         PrepackingTestParam{false, true, true},
+                                         PrepackingTestParam{true, true, true},
+                                         PrepackingTestParam{false, false, false, true},
+                                         PrepackingTestParam{false, true, false, true},
+                                         PrepackingTestParam{true, true, false, true}));
 #endif
 
 }  // namespace test
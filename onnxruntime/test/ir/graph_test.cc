@@ -1507,6 +1507,80 @@ TEST_F(GraphTest, ShapeInferenceErrorHandling) {
                                       "Node (node_1) Op (ShapeInferenceThrowsOp) [ShapeInferenceError] try harder");
 }
 
+TEST_F(GraphTest, IncrementalResolve) {
+  Model model("graph", false, *logger_);
+  auto& graph = model.MainGraph();
+  // cross-check every incremental pass against a full one
+  graph.SetIncrementalResolve(true, true);
+
+  TypeProto tensor_float;
+  SetTypeAndShape(tensor_float.mutable_tensor_type(), TensorProto_DataType_FLOAT, {2, 3});
+
+  auto& x = graph.GetOrCreateNodeArg("x", &tensor_float);
+  auto& relu_out = graph.GetOrCreateNodeArg("relu_out", nullptr);
+  auto& identity_out = graph.GetOrCreateNodeArg("identity_out", nullptr);
+  graph.AddNode("relu", "Relu", "", {&x}, {&relu_out});
+  graph.AddNode("identity", "Identity", "", {&relu_out}, {&identity_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto expect_shape = [](const NodeArg& arg, const std::vector<int64_t>& expected) {
+    ASSERT_NE(arg.Shape(), nullptr) << arg.Name();
+    EXPECT_EQ(utils::GetTensorShapeFromTensorShapeProto(*arg.Shape()), TensorShape(expected)) << arg.Name();
+  };
+
+  expect_shape(identity_out, {2, 3});
+  EXPECT_EQ(graph.GetNumNodesSkippedByLastResolve(), 0u);
+
+  // the new nodes downstream of an existing value are inferred. the unchanged nodes are skipped.
+  auto& transpose_out = graph.GetOrCreateNodeArg("transpose_out", nullptr);
+  auto& neg_out = graph.GetOrCreateNodeArg("neg_out", nullptr);
+  graph.AddNode("transpose", "Transpose", "", {&relu_out}, {&transpose_out});
+  graph.AddNode("neg", "Neg", "", {&transpose_out}, {&neg_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  expect_shape(transpose_out, {3, 2});
+  expect_shape(neg_out, {3, 2});
+  expect_shape(identity_out, {2, 3});
+  EXPECT_EQ(graph.GetNumNodesSkippedByLastResolve(), 2u);
+
+  // a new node reading a new constant initializer is inferred from the initializer data
+  auto& unsqueeze_axes = graph.GetOrCreateNodeArg("axes", nullptr);
+  ONNX_NAMESPACE::TensorProto axes;
+  axes.set_name("axes");
+  axes.set_data_type(TensorProto_DataType_INT64);
+  axes.add_dims(1);
+  axes.add_int64_data(0);
+  graph.AddInitializedTensor(axes);
+  auto& unsqueeze_out = graph.GetOrCreateNodeArg("unsqueeze_out", nullptr);
+  auto& softmax_out = graph.GetOrCreateNodeArg("softmax_out", nullptr);
+  graph.AddNode("unsqueeze", "Unsqueeze", "", {&neg_out, &unsqueeze_axes}, {&unsqueeze_out});
+  Node& softmax = graph.AddNode("softmax", "Softmax", "", {&unsqueeze_out}, {&softmax_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+  expect_shape(softmax_out, {1, 3, 2});
+  EXPECT_EQ(graph.GetNumNodesSkippedByLastResolve(), 4u);
+
+  // an attribute change re-infers the node
+  softmax.AddAttribute("axis", static_cast<int64_t>(1));
+  ASSERT_STATUS_OK(graph.Resolve());
+  expect_shape(softmax_out, {1, 3, 2});
+  EXPECT_EQ(graph.GetNumNodesSkippedByLastResolve(), 5u);
+
+  // so does a change through the mutable attributes
+  softmax.GetMutableAttributes()["axis"].set_i(2);
+  graph.SetGraphResolveNeeded();
+  ASSERT_STATUS_OK(graph.Resolve());
+  expect_shape(softmax_out, {1, 3, 2});
+  EXPECT_EQ(graph.GetNumNodesSkippedByLastResolve(), 5u);
+
+  // and the replacement of a constant initializer whose data the inference read. -3 is the same axis as 0.
+  graph.RemoveInitializedTensor("axes");
+  axes.set_int64_data(0, -3);
+  graph.AddInitializedTensor(axes);
+  ASSERT_STATUS_OK(graph.Resolve());
+  expect_shape(unsqueeze_out, {1, 3, 2});
+  EXPECT_EQ(graph.GetNumNodesSkippedByLastResolve(), 5u);
+}
+
 TEST_F(GraphTest, AddTensorAttribute) {
   OPERATOR_SCHEMA(__Constant)
       .SetDoc("Constant Op.")
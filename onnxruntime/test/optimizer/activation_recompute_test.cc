@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <memory>
+
+#include "gtest/gtest.h"
+
+#include "core/framework/session_options.h"
+#include "core/graph/graph.h"
+#include "core/optimizer/activation_recompute.h"
+#include "test/optimizer/graph_transform_test_builder.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// x -> Relu -> a. 'a' is read right away by Add(a, x) and again by the last node, so it stays alive across the
+// Mul/Add in between where the estimated peak is 4 tensors of 4KB.
+void BuildLongLivedActivation(ModelTestBuilder& builder) {
+  auto* x = builder.MakeInput<float>(std::vector<int64_t>{1024}, -1.f, 1.f);
+  auto* a = builder.MakeIntermediate();
+  auto* b = builder.MakeIntermediate();
+  auto* c = builder.MakeIntermediate();
+  auto* d = builder.MakeIntermediate();
+  auto* e = builder.MakeOutput();
+
+  builder.AddNode("Relu", {x}, {a});
+  builder.AddNode("Add", {a, x}, {b});
+  builder.AddNode("Mul", {b, b}, {c});
+  builder.AddNode("Add", {c, b}, {d});
+  builder.AddNode("Add", {d, a}, {e});
+}
+
+}  // namespace
+
+TEST(ActivationRecomputeTests, RecomputeAcrossPeak) {
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Relu"] == 1);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Relu"] == 2);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() != "Relu") {
+        continue;
+      }
+
+      // the copy has a low priority and feeds the last Add only, the original feeds the first Add only
+      const bool is_recompute = node.Priority() == static_cast<int>(ExecutionPriority::LOCAL_LOW);
+      TEST_RETURN_IF_NOT(node.GetOutputEdgesCount() == 1);
+      const Node& consumer = *node.OutputNodesBegin();
+      TEST_RETURN_IF_NOT(consumer.OpType() == "Add");
+      TEST_RETURN_IF_NOT(graph.IsOutput(consumer.OutputDefs()[0]) == is_recompute);
+    }
+
+    return Status::OK();
+  };
+
+  // the peak drops from 16KB to 12KB once 'a' is released after its first use
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildLongLivedActivation, 14, logging::LoggingManager::DefaultLogger(),
+                                        std::make_unique<ActivationRecompute>(12 * 1024), TransformerLevel::Level1,
+                                        1, pre_graph_checker, post_graph_checker));
+}
+
+TEST(ActivationRecomputeTests, NoRecomputeWithinBudget) {
+  auto graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Relu"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(BuildLongLivedActivation, 14, logging::LoggingManager::DefaultLogger(),
+                                        std::make_unique<ActivationRecompute>(16 * 1024), TransformerLevel::Level1,
+                                        1, graph_checker, graph_checker));
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,106 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+static void EnableElementwiseFusion(SessionOptions& session_options) {
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseFusion, "1"));
+}
+
+// Add -> Mul(scalar) -> Sigmoid -> Sub(x) with the Mul result also feeding a Tanh graph output.
+TEST(ElementwiseFusionTests, ChainWithBranch) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({2, 3, 16}, -4.f, 4.f);
+    auto* y = builder.MakeInput<float>({2, 3, 16}, -4.f, 4.f);
+    auto* scale = builder.MakeScalarInitializer<float>(0.5f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* mul_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    auto* sub_out = builder.MakeOutput();
+    auto* tanh_out = builder.MakeOutput();
+
+    builder.AddNode("Add", {x, y}, {add_out});
+    builder.AddNode("Mul", {add_out, scale}, {mul_out});
+    builder.AddNode("Sigmoid", {mul_out}, {sigmoid_out});
+    builder.AddNode("Sub", {sigmoid_out, x}, {sub_out});
+    builder.AddNode("Tanh", {mul_out}, {tanh_out});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    EXPECT_EQ(op_to_count["Sigmoid"], 0);
+    EXPECT_EQ(op_to_count["Sub"], 0);
+    EXPECT_EQ(op_to_count["Tanh"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13,
+                    1e-5, 1e-5, nullptr, EnableElementwiseFusion);
+}
+
+// A bias that is broadcast along the last axis is not a single element, so the Add stays out of the fused node.
+TEST(ElementwiseFusionTests, BroadcastInputNotFused) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({4, 8}, -4.f, 4.f);
+    auto* bias = builder.MakeInitializer<float>({8}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Add", {x, bias}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Neg", {relu_out}, {output});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Neg"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13,
+                    1e-5, 1e-5, nullptr, EnableElementwiseFusion);
+}
+
+// The fusion is off unless kOrtSessionOptionsEnableElementwiseFusion is set.
+TEST(ElementwiseFusionTests, DisabledByDefault) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* x = builder.MakeInput<float>({2, 3, 16}, -4.f, 4.f);
+    auto* y = builder.MakeInput<float>({2, 3, 16}, -4.f, 4.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("Add", {x, y}, {add_out});
+    builder.AddNode("Sigmoid", {add_out}, {output});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 0);
+    EXPECT_EQ(op_to_count["Add"], 1);
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level3, 13);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -2173,6 +2173,108 @@ TEST_F(GraphTransformationTests, LabelEncoderFusion) {
   EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
 }
 
+#if !defined(DISABLE_ML_OPS)
+// With kOrtSessionOptionsZipMapOutputAsTensor the ZipMap output is returned as the dense probabilities
+// plus a tensor of class labels.
+TEST_F(GraphTransformationTests, ZipMapOutputAsTensor) {
+  Model model("ZipMapOutputAsTensor", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}, {kMLDomain, 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto map_sequence;
+  auto* map_type = map_sequence.mutable_sequence_type()->mutable_elem_type()->mutable_map_type();
+  map_type->set_key_type(TensorProto_DataType_INT64);
+  map_type->mutable_value_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& probabilities = graph.GetOrCreateNodeArg("probabilities", &float_tensor);
+  auto& output = graph.GetOrCreateNodeArg("Y", &map_sequence);
+
+  graph.AddNode("relu", "Relu", "", {&input}, {&probabilities});
+  auto& zipmap = graph.AddNode("zipmap", "ZipMap", "", {&probabilities}, {&output}, nullptr, kMLDomain);
+  zipmap.AddAttribute("classlabels_int64s", std::vector<int64_t>{10, 20, 30});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions session_options;
+  session_options.session_logid = "OptimizerTests";
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsZipMapOutputAsTensor, "1"));
+  InferenceSessionWrapper session{session_options, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  ASSERT_STATUS_OK(session.Initialize());
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(session.GetGraph());
+  ASSERT_EQ(op_to_count["ai.onnx.ml.ZipMap"], 0);
+  ASSERT_EQ(op_to_count["Identity"], 0);  // Relu writes Y directly
+
+  const auto& graph_outputs = session.GetGraph().GetOutputs();
+  ASSERT_EQ(graph_outputs.size(), 2u);
+  ASSERT_EQ(graph_outputs[0]->Name(), "Y");
+  ASSERT_EQ(graph_outputs[1]->Name(), "Y_labels");
+
+  const std::vector<float> x = {0.1f, 0.2f, 0.7f, 0.3f, 0.3f, 0.4f};
+  OrtValue x_value;
+  CreateMLValue<float>(TestCPUExecutionProvider()->CreatePreferredAllocators()[0], {2, 3}, x, &x_value);
+  NameMLValMap feeds{{"X", x_value}};
+
+  std::vector<OrtValue> fetches;
+  ASSERT_STATUS_OK(session.Run(RunOptions{}, feeds, {"Y", "Y_labels"}, &fetches));
+  ASSERT_EQ(fetches.size(), 2u);
+
+  const auto& y = fetches[0].Get<Tensor>();
+  ASSERT_EQ(y.Shape(), TensorShape({2, 3}));
+  EXPECT_THAT(y.DataAsSpan<float>(), ::testing::ElementsAreArray(x));
+
+  const auto& labels = fetches[1].Get<Tensor>();
+  EXPECT_THAT(labels.DataAsSpan<int64_t>(), ::testing::ElementsAre(10, 20, 30));
+}
+
+// The labels output must be named "<output name>_labels", so the session fails if the model already uses that name.
+TEST_F(GraphTransformationTests, ZipMapOutputAsTensorLabelsNameTaken) {
+  Model model("ZipMapOutputAsTensorLabelsNameTaken", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 12}, {kMLDomain, 1}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(3);
+
+  TypeProto map_sequence;
+  auto* map_type = map_sequence.mutable_sequence_type()->mutable_elem_type()->mutable_map_type();
+  map_type->set_key_type(TensorProto_DataType_INT64);
+  map_type->mutable_value_type()->mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  auto& input = graph.GetOrCreateNodeArg("X", &float_tensor);
+  auto& output = graph.GetOrCreateNodeArg("Y", &map_sequence);
+  auto& other_output = graph.GetOrCreateNodeArg("Y_labels", &float_tensor);
+
+  auto& zipmap = graph.AddNode("zipmap", "ZipMap", "", {&input}, {&output}, nullptr, kMLDomain);
+  zipmap.AddAttribute("classlabels_int64s", std::vector<int64_t>{10, 20, 30});
+  graph.AddNode("relu", "Relu", "", {&input}, {&other_output});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string model_data;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&model_data));
+
+  SessionOptions session_options;
+  session_options.session_logid = "OptimizerTests";
+  ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsZipMapOutputAsTensor, "1"));
+  InferenceSessionWrapper session{session_options, GetEnvironment()};
+  ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
+  auto status = session.Initialize();
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_THAT(status.ErrorMessage(), ::testing::HasSubstr("Y_labels"));
+}
+#endif  // !defined(DISABLE_ML_OPS)
+
 TEST_F(GraphTransformationTests, NotWhereFusion) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/not_where.onnx";
   std::shared_ptr<Model> model;
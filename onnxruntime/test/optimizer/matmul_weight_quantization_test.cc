@@ -0,0 +1,126 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+
+#include "gtest/gtest.h"
+#include "graph_transform_test_builder.h"
+
+#include "core/graph/graph.h"
+#include "core/graph/node_attr_utils.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+#ifndef DISABLE_CONTRIB_OPS
+
+namespace {
+
+const Node* FindNodeByOpType(const Graph& graph, const std::string& op_type) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.OpType() == op_type) {
+      return &node;
+    }
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+// MatMul and Gemm(transB=1, bias) weights become MatMulNBits. A second MatMul is excluded by name and keeps its weight.
+TEST(MatMulWeightQuantizationTests, Int4MatMulAndGemm) {
+  std::string gemm_name;
+  std::string excluded_name;
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input = builder.MakeInput<float>({4, 64}, -1.f, 1.f);
+    auto* weight = builder.MakeInitializer<float>({64, 48}, -1.f, 1.f);
+    auto* gemm_weight = builder.MakeInitializer<float>({32, 48}, -1.f, 1.f);
+    auto* gemm_bias = builder.MakeInitializer<float>({32}, -1.f, 1.f);
+    auto* excluded_weight = builder.MakeInitializer<float>({32, 16}, -1.f, 1.f);
+    auto* matmul_out = builder.MakeIntermediate();
+    auto* gemm_out = builder.MakeIntermediate();
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input, weight}, {matmul_out});
+
+    NodeAttributes gemm_attrs;
+    utils::SetNodeAttribute(utils::MakeAttribute("transB", static_cast<int64_t>(1)), gemm_attrs);
+    gemm_name = builder.AddNode("Gemm", {matmul_out, gemm_weight, gemm_bias}, {gemm_out}, "", &gemm_attrs).Name();
+
+    excluded_name = builder.AddNode("MatMul", {gemm_out, excluded_weight}, {output}).Name();
+  };
+
+  auto check_graph = [&](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["com.microsoft.MatMulNBits"], 2);
+    EXPECT_EQ(op_to_count["Gemm"], 0);
+    EXPECT_EQ(op_to_count["MatMul"], 1);
+
+    for (const auto& node : graph.Nodes()) {
+      if (node.OpType() != "MatMulNBits") {
+        continue;
+      }
+
+      const auto& attrs = node.GetAttributes();
+      EXPECT_EQ(attrs.at("bits").i(), 4);
+      EXPECT_EQ(attrs.at("block_size").i(), 16);
+      EXPECT_EQ(attrs.at("K").i(), node.InputDefs().size() > 5 ? 48 : 64);
+      // The Gemm bias is kept and its accuracy level is overridden.
+      EXPECT_EQ(attrs.at("accuracy_level").i(), node.InputDefs().size() > 5 ? 0 : 4);
+    }
+  };
+
+  auto add_session_options = [&](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+        kOrtSessionOptionsMatMulWeightQuantizationBits, "4"));
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+        kOrtSessionOptionsMatMulWeightQuantizationBlockSize, "16"));
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+        kOrtSessionOptionsMatMulWeightQuantizationExcludedNodes, excluded_name.c_str()));
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+        kOrtSessionOptionsMatMulWeightQuantizationNodeAccuracyLevels, (gemm_name + ":0").c_str()));
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    0.5, 0.1, nullptr, add_session_options);
+}
+
+// With 8 bits the weight is quantized per column to int8 and the MatMul becomes DynamicQuantizeMatMul.
+TEST(MatMulWeightQuantizationTests, Int8MatMul) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input = builder.MakeInput<float>({2, 3, 32}, -1.f, 1.f);
+    auto* weight = builder.MakeInitializer<float>({32, 24}, -1.f, 1.f);
+    auto* output = builder.MakeOutput();
+
+    builder.AddNode("MatMul", {input, weight}, {output});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    const Graph& graph = session.GetGraph();
+    auto op_to_count = CountOpsInGraph(graph);
+    EXPECT_EQ(op_to_count["com.microsoft.DynamicQuantizeMatMul"], 1);
+    EXPECT_EQ(op_to_count["MatMul"], 0);
+
+    const Node* node = FindNodeByOpType(graph, "DynamicQuantizeMatMul");
+    ASSERT_NE(node, nullptr);
+    const auto* weight = graph.GetConstantInitializer(node->InputDefs()[1]->Name(), true);
+    ASSERT_NE(weight, nullptr);
+    EXPECT_EQ(weight->data_type(), ONNX_NAMESPACE::TensorProto_DataType_INT8);
+  };
+
+  auto add_session_options = [](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+        kOrtSessionOptionsMatMulWeightQuantizationBits, "8"));
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Default, TransformerLevel::Level2, 13,
+                    0.05, 0.05, nullptr, add_session_options);
+}
+
+#endif  // DISABLE_CONTRIB_OPS
+
+}  // namespace test
+}  // namespace onnxruntime
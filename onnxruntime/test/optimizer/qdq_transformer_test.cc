@@ -2753,6 +2753,137 @@ TEST(QDQTransformerTests, Sigmoid_U8S8) {
   QDQTransformerSigmoidTests<uint8_t, int8_t>();
 }
 
+template <typename InputType, typename OutputType>
+void QDQTransformerGeluTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, bool use_ms_gelu, const std::string& approximate) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Gelu
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .0035f, 7);
+      auto* gelu_output = builder.MakeIntermediate();
+      if (use_ms_gelu) {
+        builder.AddNode("Gelu", {dq_output}, {gelu_output}, kMSDomain);
+      } else {
+        builder.AddNode("Gelu", {dq_output}, {gelu_output}).AddAttribute("approximate", approximate);
+      }
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(gelu_output, .0038f, std::numeric_limits<OutputType>::max() / 2,
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output, .0039f, std::numeric_limits<OutputType>::max() / 2,
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      const std::string gelu_key = use_ms_gelu ? "com.microsoft.Gelu" : "Gelu";
+      if constexpr (std::is_same<InputType, OutputType>::value) {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 1);
+        EXPECT_EQ(op_to_count[gelu_key], 0);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+      } else {
+        EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 0);
+        EXPECT_EQ(op_to_count[gelu_key], 1);
+        EXPECT_EQ(op_to_count["QuantizeLinear"], 2);
+        EXPECT_EQ(op_to_count["DequantizeLinear"], 2);
+      }
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      use_ms_gelu ? 18 : 20 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37}, true /*use_ms_gelu*/, "none");
+  test_case({1, 12, 37}, false /*use_ms_gelu*/, "none");
+  test_case({1, 23, 13, 13}, false /*use_ms_gelu*/, "tanh");
+}
+
+TEST(QDQTransformerTests, Gelu_S8S8) {
+  QDQTransformerGeluTests<int8_t, int8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8U8) {
+  QDQTransformerGeluTests<uint8_t, uint8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8S8) {
+  QDQTransformerGeluTests<uint8_t, int8_t>();
+}
+
+template <typename T>
+void QDQTransformerLayerNormalizationTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, bool has_bias, bool quantized_scale) {
+    const int64_t norm_size = input_shape.back();
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      const T zero_point = std::is_signed_v<T> ? T(0) : T(128);
+
+      // the scale and bias stay float, a quantized scale is dequantized by a DQ node that is kept
+      NodeArg* scale_arg = nullptr;
+      if (quantized_scale) {
+        auto* scale_weight = builder.MakeInitializer<uint8_t>({norm_size}, uint8_t(64), uint8_t(192));
+        scale_arg = builder.MakeIntermediate();
+        builder.AddDequantizeLinearNode<uint8_t>(scale_weight, .01f, uint8_t(0), scale_arg);
+      } else {
+        scale_arg = builder.MakeInitializer<float>({norm_size}, 0.5f, 1.5f);
+      }
+
+      std::vector<NodeArg*> layer_norm_inputs{AddQDQNodePair<T>(builder, input_arg, .008f, zero_point), scale_arg};
+      if (has_bias) {
+        layer_norm_inputs.push_back(builder.MakeInitializer<float>({norm_size}, -0.5f, 0.5f));
+      }
+
+      auto* layer_norm_output = builder.MakeIntermediate();
+      builder.AddNode("LayerNormalization", layer_norm_inputs, {layer_norm_output})
+          .AddAttribute("axis", static_cast<int64_t>(-1));
+
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<T>(layer_norm_output, .04f, zero_point, q_output);
+      builder.AddDequantizeLinearNode<T>(q_output, .04f, zero_point, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], 1);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], quantized_scale ? 2 : 1);
+    };
+
+    // a difference of one quantization step of the output is expected at rounding boundaries
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      17 /*opset_version*/,
+                      0.05 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37}, true /*has_bias*/, false /*quantized_scale*/);
+  test_case({2, 7, 64}, false /*has_bias*/, false /*quantized_scale*/);
+  test_case({1, 12, 37}, true /*has_bias*/, true /*quantized_scale*/);
+}
+
+TEST(QDQTransformerTests, LayerNormalization_S8) {
+  QDQTransformerLayerNormalizationTests<int8_t>();
+}
+
+TEST(QDQTransformerTests, LayerNormalization_U8) {
+  QDQTransformerLayerNormalizationTests<uint8_t>();
+}
+
 TEST(QDQTransformerTests, ConvTranspose_QBackward) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
                        const std::vector<int64_t>& perms, bool use_contrib_qdq) {
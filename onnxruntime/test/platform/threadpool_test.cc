@@ -229,6 +229,32 @@ void TestStagedMultiLoopSections(const std::string& name, int num_threads, int n
   }
 }
 
+// Test parallel sections and loops nested inside a parallel loop, as done by kernels running in concurrent
+// subgraph iterations. The inner section has no effect and the inner loops run in the calling thread.
+void TestNestedParallelSections(const std::string& name, int num_threads, int num_outer_tasks) {
+  for (int rep = 0; rep < 5; rep++) {
+    constexpr int num_inner_tasks = 64;
+    auto test_data = CreateTestData(num_outer_tasks * num_inner_tasks);
+    CreateThreadPoolAndTest(name, num_threads, [&](ThreadPool* tp) {
+      ThreadPool::TrySimpleParallelFor(tp,
+                                       num_outer_tasks,
+                                       [&](std::ptrdiff_t outer) {
+                                         ThreadPool::ParallelSection ps(tp);
+                                         for (int l = 0; l < 2; l++) {
+                                           const std::ptrdiff_t offset = outer * num_inner_tasks +
+                                                                         l * num_inner_tasks / 2;
+                                           ThreadPool::TrySimpleParallelFor(tp,
+                                                                            num_inner_tasks / 2,
+                                                                            [&](std::ptrdiff_t i) {
+                                                                              IncrementElement(*test_data, offset + i);
+                                                                            });
+                                         }
+                                       });
+    });
+    ValidateTestData(*test_data);
+  }
+}
+
 }  // namespace
 
 namespace onnxruntime {
@@ -510,6 +536,18 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestNestedParallelSections_0Thread_8Tasks) {
+  TestNestedParallelSections("TestNestedParallelSections_0Thread_8Tasks", 0, 8);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelSections_4Thread_1Task) {
+  TestNestedParallelSections("TestNestedParallelSections_4Thread_1Task", 4, 1);
+}
+
+TEST(ThreadPoolTest, TestNestedParallelSections_4Thread_8Tasks) {
+  TestNestedParallelSections("TestNestedParallelSections_4Thread_8Tasks", 4, 8);
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
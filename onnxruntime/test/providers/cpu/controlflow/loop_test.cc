@@ -1042,6 +1042,79 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// the loop carried variables are written into the buffers from two iterations earlier. check a buffer is not reused
+// while a subgraph output passed through from an input still refers to it.
+TEST(Loop, LoopCarriedVarBufferReuse) {
+  auto create_subgraph = []() {
+    Model model("LoopCarriedVarBufferReuse", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond, a, b, c. b_in is passed through as the next a.
+
+         a_in   b_in      c_in  b_in
+           |     |          |    |
+           [ Add ]          [ Add ]
+              |                |
+            b_out            c_out
+                               |
+                          [Identity]
+                               |
+                           c_scan_out
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_scalar;
+    float_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& a_in = graph.GetOrCreateNodeArg("a_in", &float_scalar);
+    auto& b_in = graph.GetOrCreateNodeArg("b_in", &float_scalar);
+    auto& c_in = graph.GetOrCreateNodeArg("c_in", &float_scalar);
+
+    auto& b_out = graph.GetOrCreateNodeArg("b_out", &float_scalar);
+    auto& c_out = graph.GetOrCreateNodeArg("c_out", &float_scalar);
+    auto& c_scan_out = graph.GetOrCreateNodeArg("c_scan_out", &float_scalar);
+
+    graph.AddNode("add_b", "Add", "Next Fibonacci number", {&a_in, &b_in}, {&b_out});
+    graph.AddNode("add_c", "Add", "Running sum", {&c_in, &b_in}, {&c_out});
+    graph.AddNode("c_identity", "Identity", "Scan output", {&c_out}, {&c_scan_out});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &a_in, &b_in, &c_in});
+    graph.SetOutputs({&cond_in, &b_in, &b_out, &c_out, &c_scan_out});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {5});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("a", {1}, {0.f});
+  test.AddInput<float>("b", {1}, {1.f});
+  test.AddInput<float>("c", {1}, {0.f});
+
+  test.AddOutput<float>("a_final", {1}, {5.f});
+  test.AddOutput<float>("b_final", {1}, {8.f});
+  test.AddOutput<float>("c_final", {1}, {12.f});
+  test.AddOutput<float>("c_scan", {5, 1}, {1.f, 2.f, 4.f, 7.f, 12.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 // test that when part of the subgraph run on CUDA/ROCm it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -907,6 +907,131 @@ TEST(Scan9, TransposeOutputDim2) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
 }
 
+TEST(Scan9, IndependentIterations) {
+  // Construct scan body subgraph with 1 scan input, 2 scan outputs and no loop state variables
+  // so that the iterations can run concurrently.
+  // scan-in-1 * scan-in-1 => scan-out-1
+  // scan-in-1 => scan-out-2 (written in reverse)
+  Model model("ScanBody", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+  // use a symbolic dimension for one output so the first iteration needs to allocate the final output
+  TypeProto symbolic_float_tensor;
+  symbolic_float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  symbolic_float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_param("n");
+
+  auto& scan_in_1 = graph.GetOrCreateNodeArg("scan_in_1", &float_tensor);
+  auto& scan_out_1 = graph.GetOrCreateNodeArg("scan_out_1", &symbolic_float_tensor);
+  auto& scan_out_2 = graph.GetOrCreateNodeArg("scan_out_2", &float_tensor);
+
+  graph.AddNode("square", "Mul", "Square scan_in_1", {&scan_in_1, &scan_in_1}, {&scan_out_1});
+  graph.AddNode("pass_through", "Identity", "Copy scan_in_1 to scan_out_2", {&scan_in_1}, {&scan_out_2});
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  auto& scan_body = graph.ToGraphProto();
+
+  ScanOpTester test{9};
+
+  constexpr int64_t sequence_len = 16;
+  std::vector<float> input(sequence_len * 2);
+  std::vector<float> output_1(input.size());
+  std::vector<float> output_2(input.size());
+  for (int64_t i = 0; i < sequence_len; ++i) {
+    for (int64_t j = 0; j < 2; ++j) {
+      const float value = static_cast<float>(i * 2 + j);
+      input[i * 2 + j] = value;
+      output_1[i * 2 + j] = value * value;
+      output_2[(sequence_len - 1 - i) * 2 + j] = value;
+    }
+  }
+
+  test.AddAttribute("body", scan_body);
+  test.AddAttribute<int64_t>("num_scan_inputs", 1);
+  test.AddAttribute<std::vector<int64_t>>("scan_output_directions", {0, 1});
+
+  test.AddInput<float>("scan_input_1", {sequence_len, 2}, input);
+  test.AddOutput<float>("scan_output_1", {sequence_len, 2}, output_1);
+  test.AddOutput<float>("scan_output_2", {sequence_len, 2}, output_2);
+
+  // the iterations are only run concurrently if the thread pool has more than one thread
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
+}
+
+TEST(Scan9, IndependentIterationsWithParallelSectionInBody) {
+  // Construct scan body subgraph with a GRU node. The GRU kernel opens a thread pool parallel section inside the
+  // parallel loop over the iterations. The nested section has no effect and the GRU runs in the calling thread.
+  // GRU(scan-in-1, W, R) => scan-out-1
+  Model model("ScanBody", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor;
+  float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+  float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  auto add_weights = [&graph](const std::string& name, const std::vector<float>& values) -> NodeArg& {
+    TensorProto weights;
+    weights.set_name(name);
+    weights.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+    weights.add_dims(1);
+    weights.add_dims(static_cast<int64_t>(values.size()));
+    weights.add_dims(1);
+    for (float value : values) {
+      weights.add_float_data(value);
+    }
+
+    graph.AddInitializedTensor(weights);
+    return graph.GetOrCreateNodeArg(name, nullptr);
+  };
+
+  // gate order is z, r, h with a hidden size of 1
+  constexpr float wz = 0.1f, wr = 0.2f, wh = 0.3f;
+  auto& w = add_weights("W", {wz, wr, wh});
+  auto& r = add_weights("R", {0.4f, 0.5f, 0.6f});
+
+  auto& scan_in_1 = graph.GetOrCreateNodeArg("scan_in_1", &float_tensor);
+  auto& y = graph.GetOrCreateNodeArg("y", nullptr);
+
+  auto& gru = graph.AddNode("gru", "GRU", "GRU over a single step", {&scan_in_1, &w, &r}, {&y});
+  gru.AddAttribute("hidden_size", static_cast<int64_t>(1));
+
+  auto status = graph.Resolve();
+  EXPECT_EQ(status, Status::OK());
+
+  auto& scan_body = graph.ToGraphProto();
+
+  ScanOpTester test{9};
+
+  // with a zero initial hidden state each step produces (1 - sigmoid(wz * x)) * tanh(wh * x)
+  constexpr int64_t sequence_len = 16;
+  std::vector<float> input(sequence_len);
+  std::vector<float> output(sequence_len);
+  for (int64_t i = 0; i < sequence_len; ++i) {
+    const float x = static_cast<float>(i) * 0.25f - 2.f;
+    input[i] = x;
+    output[i] = (1.f - 1.f / (1.f + std::exp(-wz * x))) * std::tanh(wh * x);
+  }
+
+  test.AddAttribute("body", scan_body);
+  test.AddAttribute<int64_t>("num_scan_inputs", 1);
+
+  test.AddInput<float>("scan_input_1", {sequence_len, 1, 1, 1}, input);
+  test.AddOutput<float>("scan_output_1", {sequence_len, 1, 1, 1, 1}, output);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", RunOptions().excluded_provider_types);
+}
+
 static void InvalidInput(bool is_v8) {
   constexpr int64_t batch_size = 1;
   constexpr int64_t sequence_len = 2;
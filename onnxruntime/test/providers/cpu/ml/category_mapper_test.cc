@@ -8,7 +8,8 @@ namespace onnxruntime {
 namespace test {
 
 template <typename TInput, typename TOutput>
-static void RunTest(const std::vector<int64_t>& dims, const std::vector<TInput>& input, const std::vector<TOutput>& output) {
+static void RunTest(const std::vector<int64_t>& dims, const std::vector<TInput>& input, const std::vector<TOutput>& output,
+                    int intra_op_num_threads = 0) {
   OpTester test("CategoryMapper", 1, onnxruntime::kMLDomain);
 
   static const std::vector<std::string> categories = {"Three", "Two", "One"};
@@ -23,7 +24,13 @@ static void RunTest(const std::vector<int64_t>& dims, const std::vector<TInput>&
   test.AddInput<TInput>("X", dims, input);
   test.AddOutput<TOutput>("Y", dims, output);
 
-  test.Run();
+  if (intra_op_num_threads > 0) {
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = intra_op_num_threads;
+    test.Run(so);
+  } else {
+    test.Run();
+  }
 }
 
 TEST(CategoryMapper, StringToInt) {
@@ -43,5 +50,20 @@ TEST(CategoryMapper, IntToString) {
 
   RunTest(dims, input, output);
 }
+
+TEST(CategoryMapper, StringToIntLargeInput) {
+  static const std::vector<std::string> words = {"Unknown", "Two", "Three", "B", "One", "one"};
+  static const std::vector<int64_t> indexes = {99, 2, 3, 99, 1, 99};
+
+  constexpr int64_t size = 20000;
+  std::vector<std::string> input(size);
+  std::vector<int64_t> output(size);
+  for (size_t i = 0; i < input.size(); ++i) {
+    input[i] = words[i % words.size()];
+    output[i] = indexes[i % indexes.size()];
+  }
+
+  RunTest(std::vector<int64_t>{size}, input, output, /*intra_op_num_threads*/ 4);
+}
 }  // namespace test
 }  // namespace onnxruntime
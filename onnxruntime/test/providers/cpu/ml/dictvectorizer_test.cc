@@ -42,5 +42,22 @@ TEST(MLOpTest, DictVectorizerInt64Input) {
   test.Run();
 }
 
+TEST(MLOpTest, DictVectorizerDuplicatedVocabulary) {
+  OpTester test("DictVectorizer", 1, onnxruntime::kMLDomain);
+
+  test.AddAttribute("string_vocabulary", std::vector<std::string>{"a", "b", "a", "c", "b"});
+
+  std::map<std::string, float> map;
+  map["a"] = 1.f;
+  map["b"] = 2.f;
+  map["e"] = 5.f;
+
+  test.AddInput<std::string, float>("X", map);
+
+  std::vector<int64_t> dims{1, 5};
+  test.AddOutput<float>("Y", dims, {1.f, 2.f, 1.f, 0.f, 2.f});
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
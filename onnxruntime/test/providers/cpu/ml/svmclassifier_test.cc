@@ -263,5 +263,71 @@ TEST(MLOpTest, SVMClassifierLinear) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMClassifierLinearAndPolyManyRows) {
+  std::vector<float> coefficients = {0.766398549079895f, 0.0871576070785522f, 0.110420741140842f,
+                                     -0.963976919651031f};
+  std::vector<float> support_vectors = {4.80000019073486f, 3.40000009536743f, 1.89999997615814f,
+                                        5.f, 3.f, 1.60000002384186f,
+                                        4.5f, 2.29999995231628f, 1.29999995231628f,
+                                        5.09999990463257f, 2.5f, 3.f};
+  std::vector<float> rho = {2.23510527610779f};
+  std::vector<int64_t> classes = {0, 1};
+  std::vector<int64_t> vectors_per_class = {3, 1};
+
+  std::vector<float> X_rows = {5.1f, 3.5f, 1.4f,
+                               4.9f, 3.f, 1.4f,
+                               4.7f, 3.2f, 1.3f,
+                               4.6f, 3.1f, 1.5f,
+                               5.f, 3.6f, 1.4f};
+
+  struct KernelCase {
+    std::string kernel_type;
+    std::vector<float> kernel_params;  // gamma, coef0, degree
+    std::vector<float> scores;         // one score per row of X_rows
+  };
+
+  const std::vector<KernelCase> kernel_cases = {
+      {"LINEAR", {0.122462183237076f, 0.f, 3.f}, {1.5556809f, 1.2610317f, 1.5795374f, 1.3083459f, 1.6572950f}},
+      {"POLY", {0.122462183237076f, 1.f, 3.f}, {-5.0315472f, -7.6114143f, -3.9344184f, -6.6663150f, -3.7246568f}},
+  };
+
+  // the support vectors are packed for SGEMM for both kernels, and the rows are split across the threads
+  constexpr int64_t repeats = 200;
+  const int64_t num_rows = 5 * repeats;
+
+  for (const auto& kernel_case : kernel_cases) {
+    OpTester test("SVMClassifier", 1, onnxruntime::kMLDomain);
+
+    std::vector<float> X;
+    std::vector<int64_t> class_predictions;
+    std::vector<float> scores_predictions;
+    for (int64_t i = 0; i < repeats; ++i) {
+      X.insert(X.end(), X_rows.begin(), X_rows.end());
+      for (float score : kernel_case.scores) {
+        class_predictions.push_back(score > 0 ? 0 : 1);
+        scores_predictions.push_back(-score);
+        scores_predictions.push_back(score);
+      }
+    }
+
+    test.AddAttribute("kernel_type", kernel_case.kernel_type);
+    test.AddAttribute("coefficients", coefficients);
+    test.AddAttribute("support_vectors", support_vectors);
+    test.AddAttribute("vectors_per_class", vectors_per_class);
+    test.AddAttribute("rho", rho);
+    test.AddAttribute("kernel_params", kernel_case.kernel_params);
+    test.AddAttribute("classlabels_ints", classes);
+
+    test.AddInput<float>("X", {num_rows, 3}, X);
+    test.AddOutput<int64_t>("Y", {num_rows}, class_predictions);
+    test.AddOutput<float>("Z", {num_rows, 2}, scores_predictions);
+    test.SetOutputRelErr("Z", 0.0001f);
+
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = 4;
+    test.Run(so);
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
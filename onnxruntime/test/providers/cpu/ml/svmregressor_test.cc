@@ -32,6 +32,40 @@ TEST(MLOpTest, SVMRegressorSVC) {
   test.Run();
 }
 
+TEST(MLOpTest, SVMRegressorSVCManyRows) {
+  OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
+
+  std::vector<float> dual_coefficients = {-1.54236563f, 0.53485162f, -1.5170623f, 0.69771864f, 1.82685767f};
+  std::vector<float> support_vectors = {0.f, 0.5f, 32.f, 1.f, 1.5f, 1.f, 2.f, 2.9f, -32.f, 12.f, 12.9f, -312.f, 43.f, 413.3f, -114.f};
+  std::vector<float> rho = {1.96292297f};
+  std::vector<float> kernel_params = {0.001f, 0.f, 3.f};  // gamma, coef0, degree
+
+  std::vector<float> X_rows = {1.f, 0.0f, 0.4f, 3.0f, 44.0f, -3.f, 12.0f, 12.9f, -312.f, 23.0f, 11.3f, -222.f, 23.0f, 11.3f, -222.f, 23.0f, 3311.3f, -222.f, 23.0f, 11.3f, -222.f, 43.0f, 413.3f, -114.f};
+  std::vector<float> predictions_rows = {1.40283655f, 1.86065906f, 2.66064161f, 1.96311014f, 1.96311014f, 1.96292297f, 1.96311014f, 3.78978065f};
+
+  constexpr int64_t repeats = 256;
+  std::vector<float> X;
+  std::vector<float> predictions;
+  for (int64_t i = 0; i < repeats; ++i) {
+    X.insert(X.end(), X_rows.begin(), X_rows.end());
+    predictions.insert(predictions.end(), predictions_rows.begin(), predictions_rows.end());
+  }
+
+  test.AddAttribute("kernel_type", std::string("RBF"));
+  test.AddAttribute("coefficients", dual_coefficients);
+  test.AddAttribute("support_vectors", support_vectors);
+  test.AddAttribute("rho", rho);
+  test.AddAttribute("kernel_params", kernel_params);
+  test.AddAttribute("n_supports", static_cast<int64_t>(5));
+
+  test.AddInput<float>("X", {8 * repeats, 3}, X);
+  test.AddOutput<float>("Y", {8 * repeats, 1}, predictions);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Run(so);
+}
+
 TEST(MLOpTest, SVMRegressorNuSVC) {
   OpTester test("SVMRegressor", 1, onnxruntime::kMLDomain);
 
@@ -689,6 +689,36 @@ TEST(TfIdfVectorizerTest, String_TFIDFWeights_onlyBigrams_Skip5_2rows) {
   test.Run(OpTester::ExpectResult::kExpectSuccess);
 }
 
+// A single long row is split across threads by n-gram start position.
+TEST(TfIdfVectorizerTest, Int64_TF_UniAndBigrams_LongRow) {
+  OpTester test("TfIdfVectorizer", opset_ver);
+  // s=0, Min=1, Max=2, weights empty, int64
+  InitTestAttr(test, "TF", 1, 2, 0,
+               {0, 2},
+               {0, 1, 2},  // 3 output indexes
+               {},
+               {1, 2,   // 1-grams
+                1, 2},  // bi-grams
+               {});
+
+  constexpr int64_t repeats = 3000;
+  std::vector<int64_t> dims{repeats * 3};
+  std::vector<int64_t> input;
+  input.reserve(repeats * 3);
+  for (int64_t i = 0; i < repeats; ++i) {
+    input.insert(input.end(), {1, 2, 3});
+  }
+  test.AddInput<int64_t>("T", dims, input);
+
+  std::vector<int64_t> out_dims{3};
+  std::vector<float> output = {static_cast<float>(repeats), static_cast<float>(repeats), static_cast<float>(repeats)};
+  test.AddOutput<float>("Y", out_dims, output);
+
+  SessionOptions so;
+  so.intra_op_param.thread_pool_size = 4;
+  test.Run(so, OpTester::ExpectResult::kExpectSuccess);
+}
+
 // This test runs the inference 100 times to test the improvement
 // It enables profiling while running inference multiple times.
 // So we can manually inspect the profiling output
@@ -154,6 +154,94 @@ TEST(NonMaxSuppressionOpTest, TwoBatches_TwoClasses) {
   test.Run();
 }
 
+// Enough classes for the (batch, class) pairs to be split across threads. The output must still be ordered by class.
+TEST(NonMaxSuppressionOpTest, ManyClasses) {
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {1, 6, 4},
+                       {0.0f, 0.0f, 1.0f, 1.0f,
+                        0.0f, 0.1f, 1.0f, 1.1f,
+                        0.0f, -0.1f, 1.0f, 0.9f,
+                        0.0f, 10.0f, 1.0f, 11.0f,
+                        0.0f, 10.1f, 1.0f, 11.1f,
+                        0.0f, 100.0f, 1.0f, 101.0f});
+  test.AddInput<float>("scores", {1, 16, 6},
+                       {0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f,
+                        0.9f, 0.75f, 0.6f, 0.95f, 0.5f, 0.3f,
+                        0.3f, 0.5f, 0.95f, 0.6f, 0.75f, 0.9f});
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {3L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+#ifdef USE_TENSORRT
+  bool sort_output = true;
+#else
+  bool sort_output = false;  // default
+#endif
+  test.AddOutput<int64_t>("selected_indices", {48, 3},
+                          {0L, 0L, 3L,
+                           0L, 0L, 0L,
+                           0L, 0L, 5L,
+                           0L, 1L, 2L,
+                           0L, 1L, 5L,
+                           0L, 1L, 4L,
+                           0L, 2L, 3L,
+                           0L, 2L, 0L,
+                           0L, 2L, 5L,
+                           0L, 3L, 2L,
+                           0L, 3L, 5L,
+                           0L, 3L, 4L,
+                           0L, 4L, 3L,
+                           0L, 4L, 0L,
+                           0L, 4L, 5L,
+                           0L, 5L, 2L,
+                           0L, 5L, 5L,
+                           0L, 5L, 4L,
+                           0L, 6L, 3L,
+                           0L, 6L, 0L,
+                           0L, 6L, 5L,
+                           0L, 7L, 2L,
+                           0L, 7L, 5L,
+                           0L, 7L, 4L,
+                           0L, 8L, 3L,
+                           0L, 8L, 0L,
+                           0L, 8L, 5L,
+                           0L, 9L, 2L,
+                           0L, 9L, 5L,
+                           0L, 9L, 4L,
+                           0L, 10L, 3L,
+                           0L, 10L, 0L,
+                           0L, 10L, 5L,
+                           0L, 11L, 2L,
+                           0L, 11L, 5L,
+                           0L, 11L, 4L,
+                           0L, 12L, 3L,
+                           0L, 12L, 0L,
+                           0L, 12L, 5L,
+                           0L, 13L, 2L,
+                           0L, 13L, 5L,
+                           0L, 13L, 4L,
+                           0L, 14L, 3L,
+                           0L, 14L, 0L,
+                           0L, 14L, 5L,
+                           0L, 15L, 2L,
+                           0L, 15L, 5L,
+                           0L, 15L, 4L},
+                          sort_output);
+  test.Run();
+}
+
 TEST(NonMaxSuppressionOpTest, WithScoreThreshold) {
   OpTester test("NonMaxSuppression", 10, kOnnxDomain);
   test.AddInput<float>("boxes", {1, 6, 4},
@@ -6,6 +6,7 @@
 #include <iterator>
 #include <vector>
 
+#include "core/framework/session_options.h"
 #include "core/providers/cpu/rnn/deep_cpu_gru.h"
 #include "test/providers/provider_test_utils.h"
 #include "test/util/include/default_providers.h"
@@ -34,7 +35,8 @@ static void RunGruTest(const std::vector<float>& X_data,
                        // copy the following vectors as we may modify them
                        std::vector<string> activations = default_activations,
                        std::vector<float> activation_alphas = {},
-                       std::vector<float> activation_betas = {}) {
+                       std::vector<float> activation_betas = {},
+                       int intra_op_num_threads = 0) {
   OpTester test("GRU");
 
   test.AddShapeToTensorData();
@@ -100,16 +102,25 @@ static void RunGruTest(const std::vector<float>& X_data,
 
 // TensorRT, OpenVINO failed on GRU tests
 #if defined(USE_OPENVINO)
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider, kOpenVINOExecutionProvider});
+  std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider, kOpenVINOExecutionProvider};
 #else
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  std::unordered_set<std::string> excluded_providers{kTensorrtExecutionProvider};
 #endif
+  if (intra_op_num_threads > 0) {
+    // use a session thread pool of the given size instead of the shared test one
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = intra_op_num_threads;
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+  } else {
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", excluded_providers);
+  }
 }
 
 void DefaultActivationsSimpleWeightsNoBias(std::string direction,
                                            const std::vector<float>& Y_data,
                                            const std::vector<float>& Y_h_data,
-                                           bool linear_before_reset = false) {
+                                           bool linear_before_reset = false,
+                                           int intra_op_num_threads = 0) {
   int64_t seq_length = 2;
   int batch_size = linear_before_reset ? 3 : 2;  // extra row to validate usage of linear_output_
   int64_t input_size = 1;
@@ -140,13 +151,15 @@ void DefaultActivationsSimpleWeightsNoBias(std::string direction,
   std::vector<float> R_data(num_directions * 3 * hidden_size * hidden_size, 0.1f);
 
   RunGruTest(X_data, W_data, R_data, Y_data, Y_h_data, input_size, batch_size, hidden_size, seq_length,
-             nullptr, nullptr, nullptr, direction, 9999.0, true, linear_before_reset);
+             nullptr, nullptr, nullptr, direction, 9999.0, true, linear_before_reset,
+             default_activations, {}, {}, intra_op_num_threads);
 
   // if Y_h_data is empty that tests Y_h not being returned. we need to have at least one output or
   // the node will get removed, so only test with output_sequence == false (no Y as output) if Y_h is not optional
   if (!Y_h_data.empty())
     RunGruTest(X_data, W_data, R_data, Y_data, Y_h_data, input_size, batch_size, hidden_size, seq_length,
-               nullptr, nullptr, nullptr, direction, 9999.0, /* output_sequence*/ false, linear_before_reset);
+               nullptr, nullptr, nullptr, direction, 9999.0, /* output_sequence*/ false, linear_before_reset,
+               default_activations, {}, {}, intra_op_num_threads);
 }
 
 TEST(GRUTest, ForwardDefaultActivationsSimpleWeightsNoBiasTwoRows) {
@@ -210,6 +223,9 @@ TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBias) {
       0.5803454f, 0.4527356f, 0.36886263f};
 
   DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data);
+
+  // with more than one thread the two directions run concurrently
+  DefaultActivationsSimpleWeightsNoBias("bidirectional", Y_data, Y_h_data, false, /*intra_op_num_threads*/ 2);
 }
 
 TEST(GRUTest, BidirectionalDefaultActivationsSimpleWeightsNoBiasLinearBeforeReset) {
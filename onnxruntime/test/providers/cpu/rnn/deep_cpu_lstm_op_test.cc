@@ -6,6 +6,7 @@
 #include <iterator>
 #include <vector>
 
+#include "core/framework/session_options.h"
 #include "core/providers/cpu/rnn/deep_cpu_lstm.h"
 #include "test/providers/provider_test_utils.h"
 #include "default_providers.h"
@@ -50,7 +51,8 @@ static void RunLstmTest(const std::vector<float>& X_data,
                         std::vector<string> activations = {},
                         std::vector<float> activation_alphas = {},
                         std::vector<float> activation_betas = {},
-                        bool hasClip = true) {
+                        bool hasClip = true,
+                        int intra_op_num_threads = 0) {
   OpTester test("LSTM");
 
   int num_directions = (direction == "bidirectional") ? 2 : 1;
@@ -146,7 +148,14 @@ static void RunLstmTest(const std::vector<float>& X_data,
   test.SetOutputTolerance(0.0001f);
 
   // TensorRT failed on LSTM tests
-  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  if (intra_op_num_threads > 0) {
+    // use a session thread pool of the given size instead of the shared test one
+    SessionOptions so;
+    so.intra_op_param.thread_pool_size = intra_op_num_threads;
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  } else {
+    test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+  }
 }
 
 void SimpleWeightsNoBiasTwoRows(std::string direction,
@@ -374,6 +383,161 @@ TEST(LSTMTest, MixedSequenceLengthsReverse) {
   SimpleWeightsNoBiasTwoRows("reverse", Y_data, Y_h_data, Y_c_data, &seq_lengths);
 }
 
+// Bidirectional with bias and sequence lengths in decreasing order, so the rows finishing early are at the end of
+// the batch. Expected values were computed with a reference implementation of the ONNX LSTM spec.
+TEST(LSTMTest, BidirectionalDecreasingSequenceLengthsWithBias) {
+  // TODO: Unskip when fixed #41968513
+  if (DefaultDmlExecutionProvider().get() != nullptr) {
+    GTEST_SKIP() << "Skipping because of the following error: MLOperatorAuthorImpl.cpp(1817): The parameter is incorrect.";
+  }
+
+  int64_t seq_length = 3;
+  int batch_size = 3;
+  int64_t input_size = 2;
+  int64_t hidden_size = 3;
+
+  std::vector<float> X_data{0.1f, 0.2f, 0.3f, -0.4f, 0.5f, 0.6f,
+                            -0.7f, 0.8f, 0.9f, -1.0f, 1.1f, 1.2f,
+                            1.3f, -0.1f, 0.2f, 0.3f, -0.4f, 0.5f};
+
+  std::vector<float> W_data{
+      -0.3f, -0.25f, -0.2f, -0.15f, -0.1f, -0.05f, 0.f, 0.05f, 0.1f, 0.15f, 0.2f, 0.25f,
+      0.3f, 0.35f, 0.4f, 0.45f, 0.5f, 0.55f, 0.6f, 0.65f, 0.7f, 0.75f, 0.8f, 0.85f,
+
+      0.3f, 0.25f, 0.2f, 0.15f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f, -0.15f, -0.2f, -0.25f,
+      -0.3f, -0.35f, -0.4f, -0.45f, -0.5f, -0.55f, -0.6f, -0.65f, -0.7f, -0.75f, -0.8f, -0.85f};
+
+  std::vector<float> R_data{
+      -0.1f, -0.06f, -0.02f, 0.02f, 0.06f, 0.1f, 0.14f, -0.1f, -0.06f, -0.02f, 0.02f, 0.06f,
+      0.1f, 0.14f, -0.1f, -0.06f, -0.02f, 0.02f, 0.06f, 0.1f, 0.14f, -0.1f, -0.06f, -0.02f,
+      0.02f, 0.06f, 0.1f, 0.14f, -0.1f, -0.06f, -0.02f, 0.02f, 0.06f, 0.1f, 0.14f, -0.1f,
+
+      -0.03f, -0.01f, 0.01f, 0.03f, 0.05f, 0.07f, 0.09f, -0.03f, -0.01f, 0.01f, 0.03f, 0.05f,
+      0.07f, 0.09f, -0.03f, -0.01f, 0.01f, 0.03f, 0.05f, 0.07f, 0.09f, -0.03f, -0.01f, 0.01f,
+      0.03f, 0.05f, 0.07f, 0.09f, -0.03f, -0.01f, 0.01f, 0.03f, 0.05f, 0.07f, 0.09f, -0.03f};
+
+  std::vector<float> B_data{
+      -0.1f, -0.05f, 0.f, 0.05f, 0.1f, -0.1f, -0.05f, 0.f, 0.05f, 0.1f, -0.1f, -0.05f,
+      0.f, 0.05f, 0.1f, -0.1f, -0.05f, 0.f, 0.05f, 0.1f, -0.1f, -0.05f, 0.f, 0.05f,
+
+      0.05f, 0.f, -0.05f, -0.1f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f, 0.1f, 0.05f, 0.f,
+      -0.05f, -0.1f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f};
+
+  std::vector<int> seq_lengths{3, 2, 1};
+
+  std::vector<float> Y_data{
+      0.052317718f, 0.030385327f, 0.062385536f,
+      -0.0069095892f, -0.047267141f, -0.024195985f,
+      0.12238977f, 0.14610978f, 0.18750027f,
+
+      -0.054363823f, -0.11315146f, -0.14827111f,
+      0.069234084f, 0.03942582f, 0.0056739052f,
+      -0.1417611f, -0.16349733f, -0.16923907f,
+
+      0.062901393f, 0.020155277f, 0.063527918f,
+      -0.015473934f, -0.076150906f, -0.042564663f,
+      0.f, 0.f, 0.f,
+
+      -0.069779798f, -0.11885773f, -0.14724992f,
+      0.052069559f, 0.031077947f, 0.0081083687f,
+      0.f, 0.f, 0.f,
+
+      0.15197636f, 0.15859653f, 0.22505823f,
+      0.f, 0.f, 0.f,
+      0.f, 0.f, 0.f,
+
+      -0.15270382f, -0.17405887f, -0.17750565f,
+      0.f, 0.f, 0.f,
+      0.f, 0.f, 0.f};
+
+  std::vector<float> Y_h_data{
+      0.15197636f, 0.15859653f, 0.22505823f,
+      -0.015473934f, -0.076150906f, -0.042564663f,
+      0.12238977f, 0.14610978f, 0.18750027f,
+
+      -0.054363823f, -0.11315146f, -0.14827111f,
+      0.069234084f, 0.03942582f, 0.0056739052f,
+      -0.1417611f, -0.16349733f, -0.16923907f};
+
+  std::vector<float> Y_c_data{
+      0.32283878f, 0.30151565f, 0.45044847f,
+      -0.032625521f, -0.15466568f, -0.093241867f,
+      0.25248372f, 0.27356247f, 0.36417167f,
+
+      -0.11324599f, -0.22461243f, -0.31841774f,
+      0.14137868f, 0.073966117f, 0.011125611f,
+      -0.30439457f, -0.34694914f, -0.40773328f};
+
+  RunLstmTest(X_data, W_data, false, R_data, false, Y_data, Y_h_data, Y_c_data,
+              input_size, batch_size, hidden_size, seq_length,
+              &B_data, nullptr, nullptr, nullptr, &seq_lengths, "bidirectional");
+}
+
+// A single row is not batch parallel, so with more than one thread the forward and reverse directions run
+// concurrently. Expected values were computed with a reference implementation of the ONNX LSTM spec.
+TEST(LSTMTest, BidirectionalSingleRowConcurrentDirections) {
+  // TODO: Unskip when fixed #41968513
+  if (DefaultDmlExecutionProvider().get() != nullptr) {
+    GTEST_SKIP() << "Skipping because of the following error: MLOperatorAuthorImpl.cpp(1817): The parameter is incorrect.";
+  }
+
+  int64_t seq_length = 4;
+  int batch_size = 1;
+  int64_t input_size = 2;
+  int64_t hidden_size = 3;
+
+  std::vector<float> X_data{0.1f, 0.2f, -0.4f, 0.5f, 0.9f, -1.0f, 1.3f, -0.1f};
+
+  std::vector<float> W_data{
+      -0.3f, -0.25f, -0.2f, -0.15f, -0.1f, -0.05f, 0.f, 0.05f, 0.1f, 0.15f, 0.2f, 0.25f,
+      0.3f, 0.35f, 0.4f, 0.45f, 0.5f, 0.55f, 0.6f, 0.65f, 0.7f, 0.75f, 0.8f, 0.85f,
+
+      0.3f, 0.25f, 0.2f, 0.15f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f, -0.15f, -0.2f, -0.25f,
+      -0.3f, -0.35f, -0.4f, -0.45f, -0.5f, -0.55f, -0.6f, -0.65f, -0.7f, -0.75f, -0.8f, -0.85f};
+
+  std::vector<float> R_data{
+      -0.1f, -0.06f, -0.02f, 0.02f, 0.06f, 0.1f, 0.14f, -0.1f, -0.06f, -0.02f, 0.02f, 0.06f,
+      0.1f, 0.14f, -0.1f, -0.06f, -0.02f, 0.02f, 0.06f, 0.1f, 0.14f, -0.1f, -0.06f, -0.02f,
+      0.02f, 0.06f, 0.1f, 0.14f, -0.1f, -0.06f, -0.02f, 0.02f, 0.06f, 0.1f, 0.14f, -0.1f,
+
+      -0.03f, -0.01f, 0.01f, 0.03f, 0.05f, 0.07f, 0.09f, -0.03f, -0.01f, 0.01f, 0.03f, 0.05f,
+      0.07f, 0.09f, -0.03f, -0.01f, 0.01f, 0.03f, 0.05f, 0.07f, 0.09f, -0.03f, -0.01f, 0.01f,
+      0.03f, 0.05f, 0.07f, 0.09f, -0.03f, -0.01f, 0.01f, 0.03f, 0.05f, 0.07f, 0.09f, -0.03f};
+
+  std::vector<float> B_data{
+      -0.1f, -0.05f, 0.f, 0.05f, 0.1f, -0.1f, -0.05f, 0.f, 0.05f, 0.1f, -0.1f, -0.05f,
+      0.f, 0.05f, 0.1f, -0.1f, -0.05f, 0.f, 0.05f, 0.1f, -0.1f, -0.05f, 0.f, 0.05f,
+
+      0.05f, 0.f, -0.05f, -0.1f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f, 0.1f, 0.05f, 0.f,
+      -0.05f, -0.1f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f, 0.1f, 0.05f, 0.f, -0.05f, -0.1f};
+
+  std::vector<float> Y_data{
+      0.052317718f, 0.030385327f, 0.062385536f,
+      -0.025777979f, -0.084747825f, -0.12541045f,
+
+      0.058582983f, 0.015934694f, 0.058853f,
+      -0.008362799f, -0.062090515f, -0.098132653f,
+
+      0.01469819f, -0.044962868f, -0.004102368f,
+      -0.027570997f, -0.077958848f, -0.10728757f,
+
+      0.12733731f, 0.1149368f, 0.18469521f,
+      -0.15270382f, -0.17405887f, -0.17750565f};
+
+  std::vector<float> Y_h_data{
+      0.12733731f, 0.1149368f, 0.18469521f,
+      -0.025777979f, -0.084747825f, -0.12541045f};
+
+  std::vector<float> Y_c_data{
+      0.26832776f, 0.21612557f, 0.36097981f,
+      -0.053388872f, -0.16633574f, -0.26651948f};
+
+  RunLstmTest(X_data, W_data, false, R_data, false, Y_data, Y_h_data, Y_c_data,
+              input_size, batch_size, hidden_size, seq_length,
+              &B_data, nullptr, nullptr, nullptr, nullptr, "bidirectional", 9999.f, true, false, {}, {}, {}, true,
+              /*intra_op_num_threads*/ 2);
+}
+
 // test path in LSTM model where batch_parallel_ is false and there are multiple steps (seq_length > 1)
 TEST(LSTMTest, BatchParallelFalseSeqLengthGreaterThanOne) {
   // TODO: Unskip when fixed #41968513
@@ -1565,6 +1565,43 @@ TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_MultiChannel) {
   test.AddOutput<float>("Y", {N, C, sizes[2], sizes[3]}, Y);
   test.Run();
 }
+
+TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_uint8) {
+  OpTester test("Resize", 13);
+  std::vector<float> scales{1.0f, 1.0f, 2.0f, 2.0f};
+  std::vector<float> roi{};
+
+  test.AddAttribute("mode", "cubic");
+  test.AddAttribute("coordinate_transformation_mode", "asymmetric");
+
+  constexpr int64_t N = 1, C = 1, H = 4, W = 4;
+  std::vector<uint8_t> X = {
+      0, 40, 200, 90,
+      255, 130, 20, 75,
+      60, 250, 5, 180,
+      110, 15, 240, 35};
+
+  test.AddInput<uint8_t>("X", {N, C, H, W}, X);
+  test.AddInput<float>("roi", {0}, roi);
+  test.AddInput<float>("scales", {4}, scales);
+
+  // the cubic overshoot is rounded and saturated to the uint8 range
+  std::vector<uint8_t> Y = {0, 5, 40, 134, 200, 160, 90, 80,
+                            146, 106, 74, 89, 111, 96, 73, 69,
+                            255, 203, 130, 58, 20, 37, 75, 80,
+                            177, 222, 220, 86, 0, 33, 140, 155,
+                            60, 178, 250, 129, 5, 70, 180, 196,
+                            67, 107, 144, 140, 121, 117, 117, 117,
+                            110, 41, 15, 138, 240, 159, 35, 16,
+                            115, 29, 0, 139, 255, 167, 21, 0};
+
+  test.AddOutput<uint8_t>("Y", {N, C, static_cast<int64_t>(H * scales[2]), static_cast<int64_t>(W * scales[3])}, Y);
+  // CUDA/ROCm/DML/TensorRT: no rounding/saturation of integer cubic results
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "",
+           {kCudaExecutionProvider, kCudaNHWCExecutionProvider, kRocmExecutionProvider, kDmlExecutionProvider,
+            kTensorrtExecutionProvider, kWebGpuExecutionProvider, kOpenVINOExecutionProvider});
+}
+
 TEST(ResizeOpTest, ResizeOpCubicUpSampleTest_tf_half_pixel_for_nn) {
   // tf_half_pixel_for_nn has been deprecated since opset 13
   OpTester test("Resize", 12);
@@ -2453,6 +2490,22 @@ TEST(ResizeOpTest, Antialias_Use_Extrapolation) {
       {4, 4, 4}, X, {3, 3, 3}, Y);
 }
 
+TEST(ResizeOpTest, Antialias_NhwcUse_Extrapolation) {
+  // the roi starts above the first row and ends right of the last column, so the first output row and the last
+  // output column are extrapolated in every channel.
+  std::vector<float> X(4 * 4 * 2);
+  std::iota(X.begin(), X.end(), 0.f);
+  std::vector<float> Y = {1.1f, 1.1f, 1.1f, 1.1f, 1.1f, 1.1f,
+                          9.602339f, 10.60234f, 12.4128f, 13.4128f, 1.1f, 1.1f,
+                          21.96445f, 22.96445f, 24.7749f, 25.7749f, 1.1f, 1.1f};
+  InlinedVector<std::string_view> excluded_eps = {kCudaExecutionProvider, kRocmExecutionProvider};
+  TestAntialiasing(
+      {{"mode", "linear"}, {"exclude_outside", "0"}, {"extrapolation_value", "1.1f"},
+       {"coordinate_transformation_mode", "tf_crop_and_resize"},
+       {"roi", "{0, -0.2, 0.4, 0, 1, 0.8, 1.4, 1}"}},
+      {1, 4, 4, 2}, X, {1, 3, 3, 2}, Y, excluded_eps);
+}
+
 TEST(ResizeOpTest, Antialias_Large_half_pixel) {
   std::vector<float> X{0.f, 1.f, 2.f, 3.f, 4.f, 5.f};
   std::vector<float> Y = {1.f, 4.f};
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "core/providers/cpu/text/string_slices.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+std::vector<std::string_view> ToVector(gsl::span<const std::string_view> row) {
+  return std::vector<std::string_view>(row.begin(), row.end());
+}
+
+}  // namespace
+
+TEST(StringSlicesTest, RowsAndSizes) {
+  const std::string input = "a b c d e f";
+  const std::string_view text(input);
+
+  StringSlices slices(std::make_shared<CPUAllocator>(), 4, 6);
+  EXPECT_EQ(slices.NumRows(), 0u);
+  EXPECT_EQ(slices.MaxRowSize(), 0u);
+
+  slices.Append(text.substr(0, 1));
+  slices.Append(text.substr(2, 1));
+  EXPECT_EQ(slices.CurrentRowSize(), 2u);
+  slices.EndRow();
+  EXPECT_EQ(slices.CurrentRowSize(), 0u);
+
+  // empty row in the middle
+  slices.EndRow();
+
+  slices.Append(text.substr(4, 1));
+  slices.Append(text.substr(6, 1));
+  slices.Append(text.substr(8, 1));
+  slices.EndRow();
+
+  slices.Append(text.substr(10, 1));
+  // the open row is not counted by NumRows() or MaxRowSize()
+  EXPECT_EQ(slices.CurrentRowSize(), 1u);
+  EXPECT_EQ(slices.NumRows(), 3u);
+  EXPECT_EQ(slices.MaxRowSize(), 3u);
+  slices.EndRow();
+
+  ASSERT_EQ(slices.NumRows(), 4u);
+  EXPECT_EQ(ToVector(slices.Row(0)), (std::vector<std::string_view>{"a", "b"}));
+  EXPECT_TRUE(slices.Row(1).empty());
+  EXPECT_EQ(ToVector(slices.Row(2)), (std::vector<std::string_view>{"c", "d", "e"}));
+  EXPECT_EQ(ToVector(slices.Row(3)), (std::vector<std::string_view>{"f"}));
+  EXPECT_EQ(slices.MaxRowSize(), 3u);
+
+  // slices are views into the input, not copies
+  EXPECT_EQ(slices.Row(3)[0].data(), input.data() + 10);
+}
+
+TEST(StringSlicesTest, GrowsPastEstimate) {
+  std::vector<std::string> input;
+  for (int i = 0; i < 100; ++i) {
+    input.push_back(std::to_string(i));
+  }
+
+  // a zero estimate still gets a buffer, and every Append past the capacity must keep earlier slices
+  StringSlices slices(std::make_shared<CPUAllocator>(), 10, 0);
+  for (size_t row = 0; row < 10; ++row) {
+    for (size_t i = 0; i <= row; ++i) {
+      slices.Append(input[row * 10 + i]);
+    }
+    slices.EndRow();
+  }
+
+  ASSERT_EQ(slices.NumRows(), 10u);
+  EXPECT_EQ(slices.MaxRowSize(), 10u);
+  for (size_t row = 0; row < 10; ++row) {
+    auto slice_row = slices.Row(row);
+    ASSERT_EQ(slice_row.size(), row + 1);
+    for (size_t i = 0; i <= row; ++i) {
+      EXPECT_EQ(slice_row[i], input[row * 10 + i]);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace onnxruntime
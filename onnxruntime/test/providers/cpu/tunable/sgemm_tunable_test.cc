@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <vector>
+
+#include "gmock/gmock.h"
+#include "gtest/gtest.h"
+
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/providers/cpu/tunable/sgemm_tunable.h"
+#include "core/util/thread_utils.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(SgemmTunableOpTest, TuneBatchAndReuseResult) {
+  CPUExecutionProvider ep{CPUExecutionProviderInfo{}};
+  auto* tuning_ctx = static_cast<CpuTuningContext*>(ep.GetTuningContext());
+  tuning_ctx->EnableTunableOpAndTuning();
+  tuning_ctx->SetMaxTuningDurationMs(10);
+
+  OrtThreadPoolParams tp_params;
+  tp_params.thread_pool_size = 2;
+  auto thread_pool = concurrency::CreateThreadPool(&Env::Default(), tp_params, concurrency::ThreadPoolType::INTRA_OP);
+
+  constexpr size_t batch = 4, M = 3, N = 4, K = 5;
+  std::vector<float> a(batch * M * K);
+  std::vector<float> b(batch * K * N);
+  for (size_t i = 0; i < a.size(); ++i) {
+    a[i] = static_cast<float>(i % 7) - 3.f;
+  }
+  for (size_t i = 0; i < b.size(); ++i) {
+    b[i] = static_cast<float>(i % 5) * 0.5f;
+  }
+
+  std::vector<float> expected(batch * M * N, 0.f);
+  for (size_t n = 0; n < batch; ++n) {
+    for (size_t i = 0; i < M; ++i) {
+      for (size_t j = 0; j < N; ++j) {
+        for (size_t k = 0; k < K; ++k) {
+          expected[(n * M + i) * N + j] += a[(n * M + i) * K + k] * b[(n * K + k) * N + j];
+        }
+      }
+    }
+  }
+
+  std::vector<float> c(batch * M * N);
+  std::vector<MLAS_SGEMM_DATA_PARAMS> data(batch);
+  for (size_t n = 0; n < batch; ++n) {
+    data[n].A = a.data() + n * M * K;
+    data[n].lda = K;
+    data[n].B = b.data() + n * K * N;
+    data[n].ldb = N;
+    data[n].C = c.data() + n * M * N;
+    data[n].ldc = N;
+  }
+
+  SgemmTunableOp op;
+  SgemmParams params(tuning_ctx, CblasNoTrans, CblasNoTrans, M, N, K, data, thread_pool.get());
+  ASSERT_STATUS_OK(op(&params));
+  EXPECT_THAT(c, testing::Pointwise(testing::FloatNear(1e-4f), expected));
+
+  // the fastest implementation is recorded in the tuning results of the CPU EP
+  const auto tuning_results = tuning_ctx->GetTuningResults();
+  EXPECT_EQ(tuning_results.ep, kCpuExecutionProvider);
+  ASSERT_EQ(tuning_results.results.size(), 1u);
+  const auto& kernel_map = tuning_results.results.begin()->second;
+  ASSERT_EQ(kernel_map.count(params.Signature()), 1u);
+
+  // and used from then on without tuning again
+  tuning_ctx->DisableTuning();
+  std::fill(c.begin(), c.end(), 0.f);
+  ASSERT_STATUS_OK(op(&params));
+  EXPECT_THAT(c, testing::Pointwise(testing::FloatNear(1e-4f), expected));
+  EXPECT_EQ(tuning_ctx->GetTuningResults().results.begin()->second, kernel_map);
+}
+
+}  // namespace test
+}  // namespace onnxruntime